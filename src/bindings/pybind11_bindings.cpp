@@ -1,5 +1,8 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -12,8 +15,29 @@
 #include <linux/videodev2.h>
 
 #include "bcc950/v4l2_device.hpp"
+#include "bcc950/audio_capture.hpp"
+#include "bcc950/audio_doa.hpp"
+#include "bcc950/audio_vad.hpp"
+#include "bcc950/camera_group.hpp"
+#include "bcc950/control_pacer.hpp"
 #include "bcc950/controller.hpp"
+#include "bcc950/frame_buffer.hpp"
+#include "bcc950/homing.hpp"
+#include "bcc950/jpeg_decoder.hpp"
 #include "bcc950/position.hpp"
+#include "bcc950/realtime.hpp"
+#include "bcc950/recorder.hpp"
+#include "bcc950/replay_source.hpp"
+#include "bcc950/scan_planner.hpp"
+#include "bcc950/scene_change.hpp"
+#include "bcc950/scheduler.hpp"
+#include "bcc950/snapshot_cache.hpp"
+#include "bcc950/spatial_map.hpp"
+#include "bcc950/target_selector.hpp"
+#include "bcc950/v4l2_capture.hpp"
+#include "bcc950/wav.hpp"
+#include "bcc950/watchdog.hpp"
+#include "bcc950/zoom_model.hpp"
 #include "bcc950/constants.hpp"
 
 namespace py = pybind11;
@@ -153,13 +177,713 @@ PYBIND11_MODULE(_bcc950_native, m) {
         .def("reset", &bcc950::PositionTracker::reset)
         .def("distance_to", &bcc950::PositionTracker::distance_to);
 
+    // Pose history
+    py::class_<bcc950::PoseSample>(m, "PoseSample")
+        .def_readonly("timestamp", &bcc950::PoseSample::timestamp)
+        .def_readonly("pan", &bcc950::PoseSample::pan)
+        .def_readonly("tilt", &bcc950::PoseSample::tilt)
+        .def_readonly("zoom", &bcc950::PoseSample::zoom)
+        .def_readonly("pan_speed", &bcc950::PoseSample::pan_speed)
+        .def_readonly("tilt_speed", &bcc950::PoseSample::tilt_speed)
+        .def_property_readonly("moving", &bcc950::PoseSample::moving);
+
+    m.def("monotonic_now", &bcc950::PoseHistory::now,
+          "Current time on the pose history (CLOCK_MONOTONIC) clock.");
+
+    // Spatial observation map
+    py::class_<bcc950::SpatialEntry>(m, "SpatialEntry")
+        .def_readonly("timestamp", &bcc950::SpatialEntry::timestamp)
+        .def_readonly("pan", &bcc950::SpatialEntry::pan)
+        .def_readonly("tilt", &bcc950::SpatialEntry::tilt)
+        .def_readonly("id", &bcc950::SpatialEntry::id);
+
+    py::class_<bcc950::SpatialGridSpec>(m, "SpatialGridSpec")
+        .def(py::init<>())
+        .def_readwrite("pan_min", &bcc950::SpatialGridSpec::pan_min)
+        .def_readwrite("pan_max", &bcc950::SpatialGridSpec::pan_max)
+        .def_readwrite("tilt_min", &bcc950::SpatialGridSpec::tilt_min)
+        .def_readwrite("tilt_max", &bcc950::SpatialGridSpec::tilt_max)
+        .def_readwrite("cell_size", &bcc950::SpatialGridSpec::cell_size)
+        .def_readwrite("cell_capacity", &bcc950::SpatialGridSpec::cell_capacity);
+
+    constexpr double no_age_limit = -std::numeric_limits<double>::infinity();
+    py::class_<bcc950::SpatialMap>(m, "SpatialMap")
+        .def(py::init<const bcc950::SpatialGridSpec&>(),
+             py::arg("spec") = bcc950::SpatialGridSpec{})
+        .def(py::init<const std::string&, const bcc950::SpatialGridSpec&>(),
+             py::arg("path"), py::arg("spec") = bcc950::SpatialGridSpec{})
+        .def("insert", &bcc950::SpatialMap::insert,
+             py::arg("pan"), py::arg("tilt"), py::arg("id"), py::arg("timestamp"))
+        .def("query", &bcc950::SpatialMap::query,
+             py::arg("pan"), py::arg("tilt"), py::arg("radius"),
+             py::arg("since") = no_age_limit)
+        .def("latest_per_cell", &bcc950::SpatialMap::latest_per_cell,
+             py::arg("pan"), py::arg("tilt"), py::arg("radius"),
+             py::arg("since") = no_age_limit)
+        .def("clear", &bcc950::SpatialMap::clear)
+        .def("sync", &bcc950::SpatialMap::sync)
+        .def("__len__", &bcc950::SpatialMap::size);
+
+    // Scan planning
+    py::enum_<bcc950::ScanPattern>(m, "ScanPattern")
+        .value("BOUSTROPHEDON", bcc950::ScanPattern::Boustrophedon)
+        .value("SPIRAL", bcc950::ScanPattern::Spiral)
+        .value("SNAPSHOTS", bcc950::ScanPattern::Snapshots);
+
+    py::class_<bcc950::Waypoint>(m, "Waypoint")
+        .def(py::init<>())
+        .def_readwrite("pan", &bcc950::Waypoint::pan)
+        .def_readwrite("tilt", &bcc950::Waypoint::tilt)
+        .def_readwrite("dwell", &bcc950::Waypoint::dwell);
+
+    py::class_<bcc950::Trajectory>(m, "Trajectory")
+        .def(py::init<>())
+        .def_readwrite("waypoints", &bcc950::Trajectory::waypoints)
+        .def("duration", &bcc950::Trajectory::duration,
+             py::arg("from_pan"), py::arg("from_tilt"));
+
+    py::class_<bcc950::ScanSpec>(m, "ScanSpec")
+        .def(py::init<>())
+        .def_readwrite("pan_min", &bcc950::ScanSpec::pan_min)
+        .def_readwrite("pan_max", &bcc950::ScanSpec::pan_max)
+        .def_readwrite("tilt_min", &bcc950::ScanSpec::tilt_min)
+        .def_readwrite("tilt_max", &bcc950::ScanSpec::tilt_max)
+        .def_readwrite("zoom", &bcc950::ScanSpec::zoom)
+        .def_readwrite("overlap", &bcc950::ScanSpec::overlap)
+        .def_readwrite("dwell", &bcc950::ScanSpec::dwell)
+        .def_readwrite("pattern", &bcc950::ScanSpec::pattern)
+        .def_readwrite("optics", &bcc950::ScanSpec::optics);
+
+    m.def("plan_scan", &bcc950::plan_scan,
+          py::arg("spec"), py::arg("from_pan") = 0.0, py::arg("from_tilt") = 0.0);
+
+    // MJPEG passthrough capture. Frames are immutable; pybind11 holds
+    // them as non-const shared pointers.
+    auto to_py = [](bcc950::FramePtr frame) {
+        return std::const_pointer_cast<bcc950::Frame>(std::move(frame));
+    };
+
+    py::enum_<bcc950::PixelFormat>(m, "PixelFormat")
+        .value("GRAY", bcc950::PixelFormat::Gray)
+        .value("RGB", bcc950::PixelFormat::RGB)
+        .value("BGR", bcc950::PixelFormat::BGR);
+
+    // Decoded pixels as a read-only numpy view; the array keeps the
+    // cached image alive.
+    auto to_array = [](bcc950::ImagePtr image) {
+        auto* owner = new bcc950::ImagePtr(std::move(image));
+        py::capsule base(owner, [](void* p) { delete static_cast<bcc950::ImagePtr*>(p); });
+        const bcc950::Image& img = **owner;
+        std::vector<py::ssize_t> shape = {img.height, img.width};
+        if (img.channels > 1) {
+            shape.push_back(img.channels);
+        }
+        py::array_t<uint8_t> array(shape, img.pixels.data(), base);
+        py::detail::array_proxy(array.ptr())->flags &=
+            ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+        return array;
+    };
+
+    m.def("jpeg_decode_supported", &bcc950::jpeg_decode_supported);
+
+    py::enum_<bcc950::MotionState>(m, "MotionState")
+        .value("STATIONARY", bcc950::MotionState::Stationary)
+        .value("ACCELERATING", bcc950::MotionState::Accelerating)
+        .value("MOVING", bcc950::MotionState::Moving)
+        .value("SETTLING", bcc950::MotionState::Settling);
+
+    py::class_<bcc950::MotionTiming>(m, "MotionTiming")
+        .def(py::init<>())
+        .def_readwrite("accel_time", &bcc950::MotionTiming::accel_time)
+        .def_readwrite("settle_time", &bcc950::MotionTiming::settle_time)
+        .def_readwrite("exposure", &bcc950::MotionTiming::exposure);
+
+    m.def("motion_state", [](const bcc950::Controller& c, double t,
+                             const bcc950::MotionTiming& timing) {
+              return bcc950::motion_state(c.pose_history(), t, timing);
+          },
+          py::arg("controller"), py::arg("t"),
+          py::arg("timing") = bcc950::MotionTiming{});
+
+    py::class_<bcc950::Frame, std::shared_ptr<bcc950::Frame>>(m, "Frame")
+        .def_property_readonly("jpeg", [](const bcc950::Frame& f) {
+            return py::bytes(reinterpret_cast<const char*>(f.data()), f.size());
+        })
+        .def_property_readonly("width", &bcc950::Frame::width)
+        .def_property_readonly("height", &bcc950::Frame::height)
+        .def_property_readonly("sequence", &bcc950::Frame::sequence)
+        .def_property_readonly("timestamp", &bcc950::Frame::timestamp)
+        .def_property_readonly("motion", &bcc950::Frame::motion)
+        .def_property_readonly("settled", &bcc950::Frame::settled)
+        .def("decode", [to_array](const bcc950::Frame& f, int scale, bcc950::PixelFormat format) {
+                 bcc950::ImagePtr image;
+                 {
+                     py::gil_scoped_release release;
+                     image = f.decode(scale, format);
+                 }
+                 return to_array(std::move(image));
+             },
+             py::arg("scale") = 1, py::arg("format") = bcc950::PixelFormat::Gray)
+        .def("decode_at_least", [to_array](const bcc950::Frame& f, int w, int h,
+                                           bcc950::PixelFormat format) {
+                 bcc950::ImagePtr image;
+                 {
+                     py::gil_scoped_release release;
+                     image = f.decode_at_least(w, h, format);
+                 }
+                 return to_array(std::move(image));
+             },
+             py::arg("min_width"), py::arg("min_height"),
+             py::arg("format") = bcc950::PixelFormat::Gray);
+
+    py::class_<bcc950::CaptureFormat>(m, "CaptureFormat")
+        .def(py::init<>())
+        .def_readwrite("width", &bcc950::CaptureFormat::width)
+        .def_readwrite("height", &bcc950::CaptureFormat::height)
+        .def_readwrite("fps", &bcc950::CaptureFormat::fps)
+        .def_readwrite("buffers", &bcc950::CaptureFormat::buffers);
+
+    py::class_<bcc950::FrameSource>(m, "FrameSource")
+        .def("read", [to_py](bcc950::FrameSource& s, double timeout) {
+                 return to_py(s.read(timeout));
+             },
+             py::arg("timeout"), py::call_guard<py::gil_scoped_release>());
+
+    py::class_<bcc950::V4L2Capture, bcc950::FrameSource>(m, "V4L2Capture")
+        .def(py::init<const std::string&, const bcc950::CaptureFormat&>(),
+             py::arg("device"), py::arg("format") = bcc950::CaptureFormat{})
+        .def("close", &bcc950::V4L2Capture::close)
+        .def("set_motion_log", [](bcc950::V4L2Capture& cap, const bcc950::Controller& c,
+                                  const bcc950::MotionTiming& timing) {
+                 cap.set_motion_log(&c.pose_history(), timing);
+             },
+             py::arg("controller"), py::arg("timing") = bcc950::MotionTiming{},
+             py::keep_alive<1, 2>())
+        .def("is_open", &bcc950::V4L2Capture::is_open)
+        .def_property_readonly("width", &bcc950::V4L2Capture::width)
+        .def_property_readonly("height", &bcc950::V4L2Capture::height);
+
+    py::class_<bcc950::ReplayConfig>(m, "ReplayConfig")
+        .def(py::init<>())
+        .def_readwrite("speed", &bcc950::ReplayConfig::speed)
+        .def_readwrite("loop", &bcc950::ReplayConfig::loop);
+
+    py::class_<bcc950::ReplaySource, bcc950::FrameSource>(m, "ReplaySource")
+        .def(py::init<const std::vector<std::string>&, const bcc950::ReplayConfig&>(),
+             py::arg("segments"), py::arg("config") = bcc950::ReplayConfig{})
+        .def_static("find_segments", &bcc950::ReplaySource::find_segments,
+                    py::arg("directory"), py::arg("prefix") = "bcc950")
+        .def("seek", &bcc950::ReplaySource::seek, py::arg("timestamp"))
+        .def("seek_frame", &bcc950::ReplaySource::seek_frame, py::arg("index"))
+        .def_property("speed", &bcc950::ReplaySource::speed, &bcc950::ReplaySource::set_speed)
+        .def_property_readonly("frame_count", &bcc950::ReplaySource::frame_count)
+        .def_property_readonly("position", &bcc950::ReplaySource::position)
+        .def_property_readonly("start_time", &bcc950::ReplaySource::start_time)
+        .def_property_readonly("end_time", &bcc950::ReplaySource::end_time)
+        .def("finished", &bcc950::ReplaySource::finished);
+
+    py::class_<bcc950::FrameBuffer>(m, "FrameBuffer")
+        .def(py::init<bcc950::FrameSource&>(), py::arg("source"),
+             py::keep_alive<1, 2>())
+        .def("start", &bcc950::FrameBuffer::start)
+        .def("stop", &bcc950::FrameBuffer::stop,
+             py::call_guard<py::gil_scoped_release>())
+        .def("latest", [to_py](const bcc950::FrameBuffer& b) {
+            return to_py(b.latest());
+        })
+        .def("wait_next", [to_py](const bcc950::FrameBuffer& b, uint64_t id, double timeout) {
+                 return to_py(b.wait_next(id, timeout));
+             },
+             py::arg("frame_id"), py::arg("timeout"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("wait_settled", [to_py](const bcc950::FrameBuffer& b, uint64_t id, double timeout) {
+                 return to_py(b.wait_settled(id, timeout));
+             },
+             py::arg("frame_id"), py::arg("timeout"),
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("frame_id", &bcc950::FrameBuffer::frame_id)
+        .def_property_readonly("frame_age", &bcc950::FrameBuffer::frame_age)
+        .def_property_readonly("errors", &bcc950::FrameBuffer::errors);
+
+    // Recording
+    py::class_<bcc950::RecorderConfig>(m, "RecorderConfig")
+        .def(py::init<>())
+        .def_readwrite("directory", &bcc950::RecorderConfig::directory)
+        .def_readwrite("prefix", &bcc950::RecorderConfig::prefix)
+        .def_readwrite("max_segment_bytes", &bcc950::RecorderConfig::max_segment_bytes)
+        .def_readwrite("max_segment_seconds", &bcc950::RecorderConfig::max_segment_seconds)
+        .def_readwrite("queue_frames", &bcc950::RecorderConfig::queue_frames)
+        .def_readwrite("chunk_bytes", &bcc950::RecorderConfig::chunk_bytes)
+        .def_readwrite("queue_depth", &bcc950::RecorderConfig::queue_depth)
+        .def_readwrite("direct_io", &bcc950::RecorderConfig::direct_io);
+
+    py::class_<bcc950::RecorderStats>(m, "RecorderStats")
+        .def_readonly("frames", &bcc950::RecorderStats::frames)
+        .def_readonly("dropped", &bcc950::RecorderStats::dropped)
+        .def_readonly("bytes", &bcc950::RecorderStats::bytes)
+        .def_readonly("segments", &bcc950::RecorderStats::segments)
+        .def_readonly("errors", &bcc950::RecorderStats::errors);
+
+    py::class_<bcc950::Recorder>(m, "Recorder")
+        .def(py::init([](const bcc950::RecorderConfig& config, const bcc950::Controller* c) {
+                 return std::make_unique<bcc950::Recorder>(
+                     config, c ? &c->pose_history() : nullptr);
+             }),
+             py::arg("config") = bcc950::RecorderConfig{},
+             py::arg("controller") = nullptr,
+             py::keep_alive<1, 3>())
+        .def_static("io_uring_supported", &bcc950::Recorder::io_uring_supported)
+        .def("start", &bcc950::Recorder::start)
+        .def("stop", &bcc950::Recorder::stop,
+             py::call_guard<py::gil_scoped_release>())
+        .def("running", &bcc950::Recorder::running)
+        .def("write", [](bcc950::Recorder& r, std::shared_ptr<bcc950::Frame> frame) {
+                 return r.write(std::move(frame));
+             },
+             py::arg("frame"))
+        .def("rotate", &bcc950::Recorder::rotate)
+        .def("stats", &bcc950::Recorder::stats)
+        .def("segments", &bcc950::Recorder::segments)
+        .def("last_error", &bcc950::Recorder::last_error);
+
+    // Vision snapshots
+    py::class_<bcc950::SnapshotCacheConfig>(m, "SnapshotCacheConfig")
+        .def(py::init<>())
+        .def_readwrite("pan_bucket", &bcc950::SnapshotCacheConfig::pan_bucket)
+        .def_readwrite("tilt_bucket", &bcc950::SnapshotCacheConfig::tilt_bucket)
+        .def_readwrite("zoom_bucket", &bcc950::SnapshotCacheConfig::zoom_bucket)
+        .def_readwrite("thumb_scale", &bcc950::SnapshotCacheConfig::thumb_scale)
+        .def_readwrite("max_diff", &bcc950::SnapshotCacheConfig::max_diff)
+        .def_readwrite("max_age", &bcc950::SnapshotCacheConfig::max_age)
+        .def_readwrite("capacity", &bcc950::SnapshotCacheConfig::capacity);
+
+    py::class_<bcc950::Snapshot>(m, "Snapshot")
+        .def_readonly("base64", &bcc950::Snapshot::base64)
+        .def_property_readonly("frame", [to_py](const bcc950::Snapshot& s) {
+            return to_py(s.frame);
+        })
+        .def_readonly("cached", &bcc950::Snapshot::cached);
+
+    py::class_<bcc950::SnapshotCacheStats>(m, "SnapshotCacheStats")
+        .def_readonly("hits", &bcc950::SnapshotCacheStats::hits)
+        .def_readonly("misses", &bcc950::SnapshotCacheStats::misses);
+
+    py::class_<bcc950::SnapshotCache>(m, "SnapshotCache")
+        .def(py::init([](const bcc950::Controller* c, const bcc950::SnapshotCacheConfig& config) {
+                 return std::make_unique<bcc950::SnapshotCache>(
+                     c ? &c->pose_history() : nullptr, config);
+             }),
+             py::arg("controller") = nullptr,
+             py::arg("config") = bcc950::SnapshotCacheConfig{},
+             py::keep_alive<1, 2>())
+        .def("get", [](bcc950::SnapshotCache& cache, std::shared_ptr<bcc950::Frame> frame) {
+                 return cache.get(std::move(frame));
+             },
+             py::arg("frame"), py::call_guard<py::gil_scoped_release>())
+        .def("clear", &bcc950::SnapshotCache::clear)
+        .def("__len__", &bcc950::SnapshotCache::size)
+        .def("stats", &bcc950::SnapshotCache::stats);
+
+    // Scene-change gating
+    py::class_<bcc950::SceneSignature>(m, "SceneSignature")
+        .def_property_readonly("blocks", [](const bcc950::SceneSignature& s) {
+            return py::bytes(reinterpret_cast<const char*>(s.blocks.data()), s.blocks.size());
+        })
+        .def_readonly("dhash", &bcc950::SceneSignature::dhash);
+
+    m.def("scene_signature",
+          [](const bcc950::Frame& f, int scale) { return bcc950::scene_signature(f, scale); },
+          py::arg("frame"), py::arg("scale") = bcc950::SCENE_THUMB_SCALE,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("hash_distance", &bcc950::hash_distance, py::arg("a"), py::arg("b"));
+    m.def("block_distance", &bcc950::block_distance, py::arg("a"), py::arg("b"));
+
+    py::enum_<bcc950::SceneTrigger>(m, "SceneTrigger")
+        .value("NONE", bcc950::SceneTrigger::None)
+        .value("FIRST", bcc950::SceneTrigger::First)
+        .value("CHANGED", bcc950::SceneTrigger::Changed)
+        .value("SETTLED", bcc950::SceneTrigger::Settled)
+        .value("TIMEOUT", bcc950::SceneTrigger::Timeout)
+        .value("NO_SIGNATURE", bcc950::SceneTrigger::NoSignature);
+
+    py::class_<bcc950::SceneChangeConfig>(m, "SceneChangeConfig")
+        .def(py::init<>())
+        .def_readwrite("hash_threshold", &bcc950::SceneChangeConfig::hash_threshold)
+        .def_readwrite("block_threshold", &bcc950::SceneChangeConfig::block_threshold)
+        .def_readwrite("max_interval", &bcc950::SceneChangeConfig::max_interval)
+        .def_readwrite("thumb_scale", &bcc950::SceneChangeConfig::thumb_scale);
+
+    py::class_<bcc950::SceneDecision>(m, "SceneDecision")
+        .def_readonly("run", &bcc950::SceneDecision::run)
+        .def_readonly("trigger", &bcc950::SceneDecision::trigger)
+        .def_readonly("hash_distance", &bcc950::SceneDecision::hash_distance)
+        .def_readonly("block_distance", &bcc950::SceneDecision::block_distance)
+        .def("__bool__", [](const bcc950::SceneDecision& d) { return d.run; });
+
+    py::class_<bcc950::SceneChangeDetector>(m, "SceneChangeDetector")
+        .def(py::init<const bcc950::SceneChangeConfig&>(),
+             py::arg("config") = bcc950::SceneChangeConfig{})
+        .def("update",
+             py::overload_cast<const bcc950::Frame&>(&bcc950::SceneChangeDetector::update),
+             py::arg("frame"), py::call_guard<py::gil_scoped_release>())
+        .def("update",
+             py::overload_cast<const bcc950::SceneSignature&, double, bool>(
+                 &bcc950::SceneChangeDetector::update),
+             py::arg("signature"), py::arg("timestamp"), py::arg("settled"))
+        .def("reset", &bcc950::SceneChangeDetector::reset)
+        .def_property_readonly("frames", &bcc950::SceneChangeDetector::frames)
+        .def_property_readonly("runs", &bcc950::SceneChangeDetector::runs);
+
+    // Target selection
+    py::class_<bcc950::Detection>(m, "Detection")
+        .def(py::init<>())
+        .def_readwrite("x1", &bcc950::Detection::x1)
+        .def_readwrite("y1", &bcc950::Detection::y1)
+        .def_readwrite("x2", &bcc950::Detection::x2)
+        .def_readwrite("y2", &bcc950::Detection::y2)
+        .def_readwrite("confidence", &bcc950::Detection::confidence)
+        .def_readwrite("class_id", &bcc950::Detection::class_id);
+
+    py::class_<bcc950::Bearing>(m, "Bearing")
+        .def_readonly("pan", &bcc950::Bearing::pan)
+        .def_readonly("tilt", &bcc950::Bearing::tilt);
+
+    py::class_<bcc950::Track>(m, "Track")
+        .def_readonly("id", &bcc950::Track::id)
+        .def_readonly("class_id", &bcc950::Track::class_id)
+        .def_readonly("confidence", &bcc950::Track::confidence)
+        .def_readonly("box", &bcc950::Track::box)
+        .def_readonly("bearing", &bcc950::Track::bearing)
+        .def_readonly("width", &bcc950::Track::width)
+        .def_readonly("height", &bcc950::Track::height)
+        .def_readonly("pan_velocity", &bcc950::Track::pan_velocity)
+        .def_readonly("tilt_velocity", &bcc950::Track::tilt_velocity)
+        .def_readonly("first_seen", &bcc950::Track::first_seen)
+        .def_readonly("last_seen", &bcc950::Track::last_seen)
+        .def_readonly("hits", &bcc950::Track::hits)
+        .def("predict", &bcc950::Track::predict, py::arg("t"));
+
+    py::class_<bcc950::TargetSelectorConfig>(m, "TargetSelectorConfig")
+        .def(py::init<>())
+        .def_readwrite("min_iou", &bcc950::TargetSelectorConfig::min_iou)
+        .def_readwrite("max_age", &bcc950::TargetSelectorConfig::max_age)
+        .def_readwrite("target_class", &bcc950::TargetSelectorConfig::target_class)
+        .def_readwrite("min_hits", &bcc950::TargetSelectorConfig::min_hits)
+        .def_readwrite("optics", &bcc950::TargetSelectorConfig::optics);
+
+    py::class_<bcc950::TargetSelector>(m, "TargetSelector")
+        .def(py::init([](const bcc950::Controller& c, const bcc950::TargetSelectorConfig& config) {
+                 return std::make_unique<bcc950::TargetSelector>(c.pose_history(), config);
+             }),
+             py::arg("controller"), py::arg("config") = bcc950::TargetSelectorConfig{},
+             py::keep_alive<1, 2>())
+        // Replayed recordings carry their own poses.
+        .def(py::init([](const bcc950::ReplaySource& r, const bcc950::TargetSelectorConfig& config) {
+                 return std::make_unique<bcc950::TargetSelector>(r.pose_history(), config);
+             }),
+             py::arg("replay"), py::arg("config") = bcc950::TargetSelectorConfig{},
+             py::keep_alive<1, 2>())
+        .def("update", &bcc950::TargetSelector::update,
+             py::arg("detections"), py::arg("timestamp"))
+        // One call per frame: an (N, 6) array of normalized
+        // x1, y1, x2, y2, confidence, class rows, e.g. YOLO's
+        // boxes.data with xyxyn coordinates.
+        .def("update_array", [](bcc950::TargetSelector& s,
+                                py::array_t<float, py::array::c_style | py::array::forcecast> boxes,
+                                double timestamp) {
+                 if (boxes.size() != 0 && (boxes.ndim() != 2 || boxes.shape(1) < 6)) {
+                     throw py::value_error("expected an (N, 6) array");
+                 }
+                 std::vector<bcc950::Detection> detections;
+                 auto r = boxes.unchecked();
+                 py::ssize_t rows = boxes.size() == 0 ? 0 : boxes.shape(0);
+                 detections.reserve(static_cast<std::size_t>(rows));
+                 for (py::ssize_t i = 0; i < rows; ++i) {
+                     bcc950::Detection d;
+                     d.x1 = r(i, 0);
+                     d.y1 = r(i, 1);
+                     d.x2 = r(i, 2);
+                     d.y2 = r(i, 3);
+                     d.confidence = r(i, 4);
+                     d.class_id = static_cast<int>(r(i, 5));
+                     detections.push_back(d);
+                 }
+                 py::gil_scoped_release release;
+                 return s.update(detections, timestamp);
+             },
+             py::arg("boxes"), py::arg("timestamp"))
+        .def("tracks", &bcc950::TargetSelector::tracks)
+        .def("target", &bcc950::TargetSelector::target)
+        .def("target_bearing", &bcc950::TargetSelector::target_bearing, py::arg("t"))
+        .def("clear", &bcc950::TargetSelector::clear)
+        .def_property("config", &bcc950::TargetSelector::config,
+                      &bcc950::TargetSelector::set_config);
+
+    // Audio capture and voice activity
+    py::class_<bcc950::BlockStats>(m, "BlockStats")
+        .def_readonly("peak", &bcc950::BlockStats::peak)
+        .def_readonly("rms", &bcc950::BlockStats::rms);
+
+    m.def("block_stats", [](py::array_t<float, py::array::c_style | py::array::forcecast> x) {
+              return bcc950::block_stats(x.data(), static_cast<std::size_t>(x.size()));
+          },
+          py::arg("samples"));
+
+    py::class_<bcc950::VadConfig>(m, "VadConfig")
+        .def(py::init<>())
+        .def_readwrite("peak_threshold", &bcc950::VadConfig::peak_threshold)
+        .def_readwrite("rms_threshold", &bcc950::VadConfig::rms_threshold)
+        .def_readwrite("block_seconds", &bcc950::VadConfig::block_seconds)
+        .def_readwrite("onset_seconds", &bcc950::VadConfig::onset_seconds)
+        .def_readwrite("hangover_seconds", &bcc950::VadConfig::hangover_seconds)
+        .def_readwrite("pre_roll_seconds", &bcc950::VadConfig::pre_roll_seconds)
+        .def_readwrite("min_segment_seconds", &bcc950::VadConfig::min_segment_seconds)
+        .def_readwrite("max_segment_seconds", &bcc950::VadConfig::max_segment_seconds);
+
+    py::class_<bcc950::SpeechSegment>(m, "SpeechSegment")
+        .def_readonly("start", &bcc950::SpeechSegment::start)
+        .def_readonly("end", &bcc950::SpeechSegment::end)
+        .def_readonly("sample_rate", &bcc950::SpeechSegment::sample_rate)
+        .def_property_readonly("duration", &bcc950::SpeechSegment::duration)
+        // Mono float32 samples in [-1, 1], ready for a transcriber.
+        .def_property_readonly("samples", [](const bcc950::SpeechSegment& s) {
+            return py::array_t<float>(static_cast<py::ssize_t>(s.samples.size()),
+                                      s.samples.data());
+        });
+
+    py::class_<bcc950::AudioFormat>(m, "AudioFormat")
+        .def(py::init<>())
+        .def_readwrite("device", &bcc950::AudioFormat::device)
+        .def_readwrite("sample_rate", &bcc950::AudioFormat::sample_rate)
+        .def_readwrite("channels", &bcc950::AudioFormat::channels)
+        .def_readwrite("ring_seconds", &bcc950::AudioFormat::ring_seconds)
+        .def_readwrite("period_seconds", &bcc950::AudioFormat::period_seconds);
+
+    py::class_<bcc950::AudioCapture>(m, "AudioCapture")
+        .def(py::init<const bcc950::AudioFormat&, const bcc950::VadConfig&>(),
+             py::arg("format") = bcc950::AudioFormat{},
+             py::arg("vad") = bcc950::VadConfig{})
+        .def_static("supported", &bcc950::AudioCapture::supported)
+        .def("start", &bcc950::AudioCapture::start)
+        .def("stop", &bcc950::AudioCapture::stop,
+             py::call_guard<py::gil_scoped_release>())
+        .def("running", &bcc950::AudioCapture::running)
+        .def("last_error", &bcc950::AudioCapture::last_error)
+        // Interleaved float32 samples, shape (frames,) or (frames, channels).
+        .def("feed", [](bcc950::AudioCapture& c,
+                        py::array_t<float, py::array::c_style | py::array::forcecast> samples,
+                        double timestamp) {
+                 // The ring's channel count, which is never zero.
+                 const auto channels = static_cast<py::ssize_t>(c.ring().channels());
+                 if (samples.size() % channels != 0) {
+                     throw py::value_error("sample count is not a multiple of channels");
+                 }
+                 auto frames = static_cast<std::size_t>(samples.size() / channels);
+                 py::gil_scoped_release release;
+                 c.feed(samples.data(), frames, timestamp);
+             },
+             py::arg("samples"), py::arg("timestamp"))
+        .def("next_segment", &bcc950::AudioCapture::next_segment,
+             py::arg("timeout"),
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("overruns", &bcc950::AudioCapture::overruns)
+        .def_property_readonly("dropped_segments", &bcc950::AudioCapture::dropped_segments);
+
+    // Speaker direction
+    py::class_<bcc950::DoaConfig>(m, "DoaConfig")
+        .def(py::init<>())
+        .def_readwrite("left_channel", &bcc950::DoaConfig::left_channel)
+        .def_readwrite("right_channel", &bcc950::DoaConfig::right_channel)
+        .def_readwrite("mic_spacing", &bcc950::DoaConfig::mic_spacing)
+        .def_readwrite("speed_of_sound", &bcc950::DoaConfig::speed_of_sound)
+        .def_readwrite("window_seconds", &bcc950::DoaConfig::window_seconds)
+        .def_readwrite("interpolation", &bcc950::DoaConfig::interpolation)
+        .def_readwrite("min_strength", &bcc950::DoaConfig::min_strength)
+        .def_readwrite("min_rms", &bcc950::DoaConfig::min_rms)
+        .def_readwrite("pan_offset", &bcc950::DoaConfig::pan_offset);
+
+    py::class_<bcc950::DoaEstimate>(m, "DoaEstimate")
+        .def_readonly("timestamp", &bcc950::DoaEstimate::timestamp)
+        .def_readonly("delay", &bcc950::DoaEstimate::delay)
+        .def_readonly("azimuth", &bcc950::DoaEstimate::azimuth)
+        .def_readonly("strength", &bcc950::DoaEstimate::strength);
+
+    py::class_<bcc950::DoaEstimator>(m, "DoaEstimator")
+        .def(py::init<int, const bcc950::DoaConfig&>(),
+             py::arg("sample_rate") = bcc950::AUDIO_SAMPLE_RATE,
+             py::arg("config") = bcc950::DoaConfig{})
+        // A (frames, channels) float32 array, first frame captured at `timestamp`.
+        .def("estimate", [](bcc950::DoaEstimator& d,
+                            py::array_t<float, py::array::c_style | py::array::forcecast> samples,
+                            double timestamp) -> std::optional<bcc950::DoaEstimate> {
+                 if (samples.ndim() != 2) {
+                     throw py::value_error("expected a (frames, channels) array");
+                 }
+                 auto frames = static_cast<std::size_t>(samples.shape(0));
+                 auto channels = static_cast<int>(samples.shape(1));
+                 py::gil_scoped_release release;
+                 return d.estimate(samples.data(), frames, channels, timestamp);
+             },
+             py::arg("samples"), py::arg("timestamp"))
+        .def("estimate_latest", [](bcc950::DoaEstimator& d, const bcc950::AudioCapture& c) {
+                 return d.estimate(c.ring());
+             },
+             py::arg("capture"),
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("window", &bcc950::DoaEstimator::window)
+        .def_property_readonly("max_delay", &bcc950::DoaEstimator::max_delay);
+
+    m.def("speaker_bearing", [](const bcc950::Controller& c, const bcc950::DoaEstimate& e,
+                                const bcc950::DoaConfig& config, const bcc950::ZoomModel& optics) {
+              return bcc950::speaker_bearing(c.pose_history(), e, config, optics);
+          },
+          py::arg("controller"), py::arg("estimate"),
+          py::arg("config") = bcc950::DoaConfig{}, py::arg("optics") = bcc950::ZoomModel{});
+
+    // WAV files as (frames, channels) float32 arrays.
+    m.def("read_wav", [](const std::string& path) {
+              bcc950::WavAudio audio = bcc950::read_wav(path);
+              py::array_t<float> samples({static_cast<py::ssize_t>(audio.frames()),
+                                          static_cast<py::ssize_t>(audio.channels)},
+                                         audio.samples.data());
+              return py::make_tuple(samples, audio.sample_rate);
+          },
+          py::arg("path"));
+
+    m.def("write_wav", [](const std::string& path,
+                          py::array_t<float, py::array::c_style | py::array::forcecast> samples,
+                          int sample_rate) {
+              bcc950::WavAudio audio;
+              audio.sample_rate = sample_rate;
+              audio.channels = samples.ndim() == 2 ? static_cast<int>(samples.shape(1)) : 1;
+              audio.samples.assign(samples.data(), samples.data() + samples.size());
+              bcc950::write_wav(path, audio);
+          },
+          py::arg("path"), py::arg("samples"), py::arg("sample_rate"));
+
+    // Homing
+    py::enum_<bcc950::Axis>(m, "Axis")
+        .value("PAN", bcc950::Axis::Pan)
+        .value("TILT", bcc950::Axis::Tilt);
+
+    py::class_<bcc950::HomingProfile>(m, "HomingProfile")
+        .def(py::init<>())
+        .def_readwrite("pan_travel", &bcc950::HomingProfile::pan_travel)
+        .def_readwrite("tilt_travel", &bcc950::HomingProfile::tilt_travel)
+        .def_readwrite("overdrive", &bcc950::HomingProfile::overdrive)
+        .def_readwrite("pan_stop_dir", &bcc950::HomingProfile::pan_stop_dir)
+        .def_readwrite("tilt_stop_dir", &bcc950::HomingProfile::tilt_stop_dir)
+        .def_readwrite("center_pan", &bcc950::HomingProfile::center_pan)
+        .def_readwrite("center_tilt", &bcc950::HomingProfile::center_tilt)
+        .def_readwrite("stall_detector", &bcc950::HomingProfile::stall_detector)
+        .def_readwrite("poll_interval", &bcc950::HomingProfile::poll_interval);
+
+    // Zoom lens model
+    py::class_<bcc950::ZoomModel>(m, "ZoomModel")
+        .def(py::init<>())
+        .def_readwrite("slew_rate", &bcc950::ZoomModel::slew_rate)
+        .def_readwrite("slew_latency", &bcc950::ZoomModel::slew_latency)
+        .def_readwrite("hfov_wide", &bcc950::ZoomModel::hfov_wide)
+        .def_readwrite("vfov_wide", &bcc950::ZoomModel::vfov_wide)
+        .def_readwrite("pan_rate", &bcc950::ZoomModel::pan_rate)
+        .def_readwrite("tilt_rate", &bcc950::ZoomModel::tilt_rate)
+        .def("slew_time", &bcc950::ZoomModel::slew_time)
+        .def("fov", &bcc950::ZoomModel::fov)
+        .def("fov_rate", &bcc950::ZoomModel::fov_rate);
+
+    // Command scheduling
+    py::enum_<bcc950::CommandSource>(m, "CommandSource")
+        .value("OPERATOR", bcc950::CommandSource::Operator)
+        .value("TRACKER", bcc950::CommandSource::Tracker)
+        .value("TOUR", bcc950::CommandSource::Tour)
+        .value("IDLE", bcc950::CommandSource::Idle);
+
+    py::class_<bcc950::MotionCommand>(m, "MotionCommand")
+        .def_static("move", &bcc950::MotionCommand::move,
+                    py::arg("pan_dir"), py::arg("tilt_dir"),
+                    py::arg("duration") = bcc950::DEFAULT_MOVE_DURATION)
+        .def_static("velocity", &bcc950::MotionCommand::velocity,
+                    py::arg("pan_dir"), py::arg("tilt_dir"))
+        .def_static("zoom_to", &bcc950::MotionCommand::zoom_to, py::arg("value"))
+        .def_static("stop", &bcc950::MotionCommand::stop)
+        .def_static("home", &bcc950::MotionCommand::home)
+        .def_static("follow", &bcc950::MotionCommand::follow, py::arg("trajectory"));
+
+    py::class_<bcc950::SourceStats>(m, "SourceStats")
+        .def_readonly("submitted", &bcc950::SourceStats::submitted)
+        .def_readonly("executed", &bcc950::SourceStats::executed)
+        .def_readonly("coalesced", &bcc950::SourceStats::coalesced)
+        .def_readonly("paced", &bcc950::SourceStats::paced)
+        .def_readonly("preempted", &bcc950::SourceStats::preempted)
+        .def_readonly("expired", &bcc950::SourceStats::expired)
+        .def_readonly("overflowed", &bcc950::SourceStats::overflowed)
+        .def_readonly("budget_misses", &bcc950::SourceStats::budget_misses)
+        .def_readonly("failed", &bcc950::SourceStats::failed)
+        .def_readonly("max_wait_ms", &bcc950::SourceStats::max_wait_ms)
+        .def_property_readonly("mean_wait_ms", &bcc950::SourceStats::mean_wait_ms);
+
+    py::class_<bcc950::CommandScheduler>(m, "CommandScheduler")
+        .def("submit", &bcc950::CommandScheduler::submit,
+             py::arg("source"), py::arg("command"))
+        .def("clear", &bcc950::CommandScheduler::clear)
+        .def("wait_idle", &bcc950::CommandScheduler::wait_idle,
+             py::call_guard<py::gil_scoped_release>())
+        .def("stats", &bcc950::CommandScheduler::stats);
+
+    py::class_<bcc950::PacerConfig>(m, "PacerConfig")
+        .def(py::init<>())
+        .def_readwrite("initial_rate", &bcc950::PacerConfig::initial_rate)
+        .def_readwrite("min_rate", &bcc950::PacerConfig::min_rate)
+        .def_readwrite("max_rate", &bcc950::PacerConfig::max_rate)
+        .def_readwrite("burst", &bcc950::PacerConfig::burst)
+        .def_readwrite("increase", &bcc950::PacerConfig::increase)
+        .def_readwrite("backoff", &bcc950::PacerConfig::backoff)
+        .def_readwrite("stall_factor", &bcc950::PacerConfig::stall_factor)
+        .def_readwrite("min_stall", &bcc950::PacerConfig::min_stall);
+
+    py::class_<bcc950::PacerStats>(m, "PacerStats")
+        .def_readonly("writes", &bcc950::PacerStats::writes)
+        .def_readonly("delayed", &bcc950::PacerStats::delayed)
+        .def_readonly("merged", &bcc950::PacerStats::merged)
+        .def_readonly("stalls", &bcc950::PacerStats::stalls)
+        .def_readonly("errors", &bcc950::PacerStats::errors)
+        .def_readonly("rate", &bcc950::PacerStats::rate)
+        .def_readonly("latency", &bcc950::PacerStats::latency);
+
     // Controller - factory function returning unique_ptr since Controller
-    // holds a unique_ptr member (non-copyable, non-movable in pybind11)
-    m.def("create_controller", [](const std::string& device) {
+    // holds a unique_ptr member (non-copyable, non-movable in pybind11).
+    // With a PacerConfig, control writes go through a ControlPacer.
+    m.def("create_controller", [](const std::string& device,
+                                  std::optional<bcc950::PacerConfig> pacing) {
         auto dev = std::make_unique<bcc950::V4L2Device>();
         dev->open(device);
+        if (pacing) {
+            return std::make_unique<bcc950::Controller>(
+                std::make_unique<bcc950::ControlPacer>(std::move(dev), *pacing));
+        }
         return std::make_unique<bcc950::Controller>(std::move(dev));
-    }, py::arg("device") = bcc950::DEFAULT_DEVICE);
+    }, py::arg("device") = bcc950::DEFAULT_DEVICE, py::arg("pacing") = py::none());
+
+    py::enum_<bcc950::PtzMode>(m, "PtzMode")
+        .value("VELOCITY", bcc950::PtzMode::Velocity)
+        .value("RELATIVE", bcc950::PtzMode::Relative)
+        .value("ABSOLUTE", bcc950::PtzMode::Absolute);
+
+    py::class_<bcc950::RealtimeConfig>(m, "RealtimeConfig")
+        .def(py::init<>())
+        .def_readwrite("enabled", &bcc950::RealtimeConfig::enabled)
+        .def_readwrite("priority", &bcc950::RealtimeConfig::priority)
+        .def_readwrite("cpu", &bcc950::RealtimeConfig::cpu)
+        .def_readwrite("lock_memory", &bcc950::RealtimeConfig::lock_memory)
+        .def_readwrite("spin", &bcc950::RealtimeConfig::spin);
+
+    py::class_<bcc950::JitterStats>(m, "JitterStats")
+        .def_readonly("count", &bcc950::JitterStats::count)
+        .def_readonly("mean", &bcc950::JitterStats::mean)
+        .def_readonly("max", &bcc950::JitterStats::max)
+        .def_readonly("buckets", &bcc950::JitterStats::buckets)
+        .def("quantile", &bcc950::JitterStats::quantile, py::arg("q"))
+        .def_static("bucket_limit", &bcc950::JitterStats::bucket_limit, py::arg("i"));
 
     py::class_<bcc950::Controller>(m, "Controller")
         .def("pan_left", &bcc950::Controller::pan_left,
@@ -173,8 +897,73 @@ PYBIND11_MODULE(_bcc950_native, m) {
         .def("zoom_in", &bcc950::Controller::zoom_in)
         .def("zoom_out", &bcc950::Controller::zoom_out)
         .def("zoom_to", &bcc950::Controller::zoom_to)
+        .def("move_fov", &bcc950::Controller::move_fov,
+             py::arg("pan_fovs"), py::arg("tilt_fovs"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("set_zoom_model", &bcc950::Controller::set_zoom_model)
+        .def("move_to", &bcc950::Controller::move_to,
+             py::arg("pan"), py::arg("tilt"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("run_trajectory", &bcc950::Controller::run_trajectory,
+             py::call_guard<py::gil_scoped_release>())
+        .def("scan", &bcc950::Controller::scan,
+             py::call_guard<py::gil_scoped_release>())
+        .def("set_velocity", &bcc950::Controller::set_velocity,
+             py::arg("pan_dir"), py::arg("tilt_dir"))
+        .def("heartbeat", &bcc950::Controller::heartbeat)
+        .def("set_heartbeat_timeout", &bcc950::Controller::set_heartbeat_timeout,
+             py::arg("seconds"))
+        .def("set_realtime", &bcc950::Controller::set_realtime, py::arg("config"))
+        .def("pacer_stats", &bcc950::Controller::pacer_stats)
+        .def("wake_jitter", &bcc950::Controller::wake_jitter)
         .def("reset_position", &bcc950::Controller::reset_position)
-        .def("stop", &bcc950::Controller::stop);
+        .def("stop", &bcc950::Controller::stop)
+        .def_property_readonly("position", &bcc950::Controller::position)
+        .def("pose_at", &bcc950::Controller::pose_at, py::arg("t"))
+        .def("home", &bcc950::Controller::home,
+             py::call_guard<py::gil_scoped_release>())
+        .def("set_homing_profile", &bcc950::Controller::set_homing_profile,
+             py::arg("profile"))
+        .def_property_readonly("ptz_mode", &bcc950::Controller::ptz_mode)
+        .def("sync_position", &bcc950::Controller::sync_position)
+        .def("save_preset", &bcc950::Controller::save_preset, py::arg("name"))
+        .def("recall_preset", &bcc950::Controller::recall_preset, py::arg("name"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("list_presets", &bcc950::Controller::list_presets)
+        .def("scheduler", &bcc950::Controller::scheduler,
+             py::return_value_policy::reference_internal);
+
+    py::class_<bcc950::GroupMove>(m, "GroupMove")
+        .def(py::init([](bcc950::Controller* camera, int pan_dir, int tilt_dir) {
+                 return bcc950::GroupMove{camera, pan_dir, tilt_dir};
+             }),
+             py::arg("camera"), py::arg("pan_dir") = 0, py::arg("tilt_dir") = 0,
+             py::keep_alive<1, 2>())
+        .def_readwrite("pan_dir", &bcc950::GroupMove::pan_dir)
+        .def_readwrite("tilt_dir", &bcc950::GroupMove::tilt_dir);
+
+    py::class_<bcc950::GroupMemberTiming>(m, "GroupMemberTiming")
+        .def_readonly("completed", &bcc950::GroupMemberTiming::completed)
+        .def_readonly("clamped", &bcc950::GroupMemberTiming::clamped)
+        .def_readonly("start_late", &bcc950::GroupMemberTiming::start_late)
+        .def_readonly("stop_late", &bcc950::GroupMemberTiming::stop_late);
+
+    py::class_<bcc950::GroupMoveReport>(m, "GroupMoveReport")
+        .def_readonly("cameras", &bcc950::GroupMoveReport::cameras)
+        .def_readonly("start_skew", &bcc950::GroupMoveReport::start_skew)
+        .def_readonly("stop_skew", &bcc950::GroupMoveReport::stop_skew)
+        .def("completed", &bcc950::GroupMoveReport::completed);
+
+    m.def("synchronized_move", &bcc950::synchronized_move,
+          py::arg("moves"), py::arg("duration"),
+          py::arg("lead") = bcc950::GROUP_MOVE_LEAD,
+          py::call_guard<py::gil_scoped_release>());
+
+    // Safety. Signal handlers are opt-in: Python owns SIGINT by default.
+    m.def("emergency_stop_all", &bcc950::emergency_stop_all,
+          "Write pan/tilt speed 0 to every open device.");
+    m.def("install_safety_handlers", &bcc950::install_safety_handlers,
+          "Stop all devices on SIGINT/SIGTERM and at process exit.");
 
     // Constants
     m.attr("ZOOM_MIN") = bcc950::ZOOM_MIN;
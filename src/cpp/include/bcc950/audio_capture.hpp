@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "audio_vad.hpp"
+#include "constants.hpp"
+
+namespace bcc950 {
+
+/// Fixed-size ring of recent interleaved audio with capture times.
+///
+/// Lets consumers such as direction-of-arrival estimation read the
+/// newest window without a second capture stream. Thread-safe.
+class AudioRing {
+public:
+    AudioRing(int sample_rate, int channels, double seconds = AUDIO_RING_SECONDS);
+
+    /// Append `frames` interleaved frames, the first captured at
+    /// `timestamp` (PoseHistory::now() clock).
+    void write(const float* interleaved, std::size_t frames, double timestamp);
+
+    /// Copy the newest `frames` frames into `out` (interleaved). Returns
+    /// the capture time of the first copied frame, or nullopt if fewer
+    /// frames are buffered.
+    std::optional<double> latest(std::size_t frames, std::vector<float>& out) const;
+
+    uint64_t frames_written() const;
+    std::size_t capacity() const { return capacity_; }
+    int sample_rate() const { return sample_rate_; }
+    int channels() const { return channels_; }
+
+private:
+    int         sample_rate_;
+    int         channels_;
+    std::size_t capacity_;  // frames
+
+    mutable std::mutex mutex_;
+    std::vector<float> data_;
+    uint64_t           written_ = 0;
+    uint64_t           stamp_index_ = 0;  // frame index of stamp_time_
+    double             stamp_time_ = 0.0;
+};
+
+/// Capture stream parameters.
+struct AudioFormat {
+    std::string device = "default";  // ALSA PCM name, e.g. "plughw:BCC950"
+    int    sample_rate = AUDIO_SAMPLE_RATE;
+    int    channels    = 1;
+    double ring_seconds   = AUDIO_RING_SECONDS;
+    double period_seconds = AUDIO_PERIOD_SECONDS;
+};
+
+/// Microphone capture with a streaming voice activity gate.
+///
+/// A capture thread reads short ALSA periods into an AudioRing and runs
+/// the mono mix through a VoiceActivityDetector, queueing only complete
+/// speech segments. Consumers wait on next_segment() instead of
+/// recording fixed windows and testing them for silence afterwards.
+/// ALSA is optional at build time; without it start() throws, but
+/// feed() still drives the same pipeline.
+class AudioCapture {
+public:
+    explicit AudioCapture(const AudioFormat& format = AudioFormat{},
+                          const VadConfig& vad = VadConfig{});
+
+    /// Stops and joins the capture thread.
+    ~AudioCapture();
+
+    AudioCapture(const AudioCapture&) = delete;
+    AudioCapture& operator=(const AudioCapture&) = delete;
+
+    /// True if libbcc950 was built with ALSA.
+    static bool supported();
+
+    /// Open the PCM and start the capture thread. Throws
+    /// std::runtime_error if the device cannot be opened.
+    void start();
+
+    /// Stop and join the capture thread. Idempotent.
+    void stop();
+
+    /// True while the capture thread is reading. False once the thread
+    /// has stopped on an unrecoverable device error; see last_error().
+    bool running() const;
+
+    /// Message of the error that stopped capture, empty if none.
+    std::string last_error() const;
+
+    /// Process `frames` interleaved frames captured at `timestamp`, as
+    /// the capture thread does. For replayed or injected audio.
+    void feed(const float* interleaved, std::size_t frames, double timestamp);
+
+    /// Wait up to `timeout` seconds for the next speech segment. Returns
+    /// early with nothing if capture stops on a device error.
+    std::optional<SpeechSegment> next_segment(double timeout);
+
+    /// Recent audio, all channels.
+    const AudioRing& ring() const { return ring_; }
+
+    const AudioFormat& format() const { return format_; }
+
+    /// Capture overruns recovered (audio was lost).
+    uint64_t overruns() const { return overruns_.load(); }
+
+    /// Segments discarded because nobody consumed them.
+    uint64_t dropped_segments() const;
+
+private:
+    AudioFormat format_;
+    AudioRing   ring_;
+
+    std::mutex            vad_mutex_;  // serializes feed()
+    VoiceActivityDetector vad_;
+    std::vector<float>    mono_;
+
+    mutable std::mutex        queue_mutex_;
+    std::condition_variable   queue_cv_;
+    std::deque<SpeechSegment> queue_;
+    uint64_t                  dropped_ = 0;
+
+    std::atomic<bool>     exit_{false};
+    std::atomic<bool>     running_{false};  // read by running() from any thread
+    std::atomic<bool>     failed_{false};
+    std::string           last_error_;  // guarded by queue_mutex_
+    std::atomic<uint64_t> overruns_{0};
+    std::thread           thread_;
+    void*                 pcm_ = nullptr;  // snd_pcm_t*
+
+    void run();
+};
+
+} // namespace bcc950
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "audio_capture.hpp"
+#include "constants.hpp"
+#include "pose_history.hpp"
+#include "target_selector.hpp"
+#include "zoom_model.hpp"
+
+namespace bcc950 {
+
+/// Speaker direction tuning. The BCC950 microphones sit in the fixed
+/// base, so directions are relative to the base, not the moving head.
+struct DoaConfig {
+    int    left_channel   = 0;
+    int    right_channel  = 1;
+    double mic_spacing    = DOA_MIC_SPACING;     // meters between the pair
+    double speed_of_sound = SPEED_OF_SOUND;      // meters per second
+    double window_seconds = DOA_WINDOW_SECONDS;  // audio per estimate
+    int    interpolation  = DOA_INTERPOLATION;   // correlation upsampling (power of two)
+    float  min_strength   = DOA_MIN_STRENGTH;    // PHAT peak, 0..1
+    float  min_rms        = VAD_RMS_THRESHOLD;   // skip quiet windows
+    double pan_offset     = 0.0;                 // world pan of the base's broadside
+};
+
+/// One direction-of-arrival measurement.
+struct DoaEstimate {
+    double timestamp = 0.0;  // capture time of the window's middle
+    double delay     = 0.0;  // arrival at left minus arrival at right, seconds
+    double azimuth   = 0.0;  // degrees from broadside, positive to the right
+    double strength  = 0.0;  // normalized GCC-PHAT peak, 0..1
+};
+
+/// Time-difference-of-arrival estimator for one microphone pair using
+/// the generalized cross-correlation with phase transform (GCC-PHAT).
+///
+/// Both channels go through a single complex FFT, the cross spectrum is
+/// whitened to unit magnitude so reverberation and the voice's own
+/// spectrum do not bias the peak, and the correlation is upsampled by
+/// zero-padding before the peak search within the physically possible
+/// lags. A window costs well under a millisecond, so estimates can run
+/// at tens of Hz alongside capture.
+class DoaEstimator {
+public:
+    explicit DoaEstimator(int sample_rate = AUDIO_SAMPLE_RATE,
+                          const DoaConfig& config = DoaConfig{});
+
+    /// Estimate from the first window() frames of `interleaved`, whose
+    /// first frame was captured at `timestamp`. Nullopt if there are too
+    /// few frames or channels, or the window is too quiet or diffuse.
+    std::optional<DoaEstimate> estimate(const float* interleaved, std::size_t frames,
+                                        int channels, double timestamp);
+
+    /// Estimate from the newest window in `ring`.
+    std::optional<DoaEstimate> estimate(const AudioRing& ring);
+
+    /// Frames per estimate.
+    std::size_t window() const { return window_; }
+
+    /// Largest delay the microphone spacing allows, seconds.
+    double max_delay() const;
+
+    int sample_rate() const { return sample_rate_; }
+    const DoaConfig& config() const { return config_; }
+
+private:
+    int         sample_rate_;
+    DoaConfig   config_;
+    std::size_t window_;
+    std::size_t fft_size_;
+    std::size_t ifft_size_;
+
+    std::vector<std::complex<float>> twiddles_;  // for ifft_size_
+    std::vector<std::complex<float>> spectrum_;
+    std::vector<std::complex<float>> cross_;
+    std::vector<float>               ring_buf_;
+};
+
+/// World bearing toward a speaker: the estimate's azimuth converted to
+/// movement-seconds with `optics.pan_rate`, offset by
+/// DoaConfig::pan_offset. Tilt holds the head's tilt at the estimate
+/// time. Suitable for Controller::move_to(); nullopt if the pose at that
+/// time is unknown.
+std::optional<Bearing> speaker_bearing(const PoseHistory& history,
+                                       const DoaEstimate& estimate,
+                                       const DoaConfig& config = DoaConfig{},
+                                       const ZoomModel& optics = ZoomModel{});
+
+} // namespace bcc950
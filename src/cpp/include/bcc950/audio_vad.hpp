@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "constants.hpp"
+
+namespace bcc950 {
+
+/// Peak and RMS of one block of samples.
+struct BlockStats {
+    float peak = 0.0f;  // max |x|
+    float rms  = 0.0f;
+};
+
+/// Peak and RMS of `n` samples in one pass, vectorized (SSE2 or NEON)
+/// where available.
+BlockStats block_stats(const float* samples, std::size_t n);
+
+/// Voice activity gate thresholds and timing.
+struct VadConfig {
+    float  peak_threshold      = VAD_PEAK_THRESHOLD;  // a block is speech only if
+    float  rms_threshold       = VAD_RMS_THRESHOLD;   // both are reached
+    double block_seconds       = VAD_BLOCK_SECONDS;
+    double onset_seconds       = VAD_ONSET_SECONDS;
+    double hangover_seconds    = VAD_HANGOVER_SECONDS;
+    double pre_roll_seconds    = VAD_PRE_ROLL_SECONDS;
+    double min_segment_seconds = VAD_MIN_SEGMENT_SECONDS;
+    double max_segment_seconds = VAD_MAX_SEGMENT_SECONDS;
+};
+
+/// One utterance: mono samples with the capture time of the first and
+/// one past the last sample (PoseHistory::now() clock).
+struct SpeechSegment {
+    double start = 0.0;
+    double end   = 0.0;
+    int    sample_rate = 0;
+    std::vector<float> samples;
+
+    double duration() const { return end - start; }
+};
+
+/// Streaming voice activity detector.
+///
+/// Splits the stream into fixed blocks and classifies each by peak and
+/// RMS energy. A segment opens after onset_seconds of consecutive speech
+/// blocks (keeping pre_roll_seconds of audio before it), closes after
+/// hangover_seconds of silence, and is split at max_segment_seconds.
+/// Segments shorter than min_segment_seconds are dropped, so silent
+/// windows never reach the transcriber.
+class VoiceActivityDetector {
+public:
+    explicit VoiceActivityDetector(int sample_rate = AUDIO_SAMPLE_RATE,
+                                   const VadConfig& config = VadConfig{});
+
+    /// Feed `n` mono samples, the first captured at `timestamp`. Returns
+    /// the segments completed by this call, oldest first.
+    std::vector<SpeechSegment> process(const float* samples, std::size_t n,
+                                       double timestamp);
+
+    /// Close any open segment (end of stream).
+    std::vector<SpeechSegment> flush();
+
+    /// True while a segment is open.
+    bool in_speech() const { return in_speech_; }
+
+    /// Statistics of the most recent complete block.
+    BlockStats last_block() const { return last_block_; }
+
+    int sample_rate() const { return sample_rate_; }
+
+private:
+    int         sample_rate_;
+    VadConfig   config_;
+    std::size_t block_size_;
+    std::size_t onset_blocks_;
+    std::size_t hangover_blocks_;
+    std::size_t pre_roll_size_;
+    std::size_t max_segment_size_;
+
+    std::vector<float> block_;
+    double             block_start_ = 0.0;
+    BlockStats         last_block_;
+
+    // Recent audio while idle, including unconfirmed onset blocks.
+    std::deque<float>  pre_roll_;
+    double             pre_roll_end_ = 0.0;
+    std::size_t        onset_run_ = 0;
+
+    bool               in_speech_ = false;
+    SpeechSegment      segment_;
+    std::size_t        silent_run_ = 0;
+
+    void handle_block(double start, std::vector<SpeechSegment>& out);
+    void close_segment(std::vector<SpeechSegment>& out);
+};
+
+} // namespace bcc950
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "constants.hpp"
+#include "controller.hpp"
+
+namespace bcc950 {
+
+/// One camera's part in a synchronized move.
+struct GroupMove {
+    Controller* camera   = nullptr;
+    int         pan_dir  = 0;
+    int         tilt_dir = 0;
+};
+
+/// How closely one camera followed the shared deadlines, in seconds.
+struct GroupMemberTiming {
+    bool   completed  = false;  // ran to the end (or a soft limit), not cancelled or missed
+    bool   clamped    = false;  // a soft limit shortened the travel, maybe to nothing
+    double start_late = 0.0;    // start write returned this long after the start deadline
+    double stop_late  = 0.0;    // last stop write, after the stop deadline
+};
+
+struct GroupMoveReport {
+    std::vector<GroupMemberTiming> cameras;  // in the order given
+    double start_skew = 0.0;  // spread of start_late across cameras that moved
+    double stop_skew  = 0.0;  // spread of stop_late
+
+    /// True if every camera completed.
+    bool completed() const;
+};
+
+/// Move several cameras at once. Each move runs on its own thread,
+/// which takes that camera's motion lock and stages its start batch,
+/// then all are released at one absolute deadline `lead` seconds from
+/// now and all stop at that deadline plus `duration`. A camera still
+/// busy at the deadline starts late but stops on time. Blocks until
+/// every move has finished. Cameras in real-time mode (set_realtime())
+/// also run their part under SCHED_FIFO.
+GroupMoveReport synchronized_move(const std::vector<GroupMove>& moves, double duration,
+                                  double lead = GROUP_MOVE_LEAD);
+
+} // namespace bcc950
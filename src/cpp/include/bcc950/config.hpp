@@ -41,6 +41,16 @@ public:
     int zoom_step() const;
     void set_zoom_step(int value);
 
+    /// PTZ_MODE: "auto", "velocity", "relative" or "absolute".
+    std::string ptz_mode() const;
+    void set_ptz_mode(const std::string& value);
+
+    /// PTZ_RELATIVE_SCALE: PAN/TILT_RELATIVE units per degree, for
+    /// cameras whose relative controls are calibrated. Zero (the
+    /// default) derives the units from the control ranges.
+    double ptz_relative_scale() const;
+    void set_ptz_relative_scale(double value);
+
     /// Return the config file path.
     const std::string& path() const { return path_; }
 
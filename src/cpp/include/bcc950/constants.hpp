@@ -1,15 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <linux/v4l2-controls.h>
 
 namespace bcc950 {
 
-// V4L2 control IDs (from linux/v4l2-controls.h)
+// V4L2 control IDs (from linux/v4l2-controls.h); controls.hpp pairs them
+// with their ranges as compile-time descriptors
 constexpr uint32_t CTRL_PAN_SPEED      = V4L2_CID_PAN_SPEED;
 constexpr uint32_t CTRL_TILT_SPEED     = V4L2_CID_TILT_SPEED;
 constexpr uint32_t CTRL_ZOOM_ABSOLUTE  = V4L2_CID_ZOOM_ABSOLUTE;
+constexpr uint32_t CTRL_PAN_ABSOLUTE   = V4L2_CID_PAN_ABSOLUTE;   // not on the BCC950
+constexpr uint32_t CTRL_TILT_ABSOLUTE  = V4L2_CID_TILT_ABSOLUTE;
+constexpr uint32_t CTRL_PAN_RELATIVE   = V4L2_CID_PAN_RELATIVE;
+constexpr uint32_t CTRL_TILT_RELATIVE  = V4L2_CID_TILT_RELATIVE;
+
+// PAN/TILT_ABSOLUTE count in arc-seconds; V4L2 leaves the units of
+// PAN/TILT_RELATIVE undefined (see probe_ptz())
+constexpr double PTZ_UNITS_PER_DEGREE = 3600.0;
 
 // Zoom limits
 constexpr int ZOOM_MIN     = 100;
@@ -30,12 +40,148 @@ constexpr int DEFAULT_ZOOM_STEP  = 10;
 // Default movement duration (seconds)
 constexpr double DEFAULT_MOVE_DURATION = 0.1;
 
+// Velocity mode: motors stop if no setpoint arrives within this (seconds)
+constexpr double DEFAULT_VELOCITY_TIMEOUT = 0.5;
+
+// Watchdog: slack past a move's duration before a stop is forced (seconds)
+constexpr double DEFAULT_WATCHDOG_GRACE = 0.25;
+
+// Real-time motion timing: SCHED_FIFO priority when enabled, how long
+// before each stop deadline to stop blocking and busy-wait (seconds),
+// microseconds between cancel checks while spinning, and power-of-two
+// microsecond buckets in the wakeup-jitter histogram
+constexpr int         RT_DEFAULT_PRIORITY = 70;
+constexpr double      RT_SPIN_SECONDS     = 100e-6;
+constexpr int         RT_SPIN_CHECK_US    = 10;
+constexpr std::size_t JITTER_BUCKETS      = 24;
+
+// Synchronized group moves: how far ahead the shared start deadline is
+// set, giving every camera time to stage its writes (seconds), and the
+// busy-wait before it, used even without real-time mode (seconds)
+constexpr double GROUP_MOVE_LEAD  = 0.05;
+constexpr double GROUP_START_SPIN = 500e-6;
+
+// Control write pacing (ControlPacer): writes per second to start at and
+// stay within, tokens banked while idle, rate added per clean write, rate
+// multiplier on a stall or error, how much slower than the baseline (and
+// at least how many seconds) a transfer must be to count as a stall, and
+// the weight of each clean transfer in the baseline latency
+constexpr double PACER_INITIAL_RATE   = 50.0;
+constexpr double PACER_MIN_RATE       = 5.0;
+constexpr double PACER_MAX_RATE       = 200.0;
+constexpr double PACER_BURST          = 4.0;
+constexpr double PACER_INCREASE       = 1.0;
+constexpr double PACER_BACKOFF        = 0.5;
+constexpr double PACER_STALL_FACTOR   = 4.0;
+constexpr double PACER_MIN_STALL      = 0.005;
+constexpr double PACER_LATENCY_WEIGHT = 0.1;
+
+// Zoom lens slew (estimates; calibrate per unit via ZoomModel)
+constexpr double ZOOM_SLEW_RATE    = 800.0;  // zoom units per second
+constexpr double ZOOM_SLEW_LATENCY = 0.03;   // seconds before the lens moves
+
+// Optics at ZOOM_MIN (78 degree diagonal, 16:9) and mechanical rates at
+// full speed, in degrees per movement-second
+constexpr double FOV_H_WIDE       = 70.4;
+constexpr double FOV_V_WIDE       = 43.3;
+constexpr double PAN_DEG_PER_SEC  = 18.0;
+constexpr double TILT_DEG_PER_SEC = 9.0;
+
+// Pose history ring size (samples; rounded up to a power of two)
+constexpr std::size_t POSE_HISTORY_CAPACITY = 1024;
+
+// Spatial observation map: grid cell size (movement-seconds) and the
+// number of newest entries kept per cell
+constexpr double   SPATIAL_CELL_SIZE     = 0.5;
+constexpr uint32_t SPATIAL_CELL_CAPACITY = 8;
+
+// Video capture defaults (MJPEG passthrough)
+constexpr int CAPTURE_WIDTH   = 640;
+constexpr int CAPTURE_HEIGHT  = 480;
+constexpr int CAPTURE_FPS     = 30;
+constexpr int CAPTURE_BUFFERS = 4;
+
+// Frame motion tagging: seconds for the motors to reach speed, for the
+// head to stop ringing after a stop, and a frame's exposure window
+constexpr double MOTOR_ACCEL_TIME  = 0.1;
+constexpr double MOTOR_SETTLE_TIME = 0.3;
+constexpr double FRAME_EXPOSURE    = 1.0 / 30.0;
+
+// Recording: segment rotation limits, frames queued for the writer
+// thread, and the size and alignment of each disk write (O_DIRECT needs
+// the logical block size)
+constexpr uint64_t    RECORD_SEGMENT_BYTES   = 256ull << 20;
+constexpr double      RECORD_SEGMENT_SECONDS = 300.0;
+constexpr std::size_t RECORD_QUEUE_FRAMES    = 64;
+constexpr std::size_t RECORD_CHUNK_BYTES     = 1u << 20;
+constexpr std::size_t RECORD_ALIGNMENT       = 4096;
+constexpr std::size_t RECORD_QUEUE_DEPTH     = 4;  // chunks in flight
+
+// After an I/O failure the recorder drops frames for RECORD_RETRY_MIN
+// seconds before opening another segment, doubling up to
+// RECORD_RETRY_MAX while failures continue
+constexpr double RECORD_RETRY_MIN = 0.5;
+constexpr double RECORD_RETRY_MAX = 30.0;
+
+// Audio capture (the BCC950 mic runs at 44.1 kHz) and voice activity
+// gate. Thresholds match the Python listener's silence test.
+constexpr int    AUDIO_SAMPLE_RATE       = 44100;
+constexpr double AUDIO_RING_SECONDS      = 10.0;
+constexpr double AUDIO_PERIOD_SECONDS    = 0.02;   // capture read size
+constexpr float  VAD_PEAK_THRESHOLD      = 0.015f;
+constexpr float  VAD_RMS_THRESHOLD       = 0.004f;
+constexpr double VAD_BLOCK_SECONDS       = 0.02;
+constexpr double VAD_ONSET_SECONDS       = 0.06;   // speech needed to open a segment
+constexpr double VAD_HANGOVER_SECONDS    = 0.6;    // silence needed to close it
+constexpr double VAD_PRE_ROLL_SECONDS    = 0.3;
+constexpr double VAD_MIN_SEGMENT_SECONDS = 0.25;
+constexpr double VAD_MAX_SEGMENT_SECONDS = 15.0;
+
+// Speaker direction from the base's microphone pair. The spacing is an
+// estimate; calibrate per unit via DoaConfig.
+constexpr double DOA_MIC_SPACING    = 0.06;   // meters
+constexpr double SPEED_OF_SOUND     = 343.0;  // meters per second at 20 C
+constexpr double DOA_WINDOW_SECONDS = 0.05;   // 20 estimates per second
+constexpr int    DOA_INTERPOLATION  = 4;
+constexpr float  DOA_MIN_STRENGTH   = 0.1f;
+
+// Vision snapshot cache: pose bucket sizes (movement-seconds, zoom
+// units), the 1/8-scale luma comparison, the mean difference still
+// counted as the same scene, reuse age limit, and buckets kept
+constexpr double SNAPSHOT_PAN_BUCKET  = 0.1;
+constexpr double SNAPSHOT_TILT_BUCKET = 0.1;
+constexpr double SNAPSHOT_ZOOM_BUCKET = 20.0;
+constexpr int    SNAPSHOT_THUMB_SCALE = 8;
+constexpr double SNAPSHOT_MAX_DIFF    = 4.0;
+constexpr double SNAPSHOT_MAX_AGE     = 60.0;
+constexpr std::size_t SNAPSHOT_CAPACITY = 32;
+
+// Scene-change gate for detection: dHash bits and mean block luma that
+// count as a change, and the longest gap between passes regardless
+constexpr int    SCENE_THUMB_SCALE     = 8;
+constexpr int    SCENE_HASH_THRESHOLD  = 6;
+constexpr double SCENE_BLOCK_THRESHOLD = 8.0;
+constexpr double SCENE_MAX_INTERVAL    = 5.0;
+
+// Target tracking: minimum world-space IoU to continue a track, seconds
+// a track survives without a detection, and the class followed (COCO
+// person)
+constexpr double TRACK_MIN_IOU      = 0.2;
+constexpr double TRACK_MAX_AGE      = 1.0;
+constexpr int    TRACK_TARGET_CLASS = 0;
+
 // Estimated position range (movement-seconds based)
 constexpr double EST_PAN_MIN  = -5.0;
 constexpr double EST_PAN_MAX  =  5.0;
 constexpr double EST_TILT_MIN = -3.0;
 constexpr double EST_TILT_MAX =  3.0;
 
+// Full mechanical travel per axis, in degrees. A relative control's
+// largest offset is assumed to span it unless PTZ_RELATIVE_SCALE
+// calibrates the units
+constexpr double PTZ_PAN_TRAVEL_DEG  = (EST_PAN_MAX - EST_PAN_MIN) * PAN_DEG_PER_SEC;
+constexpr double PTZ_TILT_TRAVEL_DEG = (EST_TILT_MAX - EST_TILT_MIN) * TILT_DEG_PER_SEC;
+
 // Config / presets file names
 inline const std::string DEFAULT_CONFIG_FILENAME  = ".bcc950_config";
 inline const std::string DEFAULT_PRESETS_FILENAME  = ".bcc950_presets.json";
@@ -43,4 +189,11 @@ inline const std::string DEFAULT_PRESETS_FILENAME  = ".bcc950_presets.json";
 // Default device path
 inline const std::string DEFAULT_DEVICE = "/dev/video0";
 
+// Pan/tilt backend: "auto" uses positional controls when the device has
+// them; "velocity" or "relative" caps the choice
+inline const std::string DEFAULT_PTZ_MODE = "auto";
+
+// PAN/TILT_RELATIVE units per degree; zero derives them from the range
+constexpr double DEFAULT_PTZ_RELATIVE_SCALE = 0.0;
+
 } // namespace bcc950
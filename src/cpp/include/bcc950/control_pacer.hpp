@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "constants.hpp"
+#include "v4l2_device.hpp"
+
+namespace bcc950 {
+
+/// Token-bucket limits for ControlPacer. Rates are control transfers per
+/// second; a batch costs one token per control.
+struct PacerConfig {
+    double initial_rate = PACER_INITIAL_RATE;
+    double min_rate     = PACER_MIN_RATE;
+    double max_rate     = PACER_MAX_RATE;
+    double burst        = PACER_BURST;         // tokens held while idle
+    double increase     = PACER_INCREASE;      // rate added per clean write
+    double backoff      = PACER_BACKOFF;       // rate multiplier on a stall or error
+    double stall_factor = PACER_STALL_FACTOR;  // latency over this many times the baseline is a stall
+    double min_stall    = PACER_MIN_STALL;     // ...and over this many seconds
+};
+
+struct PacerStats {
+    uint64_t writes  = 0;    // control transfers issued
+    uint64_t delayed = 0;    // writes that waited for a token
+    uint64_t merged  = 0;    // waiting writes superseded by a newer value
+    uint64_t stalls  = 0;    // slow transfers that cut the rate
+    uint64_t errors  = 0;    // failed transfers that cut the rate
+    double   rate    = 0.0;  // current writes per second
+    double   latency = 0.0;  // baseline transfer latency, seconds
+};
+
+/// IV4L2Device decorator that paces control writes to what the camera's
+/// firmware sustains, so bursts degrade into coalescing instead of UVC
+/// stalls and EIO.
+///
+/// Writes spend tokens from a bucket refilled at rate(). A write that
+/// finds the bucket empty waits; while it waits, a newer write to any of
+/// its controls replaces it and the older values are never sent. A
+/// waiting batch is dropped whole, never split. The rate
+/// is learned additive-increase/multiplicative-decrease from each
+/// transfer: clean writes raise it, a transfer much slower than the
+/// baseline latency or a failed one cuts it. Writes that stop the pan or
+/// tilt motor never wait. Reads and queries pass straight through.
+class ControlPacer : public IV4L2Device {
+public:
+    explicit ControlPacer(std::unique_ptr<IV4L2Device> device,
+                          const PacerConfig& config = PacerConfig{});
+
+    void set_control(uint32_t id, int32_t value) override;
+    void set_controls(const ControlValue* values, std::size_t count) override;
+    int32_t get_control(uint32_t id) override;
+    struct v4l2_queryctrl query_control(uint32_t id) override;
+    void open(const std::string& device) override;
+    void close() override;
+    bool is_open() const override;
+
+    /// Seconds a write issued now would wait for a token: zero while the
+    /// device keeps up. CommandScheduler coalesces queued commands while
+    /// this is positive.
+    double backlog() const;
+
+    PacerStats stats() const;
+
+    IV4L2Device& device() { return *device_; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::unique_ptr<IV4L2Device> device_;
+    PacerConfig config_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    // Refilled lazily, including from backlog().
+    mutable double            tokens_;
+    mutable clock::time_point refilled_;
+    double                    rate_;
+    unsigned                  waiting_ = 0;
+    uint64_t                  next_ticket_ = 0;
+    // Ticket of the newest waiting write, single or batch, per control;
+    // 0 once a later write has gone out.
+    std::unordered_map<uint32_t, uint64_t> newest_;
+    PacerStats stats_;
+
+    void write(const ControlValue* values, std::size_t count);
+    void refill_locked(clock::time_point now) const;
+    void supersede_locked(const ControlValue* values, std::size_t count);
+    void adapt_locked(double latency, bool failed);
+};
+
+} // namespace bcc950
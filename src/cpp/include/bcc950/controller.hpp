@@ -1,15 +1,23 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "config.hpp"
 #include "constants.hpp"
+#include "control_pacer.hpp"
+#include "homing.hpp"
 #include "motion.hpp"
 #include "position.hpp"
 #include "presets.hpp"
+#include "scan_planner.hpp"
+#include "scheduler.hpp"
 #include "v4l2_device.hpp"
+#include "zoom_model.hpp"
 
 namespace bcc950 {
 
@@ -43,7 +51,17 @@ public:
     const std::string& device_path() const;
     void set_device_path(const std::string& path);
 
-    const PositionTracker& position() const;
+    /// Consistent snapshot of the position estimate. Safe to call from
+    /// any thread while the camera moves.
+    PositionTracker position() const;
+
+    /// Camera pose at `t` (PoseHistory::now() clock), for mapping a
+    /// frame's detections while the camera moves.
+    std::optional<PoseSample> pose_at(double t) const;
+
+    /// Lock-free pose log, e.g. for a TargetSelector.
+    const PoseHistory& pose_history() const;
+
     Config& config();
     const Config& config() const;
 
@@ -63,9 +81,38 @@ public:
     void move(int pan_dir = 0, int tilt_dir = 0,
               double duration = DEFAULT_MOVE_DURATION);
 
+    /// Combined move whose start write is held until `start` and whose
+    /// stop falls at `start + duration` (see synchronized_move()).
+    /// Returns false if cancelled.
+    bool move_at(int pan_dir, int tilt_dir, double duration,
+                 std::chrono::steady_clock::time_point start,
+                 MoveTiming* timing = nullptr);
+
     /// Set zoom to an absolute value.
     void zoom_to(int value);
 
+    /// Continuous velocity setpoint (-1/0/1 per axis). Call repeatedly;
+    /// only the newest value is applied and motors stop if updates cease.
+    void set_velocity(int pan_dir, int tilt_dir);
+
+    /// Relative move in fields of view, so the same request shifts the
+    /// image equally at every zoom level.
+    void move_fov(double pan_fovs, double tilt_fovs);
+
+    /// Timed move to an absolute (pan, tilt), e.g. a target bearing.
+    void move_to(double pan, double tilt);
+
+    /// Follow a planned path. Returns false if interrupted.
+    bool run_trajectory(const Trajectory& trajectory);
+
+    /// Zoom to spec.zoom, wait out the lens slew, then plan a coverage
+    /// scan from the current pose with the calibrated zoom model (not
+    /// spec.optics) and run it. Returns false if interrupted.
+    bool scan(const ScanSpec& spec);
+
+    /// Lens slew and field-of-view calibration.
+    void set_zoom_model(const ZoomModel& model);
+
     /// Combined pan + tilt + zoom.
     void move_with_zoom(int pan_dir = 0, int tilt_dir = 0,
                         int zoom_target = ZOOM_MIN,
@@ -74,7 +121,9 @@ public:
     /// Save current position as a named preset.
     void save_preset(const std::string& name);
 
-    /// Recall a named preset. Returns false if not found.
+    /// Restore a named preset's zoom, and its pan and tilt when the head
+    /// has positional controls (ptz_mode() is not Velocity). Returns false
+    /// if not found.
     bool recall_preset(const std::string& name);
 
     /// Delete a named preset. Returns false if not found.
@@ -91,9 +140,51 @@ public:
     /// Check if the device supports PTZ controls.
     bool has_ptz_support();
 
+    /// How move_to() and preset recall reach a pose: Velocity on the
+    /// BCC950, or positional controls on cameras whose catalog has them
+    /// (detected at construction, capped by the PTZ_MODE config key).
+    PtzMode ptz_mode() const;
+
+    /// Re-read the absolute pan/tilt position from the hardware. False
+    /// unless in Absolute mode.
+    bool sync_position();
+
     /// Stop all movement.
     void stop();
 
+    /// Drive into the hard stops and park at the calibrated center,
+    /// re-establishing a known position. Returns false if interrupted.
+    bool home();
+
+    /// Calibration used by home().
+    void set_homing_profile(const HomingProfile& profile);
+
+    // --- Safety ---
+
+    /// Record that the application is alive.
+    void heartbeat();
+
+    /// Stop the motors if heartbeat() is not called at least this often
+    /// during a move. Zero disables the check.
+    void set_heartbeat_timeout(double seconds);
+
+    /// Opt in to real-time scheduling of move timing. Returns false if
+    /// the system refused it (moves still run, at normal priority).
+    bool set_realtime(const RealtimeConfig& config);
+
+    /// Wakeup lateness of the sleeps between start and stop writes.
+    JitterStats wake_jitter() const;
+
+    // --- Scheduling ---
+
+    /// Priority scheduler in front of the motion controller, created on
+    /// first use. Commands submitted here preempt lower-priority sources.
+    /// If the device is a ControlPacer, its backlog throttles the queues.
+    CommandScheduler& scheduler();
+
+    /// Write pacing counters, if the device is a ControlPacer.
+    std::optional<PacerStats> pacer_stats() const;
+
 private:
     std::unique_ptr<IV4L2Device> v4l2_device_;
     std::string device_path_;
@@ -101,6 +192,8 @@ private:
     PositionTracker position_;
     MotionController motion_;
     PresetManager presets_;
+    std::once_flag scheduler_once_;
+    std::unique_ptr<CommandScheduler> scheduler_;  // destroyed before motion_
 };
 
 } // namespace bcc950
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "constants.hpp"
+#include "v4l2_device.hpp"
+
+namespace bcc950 {
+
+/// Compile-time description of a V4L2 integer control: its ID, value
+/// range and whether it may share a batched write with other controls.
+template <uint32_t Id, int32_t Min, int32_t Max, bool Batchable = true>
+struct ControlTraits {
+    static_assert(Min <= Max, "empty control range");
+
+    using value_type = int32_t;
+    static constexpr uint32_t   id            = Id;
+    static constexpr value_type minimum       = Min;
+    static constexpr value_type maximum       = Max;
+    static constexpr bool       batchable     = Batchable;
+    static constexpr uint32_t   control_class = V4L2_CTRL_ID2CLASS(Id);
+
+    static constexpr value_type clamp(value_type value) {
+        return value < Min ? Min : (value > Max ? Max : value);
+    }
+};
+
+// The BCC950's controls.
+struct PanSpeed     : ControlTraits<CTRL_PAN_SPEED, PAN_SPEED_MIN, PAN_SPEED_MAX> {};
+struct TiltSpeed    : ControlTraits<CTRL_TILT_SPEED, TILT_SPEED_MIN, TILT_SPEED_MAX> {};
+struct ZoomAbsolute : ControlTraits<CTRL_ZOOM_ABSOLUTE, ZOOM_MIN, ZOOM_MAX> {};
+
+// Positional controls at their V4L2-defined extent; a device narrows
+// them at runtime (see PtzControl). Relative offsets are not idempotent,
+// so a partly applied batch could not be retried safely: never batched.
+struct PanAbsolute  : ControlTraits<CTRL_PAN_ABSOLUTE, -180 * 3600, 180 * 3600> {};
+struct TiltAbsolute : ControlTraits<CTRL_TILT_ABSOLUTE, -180 * 3600, 180 * 3600> {};
+struct PanRelative  : ControlTraits<CTRL_PAN_RELATIVE, -360 * 3600, 360 * 3600, false> {};
+struct TiltRelative : ControlTraits<CTRL_TILT_RELATIVE, -360 * 3600, 360 * 3600, false> {};
+
+/// Write `value`, clamped to the control's range.
+template <typename C>
+void set(IV4L2Device& device, typename C::value_type value) {
+    device.set_control(C::id, C::clamp(value));
+}
+
+template <typename C>
+typename C::value_type get(IV4L2Device& device) {
+    return static_cast<typename C::value_type>(device.get_control(C::id));
+}
+
+namespace detail {
+
+template <typename C, typename... Cs>
+constexpr bool distinct_ids() {
+    if constexpr (sizeof...(Cs) == 0) {
+        return true;
+    } else {
+        return ((C::id != Cs::id) && ...) && distinct_ids<Cs...>();
+    }
+}
+
+template <typename C, typename... Cs>
+constexpr std::size_t index_of() {
+    std::size_t i = 0;
+    bool found = false;
+    ((found = found || std::is_same_v<C, Cs>, i += found ? 0 : 1), ...);
+    return i;
+}
+
+} // namespace detail
+
+/// Writes to a fixed set of controls that go out in one set_controls()
+/// call (a single VIDIOC_S_EXT_CTRLS on a real device), so e.g. both
+/// axes start or stop together. Which controls may be combined is
+/// checked at compile time: each must be batchable, all in one control
+/// class, with no duplicates. Values are clamped as they are set; only
+/// the controls set since the last apply() are written, in declaration
+/// order.
+template <typename... Cs>
+class ControlBatch {
+    static_assert(sizeof...(Cs) > 0, "empty control batch");
+    static_assert((Cs::batchable && ...), "control cannot be batched");
+    static_assert(((Cs::control_class == V4L2_CTRL_ID2CLASS(CTRL_PAN_SPEED)) && ...),
+                  "batched controls must share a control class");
+    static_assert(detail::distinct_ids<Cs...>(), "control listed twice in a batch");
+
+public:
+    template <typename C>
+    void set(typename C::value_type value) {
+        constexpr std::size_t i = detail::index_of<C, Cs...>();
+        static_assert(i < sizeof...(Cs), "control is not part of this batch");
+        values_[i] = C::clamp(value);
+        pending_ |= 1u << i;
+    }
+
+    bool empty() const { return pending_ == 0; }
+
+    /// Write the pending values and clear them.
+    void apply(IV4L2Device& device) {
+        if (pending_ == 0) {
+            return;
+        }
+        constexpr uint32_t ids[] = {Cs::id...};
+        ControlValue out[sizeof...(Cs)];
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < sizeof...(Cs); ++i) {
+            if (pending_ & (1u << i)) {
+                out[n++] = ControlValue{ids[i], values_[i]};
+            }
+        }
+        pending_ = 0;
+        device.set_controls(out, n);
+    }
+
+private:
+    int32_t  values_[sizeof...(Cs)] = {};
+    uint32_t pending_ = 0;
+};
+
+/// Write every control in `Cs` in one batch.
+template <typename... Cs>
+void set_all(IV4L2Device& device, typename Cs::value_type... values) {
+    ControlBatch<Cs...> batch;
+    (batch.template set<Cs>(values), ...);
+    batch.apply(device);
+}
+
+} // namespace bcc950
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "frame_motion.hpp"
+#include "jpeg_decoder.hpp"
+
+namespace bcc950 {
+
+/// One captured video frame, kept exactly as the camera compressed it.
+///
+/// Immutable once constructed and shared by pointer, so the dashboard
+/// stream, the recorder and vision consumers all read the same bytes
+/// without copying or re-encoding. Pixels are decoded only on request,
+/// once per resolution and format, and the result is shared by every
+/// consumer holding the frame.
+class Frame {
+public:
+    Frame(std::vector<uint8_t> jpeg, int width, int height,
+          uint64_t sequence, double timestamp,
+          MotionState motion = MotionState::Stationary)
+        : jpeg_(std::move(jpeg)), width_(width), height_(height),
+          sequence_(sequence), timestamp_(timestamp), motion_(motion) {}
+
+    /// The complete JPEG image (SOI .. EOI) as delivered by the driver.
+    const std::vector<uint8_t>& jpeg() const { return jpeg_; }
+    const uint8_t* data() const { return jpeg_.data(); }
+    std::size_t size() const { return jpeg_.size(); }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    /// Driver frame counter; gaps mean frames were dropped.
+    uint64_t sequence() const { return sequence_; }
+
+    /// Capture time on the PoseHistory::now() clock, for pose_at().
+    double timestamp() const { return timestamp_; }
+
+    /// Head motion during the exposure, from the motion log at capture
+    /// time. Stationary if the source has no motion log.
+    MotionState motion() const { return motion_; }
+
+    /// True if the frame is free of motion blur and settling shake.
+    bool settled() const { return motion_ == MotionState::Stationary; }
+
+    /// Pixels at 1/`scale` resolution (1, 2, 4 or 8), scaled inside the
+    /// IDCT. Decoded on first request and cached; concurrent requests
+    /// for the same image wait for one decode. Throws JpegError.
+    ImagePtr decode(int scale = 1, PixelFormat format = PixelFormat::Gray) const;
+
+    /// The cheapest decode that still covers min_width x min_height
+    /// (see jpeg_scale_for()).
+    ImagePtr decode_at_least(int min_width, int min_height,
+                             PixelFormat format = PixelFormat::Gray) const;
+
+private:
+    struct Decoded {
+        std::mutex mutex;  // held for the decode
+        ImagePtr   image;
+    };
+
+    std::vector<uint8_t> jpeg_;
+    int      width_;
+    int      height_;
+    uint64_t sequence_;
+    double   timestamp_;
+    MotionState motion_;
+
+    mutable std::mutex cache_mutex_;
+    mutable std::map<std::pair<int, PixelFormat>, std::unique_ptr<Decoded>> cache_;
+};
+
+using FramePtr = std::shared_ptr<const Frame>;
+
+} // namespace bcc950
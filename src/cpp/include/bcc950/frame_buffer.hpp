@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "frame_source.hpp"
+
+namespace bcc950 {
+
+/// Pulls frames from a FrameSource on a background thread and publishes
+/// the newest one to any number of consumers.
+///
+/// Consumers share the same compressed frame by pointer, so serving the
+/// dashboard or feeding the recorder costs no decode or re-encode.
+class FrameBuffer {
+public:
+    /// `source` must outlive the buffer.
+    explicit FrameBuffer(FrameSource& source);
+
+    /// Stops and joins the capture thread.
+    ~FrameBuffer();
+
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    /// Start the capture thread. Idempotent.
+    void start();
+
+    /// Stop and join the capture thread. Idempotent.
+    void stop();
+
+    /// Newest frame, or nullptr before the first one arrives.
+    FramePtr latest() const;
+
+    /// Wait up to `timeout` seconds for a frame newer than `frame_id`.
+    /// Returns the newest frame, or nullptr on timeout or stop.
+    FramePtr wait_next(uint64_t frame_id, double timeout) const;
+
+    /// Wait up to `timeout` seconds for a settled (Stationary) frame
+    /// newer than `frame_id`, skipping motion-blurred ones. Returns
+    /// nullptr on timeout or stop.
+    FramePtr wait_settled(uint64_t frame_id, double timeout) const;
+
+    /// Count of frames published so far; increases by one per frame.
+    uint64_t frame_id() const;
+
+    /// Seconds since the newest frame was captured (infinity if none).
+    double frame_age() const;
+
+    /// Source reads that threw. The thread backs off and keeps reading.
+    uint64_t errors() const;
+
+private:
+    FrameSource& source_;
+
+    mutable std::mutex              mutex_;
+    mutable std::condition_variable cv_;
+    FramePtr    latest_;
+    uint64_t    frame_id_ = 0;
+    uint64_t    errors_ = 0;
+    bool        exit_ = false;
+    std::thread thread_;
+
+    void run();
+};
+
+} // namespace bcc950
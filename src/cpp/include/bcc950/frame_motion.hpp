@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "constants.hpp"
+
+namespace bcc950 {
+
+class PoseHistory;
+
+/// What the head was doing while a frame was exposed.
+enum class MotionState : uint8_t {
+    Stationary,    // still, and past the settle time of any earlier stop
+    Accelerating,  // a move began within the motor spin-up time
+    Moving,        // at speed (pan/tilt) or zoom slewing
+    Settling,      // stopped, but the head may still be ringing
+};
+
+/// Mechanical timing used to classify frames.
+struct MotionTiming {
+    double accel_time  = MOTOR_ACCEL_TIME;
+    double settle_time = MOTOR_SETTLE_TIME;
+    double exposure    = FRAME_EXPOSURE;  // frame integrates [t - exposure, t]
+};
+
+/// Classify the exposure of a frame stamped `t` (PoseHistory::now()
+/// clock) from the motion log. The worst state over the exposure wins:
+/// Moving, then Accelerating, then Settling. Times before the retained
+/// history count as stationary.
+MotionState motion_state(const PoseHistory& history, double t,
+                         const MotionTiming& timing = MotionTiming{});
+
+} // namespace bcc950
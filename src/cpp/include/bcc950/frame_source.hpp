@@ -0,0 +1,17 @@
+#pragma once
+
+#include "frame.hpp"
+
+namespace bcc950 {
+
+/// Abstract producer of compressed frames (live camera, replay, test).
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    /// Block until the next frame is available. Returns nullptr if none
+    /// arrives within `timeout` seconds; throws on a source error.
+    virtual FramePtr read(double timeout) = 0;
+};
+
+} // namespace bcc950
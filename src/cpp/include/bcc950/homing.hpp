@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+
+#include "constants.hpp"
+#include "position.hpp"
+
+namespace bcc950 {
+
+/// Calibrated mechanics used to home the camera against its hard stops.
+///
+/// Tracker coordinates are centred on the calibrated center, so after
+/// homing the stops sit at +/- travel / 2 on each axis.
+struct HomingProfile {
+    /// Movement-seconds from one hard stop to the other.
+    double pan_travel  = EST_PAN_MAX - EST_PAN_MIN;
+    double tilt_travel = EST_TILT_MAX - EST_TILT_MIN;
+
+    /// Extra drive time past a full traverse, so the stop is always hit.
+    double overdrive = 0.5;
+
+    /// Direction of the stop to home against on each axis.
+    int pan_stop_dir  = -1;
+    int tilt_stop_dir = -1;
+
+    /// Where to park after homing, in tracker coordinates.
+    double center_pan  = 0.0;
+    double center_tilt = 0.0;
+
+    /// Optional frame-shift stall detector, polled every `poll_interval`
+    /// seconds while driving toward the stops. Returns true once the
+    /// image has stopped moving along the axis. Without it the stall is
+    /// inferred from elapsed time (travel + overdrive).
+    std::function<bool(Axis)> stall_detector;
+    double poll_interval = 0.05;
+
+    /// Tracker coordinate of the stop homed against.
+    double pan_stop()  const { return pan_stop_dir  * pan_travel  / 2.0; }
+    double tilt_stop() const { return tilt_stop_dir * tilt_travel / 2.0; }
+};
+
+} // namespace bcc950
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace bcc950 {
+
+/// Runtime error for JPEG decoding.
+class JpegError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Output layout of a decoded image.
+enum class PixelFormat {
+    Gray,  // luma only; chroma is never inverse-transformed
+    RGB,
+    BGR,   // OpenCV order
+};
+
+/// Decoded, tightly packed 8-bit pixels.
+struct Image {
+    int width    = 0;
+    int height   = 0;
+    int channels = 0;
+    PixelFormat format = PixelFormat::Gray;
+    std::vector<uint8_t> pixels;  // row-major, width * channels per row
+};
+
+using ImagePtr = std::shared_ptr<const Image>;
+
+/// True if libbcc950 was built with libjpeg(-turbo); otherwise every
+/// decode throws JpegError.
+bool jpeg_decode_supported();
+
+/// Decode a JPEG, downscaling by 1, 2, 4 or 8 inside the IDCT so the
+/// skipped detail is never computed. MJPEG frames that omit the
+/// Huffman tables (common on UVC cameras) decode with the standard
+/// ones. Throws JpegError on corrupt input or a bad scale.
+ImagePtr decode_jpeg(const uint8_t* data, std::size_t size,
+                     int scale = 1, PixelFormat format = PixelFormat::Gray);
+
+/// Largest IDCT scale (1, 2, 4 or 8) whose output of a width x height
+/// image still covers min_width x min_height, so callers can resize
+/// down from the cheapest sufficient decode.
+int jpeg_scale_for(int width, int height, int min_width, int min_height);
+
+} // namespace bcc950
@@ -1,24 +1,68 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <memory>
+#include <optional>
+#include <thread>
 
 #include "constants.hpp"
+#include "homing.hpp"
+#include "pose_history.hpp"
 #include "position.hpp"
+#include "ptz_backend.hpp"
+#include "realtime.hpp"
+#include "scan_planner.hpp"
+#include "seqlock.hpp"
 #include "v4l2_device.hpp"
+#include "watchdog.hpp"
+#include "zoom_model.hpp"
 
 namespace bcc950 {
 
+/// Counters for the continuous velocity mode.
+struct VelocityStats {
+    uint64_t updates     = 0;  // set_velocity() calls
+    uint64_t writes      = 0;  // hardware writes actually issued
+    uint64_t timeouts    = 0;  // watchdog stops after updates ceased
+    uint64_t limit_stops = 0;  // axes stopped at a soft limit
+};
+
+/// When a timed move's start and final stop writes returned.
+struct MoveTiming {
+    std::chrono::steady_clock::time_point started;  // unset if nothing was written
+    std::chrono::steady_clock::time_point stopped;
+    bool clamped = false;  // the soft limits shortened an axis, maybe to nothing
+};
+
 /// Thread-safe motion control for the BCC950.
 ///
 /// All movement methods acquire a mutex so that start-sleep-stop
-/// sequences are atomic.
+/// sequences are atomic. The sleep between start and stop can be cut
+/// short by cancel() (or stop()) from another thread.
+///
+/// Alternatively, set_velocity() runs the motors continuously: an engine
+/// thread applies the newest setpoint and only writes an axis when its
+/// effective speed changes.
+///
+/// Every timed move arms a Watchdog deadline; if the mover stalls past
+/// it, the watchdog thread writes the stop itself.
 class MotionController {
 public:
     /// Construct with a V4L2 device (non-owning pointer).
     MotionController(IV4L2Device* device, PositionTracker* position = nullptr);
 
-    /// Pan camera. direction: -1 (left) or 1 (right).
+    /// Joins the velocity engine and stops any motor it left running.
+    ~MotionController();
+
+    MotionController(const MotionController&) = delete;
+    MotionController& operator=(const MotionController&) = delete;
+
+    /// Pan camera. direction: -1 (left) or 1 (right). The move is cut
+    /// short where the estimate would cross the soft pan limit.
     void pan(int direction, double duration = DEFAULT_MOVE_DURATION);
 
     /// Tilt camera. direction: 1 (up) or -1 (down).
@@ -28,21 +72,181 @@ public:
     void combined_move(int pan_dir, int tilt_dir,
                        double duration = DEFAULT_MOVE_DURATION);
 
+    /// Simultaneous pan + tilt that is abandoned if cancel() has been
+    /// called since `token` was taken from cancel_token(). Used by
+    /// schedulers that must be able to preempt a move before it starts.
+    void combined_move(int pan_dir, int tilt_dir, double duration,
+                       uint64_t token);
+
+    /// As combined_move(), but the start write is staged and held until
+    /// `start`, and both axes stop at `start + duration`, so cameras
+    /// given the same instant move together. A start that goes out late
+    /// (the motion mutex was busy) still stops on time, with the travel
+    /// credited accordingly; one that would go out after the stop writes
+    /// nothing and returns false. Fills `timing` if not null. Returns
+    /// false if cancelled, possibly before anything was written.
+    bool combined_move_at(int pan_dir, int tilt_dir, double duration,
+                          std::chrono::steady_clock::time_point start,
+                          MoveTiming* timing = nullptr);
+
     /// Simultaneous pan + tilt + zoom to target.
     void combined_move_with_zoom(int pan_dir, int tilt_dir,
                                  int zoom_target,
                                  double duration = DEFAULT_MOVE_DURATION);
 
+    /// Move from the current estimate to (pan, tilt), both axes in
+    /// parallel. Timed per axis in Velocity mode; otherwise one
+    /// positional write per axis (see set_ptz_capabilities()).
+    void move_to(double pan, double tilt);
+
+    /// Visit each waypoint in turn (both axes in parallel per leg),
+    /// holding for its dwell. Returns false if cancelled part-way.
+    bool run_trajectory(const Trajectory& trajectory);
+
+    /// As run_trajectory(), abandoned if cancel() was called since `token`.
+    bool run_trajectory(const Trajectory& trajectory, uint64_t token);
+
     /// Set zoom to an absolute value (clamped to ZOOM_MIN..ZOOM_MAX).
     void zoom_absolute(int value);
 
     /// Adjust zoom by a relative delta from current position.
     void zoom_relative(int delta);
 
-    /// Stop all movement.
+    // --- Zoom slew and field-of-view motion ---
+
+    /// Estimated lens position. position().zoom is the commanded value;
+    /// the lens lags it while slewing.
+    double lens_zoom() const;
+
+    /// Seconds until the lens reaches the commanded zoom.
+    double zoom_settle_time() const;
+
+    /// Sleep only until the lens reaches the commanded zoom. Returns
+    /// false if cancel() cut the wait short.
+    bool wait_zoom_settled();
+
+    /// Relative move measured in fields of view at the commanded zoom
+    /// (positive: right/up). Waits out any zoom slew first.
+    void move_fov(double pan_fovs, double tilt_fovs);
+
+    /// Zoom-normalized velocity: hold (pan_rate, tilt_rate), in fields of
+    /// view per second, for one control `period`. The motors are either
+    /// at full speed or stopped, so each axis runs for the share of the
+    /// period that yields the requested displacement, saturating at
+    /// ZoomModel::fov_rate(). Uses the lens position mid-slew rather
+    /// than waiting, so tracker gains hold across zoom levels.
+    void move_fov_velocity(double pan_rate, double tilt_rate,
+                           double period = DEFAULT_MOVE_DURATION);
+
+    void set_zoom_model(const ZoomModel& model);
+    ZoomModel zoom_model() const;
+
+    /// Cut short any in-flight timed move and abandon moves still waiting
+    /// for the motion mutex. An interrupted move writes its stop early and
+    /// the position tracker is credited with the time actually travelled.
+    /// Does not wait for the motion mutex.
+    void cancel();
+
+    /// Current cancel epoch; pass to combined_move() to make a move
+    /// cancellable before it has acquired the motion mutex.
+    uint64_t cancel_token() const;
+
+    /// Stop all movement, cancelling any in-flight timed move first.
     void stop();
 
-    /// Access the position tracker.
+    // --- Positional pan/tilt ---
+
+    /// Reach move_to(), trajectory and field-of-view targets through the
+    /// best positional controls in `caps`, up to `limit`, instead of
+    /// timed speed bursts. Targets convert to control units with the zoom
+    /// model's pan/tilt rates and each control's units_per_degree. In
+    /// Absolute mode the estimate is read back from the hardware, starting
+    /// now. Returns the mode in use.
+    PtzMode set_ptz_capabilities(const PtzCapabilities& caps,
+                                 PtzMode limit = PtzMode::Absolute);
+
+    PtzMode ptz_mode() const;
+    PtzCapabilities ptz_capabilities() const;
+
+    /// Replace the pan/tilt estimate with the hardware's absolute
+    /// position. Returns false, leaving the estimate alone, unless in
+    /// Absolute mode and the read succeeds.
+    bool sync_position();
+
+    // --- Homing ---
+
+    /// Drive both axes in parallel into their hard stops, reset the
+    /// tracker to that known reference, then move to the calibrated
+    /// center. Returns false if cancelled part-way, in which case the
+    /// estimate is unreliable.
+    bool home();
+
+    /// As home(), abandoned if cancel() was called since `token`.
+    bool home(uint64_t token);
+
+    void set_homing_profile(const HomingProfile& profile);
+    HomingProfile homing_profile() const;
+
+    // --- Continuous velocity mode ---
+
+    /// Update the desired per-axis direction (-1, 0, 1). Returns
+    /// immediately; superseded setpoints are never written. Motors stop
+    /// if no update arrives within velocity_timeout(). Timed moves and
+    /// stop() end velocity mode.
+    void set_velocity(int pan_dir, int tilt_dir);
+
+    /// Seconds without a set_velocity() call before the motors stop.
+    void set_velocity_timeout(double seconds);
+    double velocity_timeout() const;
+
+    VelocityStats velocity_stats() const;
+
+    // --- Safety watchdog ---
+
+    /// Record that the application is alive (see set_heartbeat_timeout).
+    void heartbeat();
+
+    /// Require heartbeat() at least this often while a move is running,
+    /// or the motors are stopped. Zero (the default) disables the check.
+    void set_heartbeat_timeout(double seconds);
+
+    /// Number of stops forced by the watchdog.
+    uint64_t watchdog_expirations() const;
+
+    // --- Real-time timing ---
+
+    /// Time moves under `config`: the thread running each timed move,
+    /// and the velocity engine, switch to SCHED_FIFO while they work,
+    /// and every start-to-stop sleep ends in a busy-wait of
+    /// `config.spin`. Returns false, with the reason in realtime_error(),
+    /// if scheduling or the memory lock is refused; moves still run,
+    /// at normal priority.
+    bool set_realtime(const RealtimeConfig& config);
+    RealtimeConfig realtime() const;
+    std::string realtime_error() const;
+
+    /// How late each sleep between motion writes woke past its deadline.
+    JitterStats wake_jitter() const;
+    void reset_wake_jitter();
+
+    // --- Pose history ---
+
+    /// Where the camera was at `t` (PoseHistory::now() clock), e.g. a
+    /// frame's capture timestamp. Lock-free; nullopt if `t` predates the
+    /// retained history.
+    std::optional<PoseSample> pose_at(double t) const;
+
+    const PoseHistory& pose_history() const;
+
+    /// Reset the estimate to the origin and record the jump.
+    void reset_position();
+
+    /// Consistent copy of the position estimate, republished after every
+    /// update. Lock-free and safe from any thread, at any rate.
+    PositionTracker snapshot() const;
+
+    /// Access the position tracker. The motion path mutates it under its
+    /// own lock, so other threads should read snapshot() instead.
     PositionTracker& position();
     const PositionTracker& position() const;
 
@@ -52,8 +256,143 @@ private:
     PositionTracker* position_;
     std::mutex       mutex_;
 
-    static int clamp_speed(int value);
-    static int clamp_zoom(int value);
+    mutable std::mutex      cancel_mutex_;
+    std::condition_variable cancel_cv_;
+    uint64_t                cancel_seq_ = 0;
+
+    // Velocity engine. Lock order: mutex_ before engine_mutex_.
+    mutable std::mutex      engine_mutex_;
+    std::condition_variable engine_cv_;
+    std::thread             engine_;
+    bool                    engine_exit_ = false;
+    bool                    setpoint_dirty_ = false;
+    int                     desired_pan_  = 0;
+    int                     desired_tilt_ = 0;
+    uint64_t                velocity_epoch_ = 0;
+    uint64_t                realtime_epoch_ = 0;  // bumped by set_realtime()
+    RealtimeConfig          engine_realtime_;
+    double                  velocity_timeout_ = DEFAULT_VELOCITY_TIMEOUT;
+    std::chrono::steady_clock::time_point last_update_;
+    std::chrono::steady_clock::time_point limit_deadline_ =
+        std::chrono::steady_clock::time_point::max();
+    VelocityStats           velocity_stats_;
+
+    // Speeds currently applied by the engine. Guarded by mutex_.
+    int applied_pan_  = 0;
+    int applied_tilt_ = 0;
+    std::chrono::steady_clock::time_point applied_since_;
+
+    PoseHistory history_;
+    SeqLock<PositionTracker> published_;
+
+    mutable std::mutex config_mutex_;
+    HomingProfile      homing_profile_;
+    ZoomModel          zoom_model_;
+    PtzCapabilities    ptz_;
+    PtzMode            ptz_mode_ = PtzMode::Velocity;
+    RealtimeConfig     realtime_;
+    std::string        realtime_error_;
+    bool               memory_locked_ = false;
+
+    JitterHistogram jitter_;
+
+    // Lens slew from zoom_from_ to zoom_to_, begun at zoom_started_.
+    mutable std::mutex zoom_mutex_;
+    double             zoom_from_;
+    double             zoom_to_;
+    std::chrono::steady_clock::time_point zoom_started_;
+
+    // Declared last so it is destroyed (and joined) first.
+    Watchdog watchdog_;
+
+    class StopGuard;
+
+    void engine_loop();
+
+    /// Watchdog expiry: abandon the stalled move and write the stop
+    /// without waiting for mutex_.
+    void force_stop();
+
+    /// Write the axes whose speed differs from the applied one, unless
+    /// velocity mode was ended after `epoch` was read.
+    void apply_velocity(int pan_speed, int tilt_speed, uint64_t epoch);
+
+    /// Credit the running velocity to the tracker and restart the clock.
+    /// Caller must hold mutex_.
+    void integrate_velocity_locked();
+
+    /// Leave velocity mode, writing a stop to running axes if
+    /// `write_stop`. Caller must hold mutex_.
+    void halt_velocity_locked(bool write_stop);
+
+    /// Parameters of one start-sleep-stop sequence.
+    struct TimedMove {
+        bool   use_pan       = false;
+        int    pan_speed     = 0;
+        double pan_duration  = 0.0;
+        bool   use_tilt      = false;
+        int    tilt_speed    = 0;
+        double tilt_duration = 0.0;
+        std::optional<int> zoom;       // also write this zoom at the start
+        bool   respect_limits = true;  // truncate at the soft limits
+        std::function<bool(Axis)> stalled;  // polled; true stops the axis
+        double poll_interval = 0.05;
+        // Hold the start write until then; durations count from it.
+        std::optional<std::chrono::steady_clock::time_point> start_at;
+        MoveTiming* timing = nullptr;  // filled as the writes return
+    };
+
+    /// Start-sleep-stop on the selected axes, stopping each axis early at
+    /// its soft limit. Returns false if cancelled. Caller must hold mutex_.
+    bool timed_move_locked(const TimedMove& move, uint64_t token);
+
+    /// Per-axis timed move from the current estimate to (pan, tilt).
+    /// Caller must hold mutex_.
+    TimedMove move_toward_locked(double pan, double tilt) const;
+
+    /// Move to (pan, tilt) with the configured backend. Returns false if
+    /// cancelled. Caller must hold mutex_.
+    bool move_to_locked(double pan, double tilt, uint64_t token);
+
+    /// One positional write per axis, then wait out the travel at full
+    /// speed. A cancel re-targets the axes still travelling to where
+    /// they are estimated to be. No watchdog deadline: the camera stops
+    /// at the target by itself. Caller must hold mutex_.
+    bool positional_move_locked(double pan, double tilt, uint64_t token);
+
+    /// Read the absolute controls into the estimate. Caller must hold
+    /// mutex_.
+    bool sync_position_locked();
+
+    /// Record that the lens was commanded to `target`.
+    void begin_zoom_slew(int target);
+
+    /// Append a pose sample stamped now, with the current lens slew.
+    void record_pose(double pan, double tilt, int pan_speed, int tilt_speed);
+
+    /// Publish the tracker to snapshot() readers and record it in the
+    /// history. Caller must hold mutex_.
+    void commit_pose_locked(int pan_speed, int tilt_speed);
+
+    bool wait_zoom_settled(uint64_t token);
+
+    /// Shift by (pan_fovs, tilt_fovs) fields of view at `zoom`, each axis
+    /// limited to `max_seconds` of travel.
+    void fov_move(double pan_fovs, double tilt_fovs, double zoom,
+                  double max_seconds, uint64_t token);
+
+    /// Busy-wait tail for precise sleeps: realtime().spin when enabled,
+    /// otherwise zero.
+    double spin_seconds() const;
+
+    /// Sleep up to `duration` seconds unless cancelled past `token`.
+    /// Returns the seconds to credit to the position tracker.
+    double interruptible_sleep(double duration, uint64_t token);
+
+    /// Sleep until `offset` seconds after `origin` unless cancelled past
+    /// `token`. Returns the seconds since `origin`, capped at `offset`.
+    double interruptible_sleep_until(std::chrono::steady_clock::time_point origin,
+                                     double offset, uint64_t token);
 };
 
 } // namespace bcc950
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "constants.hpp"
+#include "seqlock.hpp"
+
+namespace bcc950 {
+
+/// Camera pose at an instant.
+struct PoseSample {
+    /// Seconds on the monotonic clock, the same clock V4L2 uses for
+    /// buffer timestamps. See PoseHistory::now().
+    double  timestamp = 0.0;
+    double  pan  = 0.0;
+    double  tilt = 0.0;
+    double  zoom = ZOOM_DEFAULT;     // estimated lens position
+    double  zoom_rate = 0.0;         // zoom units per second while slewing
+    int32_t zoom_target = ZOOM_DEFAULT;
+    int8_t  pan_speed  = 0;          // speed applied from this instant
+    int8_t  tilt_speed = 0;
+
+    bool moving() const {
+        return pan_speed != 0 || tilt_speed != 0 || zoom_rate != 0.0;
+    }
+};
+
+/// Fixed-size, lock-free history of camera poses.
+///
+/// The motion path records a sample on every state change (motor start
+/// or stop, zoom command, position reset). Readers on any thread can ask
+/// where the camera was at a past instant, such as a frame's capture
+/// timestamp, without taking the motion lock. Old samples are
+/// overwritten once the ring is full.
+class PoseHistory {
+public:
+    /// `capacity` is rounded up to a power of two.
+    explicit PoseHistory(std::size_t capacity = POSE_HISTORY_CAPACITY);
+
+    PoseHistory(const PoseHistory&) = delete;
+    PoseHistory& operator=(const PoseHistory&) = delete;
+
+    /// Append a sample. Safe to call from several threads.
+    void record(const PoseSample& sample);
+
+    /// Most recent sample, if any.
+    std::optional<PoseSample> latest() const;
+
+    /// Pose at time `t`. Pan and tilt are interpolated between the
+    /// samples either side of `t` and dead-reckoned from the newest one
+    /// past the end; zoom follows the slew rate recorded with the
+    /// preceding sample. Returns nullopt if `t` predates the retained
+    /// history.
+    std::optional<PoseSample> pose_at(double t) const;
+
+    /// Retained samples, oldest first.
+    std::vector<PoseSample> samples() const;
+
+    /// Samples stamped in (t0, t1], oldest first, preceded by the newest
+    /// one at or before t0 (the pose in force at t0) if still retained.
+    std::vector<PoseSample> samples_between(double t0, double t1) const;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    /// Current time on the history's clock.
+    static double now();
+
+private:
+    struct Slot {
+        uint64_t   index = 0;  // write index + 1; zero means never written
+        PoseSample sample;
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<SeqLock<Slot>[]> slots_;
+    std::atomic<uint64_t> head_{0};
+
+    /// Read the sample written at `index`; false if it was overwritten
+    /// or is still being written.
+    bool read(uint64_t index, PoseSample& out) const;
+};
+
+/// Project `from` forward to time `t` using its speeds and zoom slew.
+PoseSample extrapolate(const PoseSample& from, double t);
+
+} // namespace bcc950
@@ -4,6 +4,9 @@
 
 namespace bcc950 {
 
+/// A mechanical axis.
+enum class Axis { Pan, Tilt };
+
 /// Tracks estimated camera position based on movement-seconds.
 ///
 /// The BCC950 has no absolute pan/tilt readback, so we accumulate
@@ -27,6 +30,14 @@ struct PositionTracker {
     /// Update zoom to an absolute value (clamped).
     void update_zoom(int value);
 
+    /// Seconds of travel at `speed` before the pan estimate reaches a soft
+    /// limit. Zero if already at the limit, infinity if speed is 0.
+    double time_to_pan_limit(int speed) const;
+
+    /// Seconds of travel at `speed` before the tilt estimate reaches a soft
+    /// limit. Zero if already at the limit, infinity if speed is 0.
+    double time_to_tilt_limit(int speed) const;
+
     /// Euclidean distance to another position (pan/tilt only).
     double distance_to(const PositionTracker& other) const;
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "constants.hpp"
+#include "v4l2_device.hpp"
+
+namespace bcc950 {
+
+/// How MotionController reaches a pan/tilt target, in order of
+/// preference.
+enum class PtzMode {
+    Velocity,  // timed bursts on PAN_SPEED/TILT_SPEED (the BCC950)
+    Relative,  // one PAN_RELATIVE/TILT_RELATIVE offset write per axis
+    Absolute,  // one PAN_ABSOLUTE/TILT_ABSOLUTE target write, read back
+};
+
+/// A positional pan or tilt control as the driver reports it. Values
+/// are positive to the right and up. Absolute controls count in
+/// arc-seconds as V4L2 specifies; relative units are undefined, so
+/// probe_ptz() derives units_per_degree from the range and callers may
+/// overwrite it with a calibrated value.
+struct PtzControl {
+    bool    supported = false;
+    int32_t minimum   = 0;
+    int32_t maximum   = 0;
+    int32_t step      = 1;
+    double  units_per_degree = PTZ_UNITS_PER_DEGREE;
+
+    /// `value` rounded to the step and clamped to the range.
+    int32_t clamp(double value) const;
+};
+
+/// Positional pan/tilt controls found in a device's control catalog.
+struct PtzCapabilities {
+    PtzControl pan_absolute;
+    PtzControl tilt_absolute;
+    PtzControl pan_relative;
+    PtzControl tilt_relative;
+
+    /// The best mode both axes support, no higher than `limit`.
+    PtzMode mode(PtzMode limit = PtzMode::Absolute) const;
+};
+
+/// Query the four positional controls. A control counts only if the
+/// query succeeds and it is an enabled, writable integer with a
+/// non-empty range. A relative control's largest offset is taken to
+/// span the axis's full travel (PTZ_PAN_TRAVEL_DEG, PTZ_TILT_TRAVEL_DEG),
+/// which sets its units_per_degree.
+PtzCapabilities probe_ptz(IV4L2Device& device);
+
+/// Calibrate both relative controls to `units_per_degree`. Zero or
+/// negative keeps the values derived by probe_ptz().
+void set_relative_scale(PtzCapabilities& caps, double units_per_degree);
+
+/// The highest mode a PTZ_MODE config value allows: "velocity",
+/// "relative", or "absolute"/"auto" (anything else).
+PtzMode parse_ptz_mode(const std::string& value);
+
+/// Name of a mode as written in the config file.
+const char* ptz_mode_name(PtzMode mode);
+
+} // namespace bcc950
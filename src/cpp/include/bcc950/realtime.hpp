@@ -0,0 +1,143 @@
+#pragma once
+
+#include <sched.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+namespace bcc950 {
+
+/// Opt-in real-time scheduling for the threads that time moves.
+struct RealtimeConfig {
+    bool   enabled     = false;
+    int    priority    = RT_DEFAULT_PRIORITY;  // SCHED_FIFO priority, 1-99
+    int    cpu         = -1;                   // pin to this CPU; -1 leaves affinity alone
+    bool   lock_memory = true;                 // mlockall() so a page fault cannot delay a stop
+    double spin        = RT_SPIN_SECONDS;      // busy-wait this long before each deadline
+};
+
+/// Runs the calling thread under SCHED_FIFO (and pinned, if configured)
+/// for the lifetime of the object, then restores its previous policy
+/// and affinity. Does nothing unless `config.enabled`. Failure, usually
+/// EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO allowance, leaves the
+/// thread as it was and is reported by error().
+class ScopedRealtime {
+public:
+    explicit ScopedRealtime(const RealtimeConfig& config);
+    ~ScopedRealtime();
+
+    ScopedRealtime(const ScopedRealtime&) = delete;
+    ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+
+    /// True if the thread now runs under SCHED_FIFO.
+    bool active() const { return scheduled_; }
+
+    /// Why scheduling or pinning failed; empty on success.
+    const std::string& error() const { return error_; }
+
+private:
+    bool        scheduled_ = false;
+    bool        pinned_    = false;
+    int         old_policy_ = SCHED_OTHER;
+    sched_param old_param_{};
+    cpu_set_t   old_cpus_{};
+    std::string error_;
+};
+
+/// mlockall(MCL_CURRENT | MCL_FUTURE). Returns an empty string on
+/// success, otherwise the reason it failed.
+std::string lock_process_memory();
+
+/// Undo lock_process_memory().
+void unlock_process_memory();
+
+/// Distribution of how late timed sleeps woke past their deadlines.
+/// Bucket 0 counts wakes under 1 µs late, bucket i those in
+/// [2^(i-1), 2^i) µs, and the last bucket everything beyond.
+struct JitterStats {
+    uint64_t count = 0;
+    double   mean  = 0.0;  // seconds
+    double   max   = 0.0;  // seconds
+    std::vector<uint64_t> buckets;
+
+    /// Upper edge (seconds) of the bucket holding the `q` quantile
+    /// (0-1); infinity if it falls in the overflow bucket, 0 if empty.
+    double quantile(double q) const;
+
+    /// Upper edge of bucket `i` in seconds.
+    static double bucket_limit(std::size_t i);
+};
+
+/// Lock-free wakeup-jitter histogram; any thread may record or read.
+class JitterHistogram {
+public:
+    static constexpr std::size_t BUCKETS = JITTER_BUCKETS;
+
+    /// Record a wake `late` seconds past its deadline (negative counts
+    /// as on time).
+    void record(double late);
+
+    JitterStats stats() const;
+    void reset();
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> total_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+namespace detail {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace detail
+
+/// Wait on `cv` until `deadline` or until `done()` holds, whichever is
+/// first; returns done(). The wait blocks on an absolute monotonic
+/// deadline `spin` seconds early, then busy-waits the rest, so the wake
+/// lands within microseconds of the deadline instead of a scheduler
+/// tick after it. While spinning, `lock` is released for a few
+/// microseconds between checks so whoever changes the predicate can
+/// take it.
+template <typename Predicate>
+bool wait_until_precise(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                        std::chrono::steady_clock::time_point deadline, double spin,
+                        Predicate done) {
+    using clock = std::chrono::steady_clock;
+    auto early = deadline - std::chrono::duration_cast<clock::duration>(
+                                std::chrono::duration<double>(spin));
+    if (cv.wait_until(lock, early, done)) {
+        return true;
+    }
+    while (!done()) {
+        auto now = clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto until = std::min(deadline, now + std::chrono::microseconds(RT_SPIN_CHECK_US));
+        lock.unlock();
+        while (clock::now() < until) {
+            detail::cpu_relax();
+        }
+        lock.lock();
+    }
+    return true;
+}
+
+} // namespace bcc950
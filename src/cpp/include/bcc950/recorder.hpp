@@ -0,0 +1,168 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "constants.hpp"
+#include "frame.hpp"
+#include "pose_history.hpp"
+
+namespace bcc950 {
+
+/// Recording segment layout. Each segment is a pair of files:
+///
+///   <base>.mjpg  the frames' JPEG bytes, back to back, unmodified
+///   <base>.idx   a RecordIndexHeader followed by one RecordIndexEntry
+///                per frame, in capture order
+///
+/// All fields are little-endian. An index entry is written only after
+/// its frame's bytes have been written and fdatasync'd, so a segment cut
+/// short by a crash or power loss is still readable up to its last
+/// indexed frame.
+struct RecordIndexHeader {
+    char     magic[8];      // RECORD_INDEX_MAGIC
+    uint32_t version;       // RECORD_INDEX_VERSION
+    uint32_t entry_size;    // sizeof(RecordIndexEntry)
+};
+
+/// One recorded frame with the camera pose at its capture time.
+struct RecordIndexEntry {
+    uint64_t sequence;      // V4L2 sequence number
+    double   timestamp;     // capture time, PoseHistory::now() clock
+    uint64_t offset;        // byte offset in the .mjpg file
+    uint32_t size;          // JPEG bytes
+    uint16_t width;
+    uint16_t height;
+    double   pan;           // pose at `timestamp`, movement-seconds
+    double   tilt;
+    double   zoom;
+    int8_t   pan_speed;
+    int8_t   tilt_speed;
+    uint8_t  motion;        // MotionState
+    uint8_t  flags;         // RECORD_FLAG_*
+    uint8_t  reserved[4];
+};
+
+constexpr char     RECORD_INDEX_MAGIC[8]   = {'B', 'C', 'C', '9', '5', '0', 'R', 'X'};
+constexpr uint32_t RECORD_INDEX_VERSION    = 1;
+constexpr uint8_t  RECORD_FLAG_POSE_VALID  = 0x01;  // pose fields are meaningful
+
+static_assert(sizeof(RecordIndexHeader) == 16, "index header layout");
+static_assert(sizeof(RecordIndexEntry) == 64, "index entry layout");
+
+/// Recorder settings.
+struct RecorderConfig {
+    std::string directory = ".";
+    std::string prefix    = "bcc950";   // segments are <prefix>_<NNNNNN>.*
+    uint64_t    max_segment_bytes   = RECORD_SEGMENT_BYTES;
+    double      max_segment_seconds = RECORD_SEGMENT_SECONDS;
+    std::size_t queue_frames = RECORD_QUEUE_FRAMES;  // beyond this, frames are dropped
+    std::size_t chunk_bytes  = RECORD_CHUNK_BYTES;   // rounded up to RECORD_ALIGNMENT
+    std::size_t queue_depth  = RECORD_QUEUE_DEPTH;   // chunks in flight
+    bool        direct_io    = true;  // O_DIRECT where the filesystem allows it
+};
+
+/// Recorder counters.
+struct RecorderStats {
+    uint64_t frames   = 0;  // frames indexed on disk
+    uint64_t dropped  = 0;  // frames discarded: queue full or write failed
+    uint64_t bytes    = 0;  // JPEG bytes on disk
+    uint64_t segments = 0;  // segments opened
+    uint64_t errors   = 0;  // I/O failures
+};
+
+/// Writes passthrough MJPEG frames and their camera poses to rotating
+/// segment files.
+///
+/// write() only queues the shared frame, so the capture loop never
+/// waits on the disk; when the writer falls behind, frames are dropped
+/// and counted rather than stalling capture. A writer thread copies
+/// frames into large aligned chunks and writes them with O_DIRECT, via
+/// io_uring with several chunks in flight when libbcc950 was built with
+/// liburing and the kernel allows it, otherwise with pwrite. Segments
+/// rotate by size or by capture time. After an I/O failure (e.g. a full
+/// disk) frames are dropped for a backoff interval, RECORD_RETRY_MIN
+/// doubling to RECORD_RETRY_MAX, before another segment is tried.
+class Recorder {
+public:
+    /// `history` (e.g. MotionController::pose_history()), if given,
+    /// supplies each frame's pose and must outlive the recorder.
+    explicit Recorder(const RecorderConfig& config = RecorderConfig{},
+                      const PoseHistory* history = nullptr);
+
+    /// Stops, flushing queued frames.
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /// True if libbcc950 was built with liburing.
+    static bool io_uring_supported();
+
+    /// Start the writer thread. Idempotent.
+    void start();
+
+    /// Write out queued frames, close the open segment and join the
+    /// writer thread. Idempotent.
+    void stop();
+
+    bool running() const;
+
+    /// Queue a frame. Never blocks on I/O; returns false if the recorder
+    /// is stopped or the frame was dropped because the queue is full.
+    bool write(FramePtr frame);
+
+    /// Close the open segment before the next frame.
+    void rotate();
+
+    RecorderStats stats() const;
+
+    /// Base paths (without extension) of the segments opened so far.
+    std::vector<std::string> segments() const;
+
+    /// Message of the most recent I/O failure, empty if none.
+    std::string last_error() const;
+
+    const RecorderConfig& config() const { return config_; }
+
+private:
+    struct Segment;
+
+    RecorderConfig     config_;
+    const PoseHistory* history_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    std::deque<FramePtr>    queue_;
+    bool                    rotate_ = false;
+    bool                    exit_ = false;
+    RecorderStats           stats_;   // dropped: queue overflow only
+    uint64_t                taken_ = 0;  // frames handed to the writer
+    uint64_t                lost_ = 0;   // of those, lost to I/O failures
+    std::vector<std::string> segments_;
+    std::string             last_error_;
+    std::thread             thread_;
+
+    // Writer thread only.
+    std::unique_ptr<Segment> segment_;
+    uint32_t                 next_index_ = 0;
+    std::chrono::steady_clock::time_point retry_at_{};
+    double                   retry_delay_ = RECORD_RETRY_MIN;
+
+    void run();
+    void record(const Frame& frame);
+    void open_segment(double timestamp);
+    void close_segment();
+    void flush_index(bool all);
+    void fail(const std::string& message);
+};
+
+} // namespace bcc950
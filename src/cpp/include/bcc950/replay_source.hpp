@@ -0,0 +1,112 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "frame_source.hpp"
+#include "pose_history.hpp"
+#include "recorder.hpp"
+
+namespace bcc950 {
+
+/// Playback settings.
+struct ReplayConfig {
+    double speed = 1.0;   // 1 = real time, 2 = twice as fast, 0 = as fast as read
+    bool   loop  = false; // restart at the first frame after the last
+};
+
+/// Plays Recorder segments back as a FrameSource, with no camera.
+///
+/// Segments are memory-mapped; read() copies one frame's JPEG bytes
+/// and paces delivery by the recorded capture times scaled by `speed`,
+/// or returns frames as fast as they are read for benchmarks. Each
+/// frame's recorded pose is replayed into pose_history(), so trackers
+/// and the motion tagger see the camera move exactly as it did.
+///
+/// Timestamps are rebased onto a monotonic timeline that keeps the
+/// recorded spacing, starting at PoseHistory::now() on the first read
+/// and continuing past seeks and loops without going backwards.
+/// seek() and set_speed() may be called while another thread reads.
+class ReplaySource : public FrameSource {
+public:
+    /// `segments` are base paths as returned by Recorder::segments() or
+    /// find_segments(). Throws std::runtime_error if a segment is
+    /// missing or not a recording. A segment cut short (crash, full
+    /// disk) plays up to its last complete frame.
+    explicit ReplaySource(const std::vector<std::string>& segments,
+                          const ReplayConfig& config = ReplayConfig{});
+    ~ReplaySource() override;
+
+    ReplaySource(const ReplaySource&) = delete;
+    ReplaySource& operator=(const ReplaySource&) = delete;
+
+    /// Base paths of the `<prefix>_*.idx` segments in `directory`,
+    /// sorted by name (recording order).
+    static std::vector<std::string> find_segments(const std::string& directory,
+                                                  const std::string& prefix = "bcc950");
+
+    /// Next frame, waiting until it is due. Returns nullptr if it is not
+    /// due within `timeout` seconds, or after the last frame when not
+    /// looping.
+    FramePtr read(double timeout) override;
+
+    /// Continue from the first frame recorded at or after `timestamp`
+    /// (recorded clock). Returns false, leaving the position at the end,
+    /// if there is none.
+    bool seek(double timestamp);
+
+    /// Continue from frame `index` (0-based). Returns false if past the
+    /// end.
+    bool seek_frame(std::size_t index);
+
+    void set_speed(double speed);
+    double speed() const;
+
+    /// Total frames in all segments.
+    std::size_t frame_count() const { return items_.size(); }
+
+    /// Index of the next frame read() returns.
+    std::size_t position() const;
+
+    /// Recorded capture times of the first and last frames (0 if empty).
+    double start_time() const;
+    double end_time() const;
+
+    /// True once the last frame has been read (never when looping).
+    bool finished() const;
+
+    /// Recorded poses of the frames read so far, on the rebased clock.
+    const PoseHistory& pose_history() const { return poses_; }
+
+private:
+    struct Mapping;
+    struct Item {
+        const RecordIndexEntry* entry;
+        const uint8_t*          data;  // the segment's mapped .mjpg
+    };
+
+    ReplayConfig                          config_;
+    std::vector<std::unique_ptr<Mapping>> mappings_;
+    std::vector<Item>                     items_;
+    PoseHistory                           poses_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    std::size_t cursor_ = 0;
+    uint64_t    generation_ = 0;   // bumped by seek/speed changes to wake read()
+    bool        anchored_ = false; // timeline anchor valid
+    double      anchor_recorded_ = 0.0;  // recorded time of the anchor frame
+    double      anchor_emitted_ = 0.0;   // its rebased timestamp
+    double      anchor_wall_ = 0.0;      // PoseHistory::now() when it was due
+    double      last_emitted_ = 0.0;
+
+    void load(const std::string& base);
+    void reanchor_locked();
+};
+
+} // namespace bcc950
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "constants.hpp"
+#include "zoom_model.hpp"
+
+namespace bcc950 {
+
+/// A pose to pass through, in movement-seconds.
+struct Waypoint {
+    double pan   = 0.0;
+    double tilt  = 0.0;
+    double dwell = 0.0;  // seconds to hold here before the next leg
+};
+
+/// Ordered waypoints for MotionController::run_trajectory().
+struct Trajectory {
+    std::vector<Waypoint> waypoints;
+
+    /// Seconds to run from (pan, tilt) through every waypoint, dwells
+    /// included. Pan and tilt move in parallel at one movement-second per
+    /// second, so each leg takes the longer of its two axis distances.
+    double duration(double from_pan, double from_tilt) const;
+};
+
+enum class ScanPattern {
+    Boustrophedon,  // continuous back-and-forth rows, waypoints at row ends
+    Spiral,         // snapshot poses ringed outward from the start
+    Snapshots,      // snapshot poses in back-and-forth order
+};
+
+/// What to cover and how.
+struct ScanSpec {
+    double pan_min  = EST_PAN_MIN;
+    double pan_max  = EST_PAN_MAX;
+    double tilt_min = EST_TILT_MIN;
+    double tilt_max = EST_TILT_MAX;
+    int    zoom     = ZOOM_MIN;
+    double overlap  = 0.2;   // fraction of the field of view neighbours share
+    double dwell    = 0.0;   // hold at each snapshot pose (seconds)
+    ScanPattern pattern = ScanPattern::Boustrophedon;
+    ZoomModel   optics;
+};
+
+/// Poses along one axis spaced at most a field of view times
+/// (1 - overlap) apart, spanning [lo, hi] evenly.
+std::vector<double> scan_positions(double lo, double hi, double step);
+
+/// Plan a trajectory covering `spec` from the current pose. Spacing
+/// comes from the field of view at spec.zoom; among the pattern's
+/// orientations and starting corners, the one with the shortest total
+/// time (approach leg included) wins.
+Trajectory plan_scan(const ScanSpec& spec, double from_pan, double from_tilt);
+
+} // namespace bcc950
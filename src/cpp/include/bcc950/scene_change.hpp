@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "constants.hpp"
+#include "frame.hpp"
+
+namespace bcc950 {
+
+/// Compact perceptual signature of a frame's luma.
+struct SceneSignature {
+    static constexpr int GRID = 8;
+
+    /// Mean luma of each cell of an 8x8 grid, row-major.
+    std::array<uint8_t, GRID * GRID> blocks{};
+    /// dHash: bit (8 * row + col) is set where cell col of a 9x8 grid is
+    /// brighter than cell col + 1, so it survives exposure changes.
+    uint64_t dhash = 0;
+};
+
+/// Signature of a grayscale image. Cells are area averages over column
+/// sums accumulated with SSE2 or NEON where available. Images smaller
+/// than the grid repeat pixels. Throws std::invalid_argument for a
+/// color or empty image.
+SceneSignature scene_signature(const Image& gray);
+
+/// Signature of a frame from its 1/scale luma, decoded in the IDCT (and
+/// cached on the frame). Throws JpegError.
+SceneSignature scene_signature(const Frame& frame, int scale = SCENE_THUMB_SCALE);
+
+/// Number of differing dHash bits (0..64).
+int hash_distance(const SceneSignature& a, const SceneSignature& b);
+
+/// Mean absolute difference of the block means (0..255).
+double block_distance(const SceneSignature& a, const SceneSignature& b);
+
+/// Why a detection pass should (or should not) run.
+enum class SceneTrigger {
+    None,         // scene unchanged since the last pass
+    First,        // no pass yet
+    Changed,      // signature moved past a threshold
+    Settled,      // first settled frame after camera motion
+    Timeout,      // max_interval elapsed
+    NoSignature,  // frame could not be decoded; fail open
+};
+
+/// SceneChangeDetector tuning.
+struct SceneChangeConfig {
+    int    hash_threshold  = SCENE_HASH_THRESHOLD;   // dHash bits
+    double block_threshold = SCENE_BLOCK_THRESHOLD;  // mean luma levels
+    double max_interval    = SCENE_MAX_INTERVAL;     // seconds between forced passes
+    int    thumb_scale     = SCENE_THUMB_SCALE;
+};
+
+/// Outcome of SceneChangeDetector::update().
+struct SceneDecision {
+    bool         run     = false;
+    SceneTrigger trigger = SceneTrigger::None;
+    int          hash_distance  = 0;    // against the last pass's frame
+    double       block_distance = 0.0;
+};
+
+/// Gates an expensive per-frame pass (object detection) on scene change.
+///
+/// Each frame is compared with the frame the last pass ran on, not the
+/// previous frame, so slow drift still adds up to a change. A pass is
+/// due when the dHash or block means moved past their thresholds, on
+/// the first settled frame after the head moved, or when max_interval
+/// has passed. Frames captured while the head moves only run on the
+/// timeout: their motion blur is not worth detecting on, and the
+/// Settled pass follows once the head stops.
+///
+/// Not thread-safe; keep one per consumer.
+class SceneChangeDetector {
+public:
+    explicit SceneChangeDetector(const SceneChangeConfig& config = SceneChangeConfig{});
+
+    /// Decide for `frame`. When the decision is to run, the frame
+    /// becomes the new reference.
+    SceneDecision update(const Frame& frame);
+
+    /// Same, for a signature computed elsewhere.
+    SceneDecision update(const SceneSignature& signature, double timestamp, bool settled);
+
+    /// Forget the reference; the next frame runs as First.
+    void reset();
+
+    uint64_t frames() const { return frames_; }
+    uint64_t runs() const { return runs_; }
+    const SceneChangeConfig& config() const { return config_; }
+
+private:
+    SceneChangeConfig config_;
+    SceneSignature    reference_;
+    double            last_run_ = 0.0;
+    bool              have_reference_ = false;
+    bool              moved_ = false;
+    uint64_t          frames_ = 0;
+    uint64_t          runs_ = 0;
+
+    SceneDecision ran(SceneDecision decision, const SceneSignature* signature, double timestamp);
+};
+
+} // namespace bcc950
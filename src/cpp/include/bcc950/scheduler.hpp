@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "constants.hpp"
+#include "motion.hpp"
+#include "scan_planner.hpp"
+
+namespace bcc950 {
+
+/// Command sources in priority order, highest first. A source preempts
+/// every source listed after it.
+enum class CommandSource : std::size_t {
+    Operator = 0,   // joystick / UI, always wins
+    Tracker  = 1,   // auto-tracking target updates
+    Tour     = 2,   // patrol tour legs
+    Idle     = 3,   // idle animations, homing
+};
+
+constexpr std::size_t COMMAND_SOURCE_COUNT = 4;
+
+/// Returns true if commands from `a` preempt a running command from `b`.
+constexpr bool preempts(CommandSource a, CommandSource b) {
+    return static_cast<std::size_t>(a) < static_cast<std::size_t>(b);
+}
+
+/// A single queued motion command.
+struct MotionCommand {
+    enum class Type { Move, Velocity, Zoom, Stop, Home, Trajectory };
+
+    Type   type     = Type::Move;
+    int    pan_dir  = 0;
+    int    tilt_dir = 0;
+    int    zoom     = ZOOM_MIN;
+    double duration = DEFAULT_MOVE_DURATION;
+    std::shared_ptr<const Trajectory> trajectory;
+
+    static MotionCommand move(int pan_dir, int tilt_dir,
+                              double duration = DEFAULT_MOVE_DURATION);
+    /// Continuous velocity setpoint; see MotionController::set_velocity().
+    static MotionCommand velocity(int pan_dir, int tilt_dir);
+    static MotionCommand zoom_to(int value);
+    static MotionCommand stop();
+    /// Re-home against the hard stops; see MotionController::home().
+    static MotionCommand home();
+    /// Run a planned path; see MotionController::run_trajectory().
+    static MotionCommand follow(Trajectory trajectory);
+};
+
+/// Per-source queueing policy.
+struct SourcePolicy {
+    /// Longest a command may wait in the queue before it is late.
+    std::chrono::milliseconds latency_budget{100};
+    /// Maximum pending commands kept; the oldest is dropped on overflow.
+    std::size_t max_queue = 16;
+    /// Newest pending command replaces any older pending ones.
+    bool coalesce = false;
+    /// Discard (rather than run) commands that exceeded their budget.
+    bool drop_stale = false;
+};
+
+/// Per-source counters, for tuning latency budgets.
+struct SourceStats {
+    uint64_t submitted     = 0;
+    uint64_t executed      = 0;
+    uint64_t coalesced     = 0;  // replaced by a newer command
+    uint64_t paced         = 0;  // replaced while the device was backlogged
+    uint64_t preempted     = 0;  // cut short by a higher-priority source
+    uint64_t expired       = 0;  // dropped after exceeding the budget
+    uint64_t overflowed    = 0;  // dropped because the queue was full
+    uint64_t budget_misses = 0;  // dispatched later than the budget
+    uint64_t failed        = 0;  // device error while executing
+    double   max_wait_ms   = 0.0;
+    double   total_wait_ms = 0.0;
+
+    /// Mean queue wait of executed commands.
+    double mean_wait_ms() const {
+        return executed ? total_wait_ms / static_cast<double>(executed) : 0.0;
+    }
+};
+
+/// Default policy for a source: tight, coalescing budgets for
+/// interactive sources, deep queues for tours.
+SourcePolicy default_policy(CommandSource source);
+
+/// Priority-aware front end for MotionController.
+///
+/// Holds one queue per CommandSource and a worker thread that always
+/// dispatches from the highest-priority non-empty queue. Submitting a
+/// command from a higher-priority source cancels the running command
+/// of a lower-priority source, so an operator "stop" never waits out a
+/// multi-second tour leg.
+class CommandScheduler {
+public:
+    /// Construct in front of `motion` (non-owning) and start the worker.
+    explicit CommandScheduler(MotionController& motion);
+
+    /// Stops the worker; pending commands are discarded.
+    ~CommandScheduler();
+
+    CommandScheduler(const CommandScheduler&) = delete;
+    CommandScheduler& operator=(const CommandScheduler&) = delete;
+
+    /// Replace the policy for a source.
+    void set_policy(CommandSource source, const SourcePolicy& policy);
+    SourcePolicy policy(CommandSource source) const;
+
+    /// Queue a command. Returns false if it was rejected (scheduler
+    /// shut down). A Stop command also clears the queues of its own
+    /// and every lower-priority source.
+    bool submit(CommandSource source, const MotionCommand& command);
+
+    /// Device backpressure, e.g. ControlPacer::backlog(). While it
+    /// reports a positive backlog, each source keeps only its newest
+    /// pending command, as if its policy coalesced. Empty removes it.
+    void set_backpressure(std::function<double()> backlog);
+
+    /// Discard pending commands of one source.
+    void clear(CommandSource source);
+
+    /// Block until all queues are empty and no command is running.
+    void wait_idle();
+
+    /// Source of the command currently executing, if any.
+    std::optional<CommandSource> running() const;
+
+    /// Counters for one source.
+    SourceStats stats(CommandSource source) const;
+
+    /// Stop the worker thread. Idempotent.
+    void shutdown();
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Pending {
+        MotionCommand     command;
+        clock::time_point enqueued;
+    };
+
+    struct Lane {
+        SourcePolicy        policy;
+        std::deque<Pending> queue;
+        SourceStats         stats;
+    };
+
+    MotionController& motion_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::array<Lane, COMMAND_SOURCE_COUNT> lanes_;
+    std::optional<CommandSource> running_;
+    bool running_preempted_ = false;
+    bool shutdown_ = false;
+    std::function<double()> backlog_;
+    std::thread worker_;
+
+    void run();
+    void execute(const MotionCommand& command, uint64_t token);
+    bool queues_empty_locked() const;
+
+    static std::size_t index(CommandSource source) {
+        return static_cast<std::size_t>(source);
+    }
+};
+
+} // namespace bcc950
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace bcc950 {
+
+/// Sequence lock publishing a trivially copyable value.
+///
+/// Readers never block writers: they copy the value and retry if a
+/// write overlapped the copy. The payload lives in atomic words, so
+/// concurrent reads and writes are not a data race. Writers are
+/// serialized among themselves by claiming the odd sequence count.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SeqLock payload must be trivially copyable");
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /// Publish `value`.
+    void store(const T& value) {
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        do {
+            while (seq & 1) {
+                std::this_thread::yield();
+                seq = seq_.load(std::memory_order_relaxed);
+            }
+        } while (!seq_.compare_exchange_weak(seq, seq + 1,
+                                             std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::array<uint64_t, WORDS> buf{};
+        std::memcpy(buf.data(), static_cast<const void*>(&value), sizeof(T));
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// Copy the value unless a write is in progress or overlapped the
+    /// copy. Never blocks.
+    bool try_load(T& out) const {
+        uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::array<uint64_t, WORDS> buf;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&out), buf.data(), sizeof(T));
+        return true;
+    }
+
+    /// Consistent copy of the latest value, retrying past writers.
+    T load() const {
+        T value;
+        while (!try_load(value)) {
+            std::this_thread::yield();
+        }
+        return value;
+    }
+
+    /// Number of completed stores, including the initial one.
+    uint64_t version() const {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + 7) / 8;
+
+    std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace bcc950
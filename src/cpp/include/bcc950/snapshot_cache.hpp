@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "constants.hpp"
+#include "frame.hpp"
+#include "pose_history.hpp"
+
+namespace bcc950 {
+
+/// Mean absolute difference of two equal-length byte arrays (0..255),
+/// vectorized (SSE2 or NEON) where available.
+double mean_abs_diff(const uint8_t* a, const uint8_t* b, std::size_t n);
+
+/// Standard base64 (RFC 4648, padded).
+std::string base64_encode(const uint8_t* data, std::size_t size);
+
+/// Snapshot cache tuning.
+struct SnapshotCacheConfig {
+    double      pan_bucket  = SNAPSHOT_PAN_BUCKET;   // movement-seconds per pose bucket
+    double      tilt_bucket = SNAPSHOT_TILT_BUCKET;
+    double      zoom_bucket = SNAPSHOT_ZOOM_BUCKET;  // zoom units
+    int         thumb_scale = SNAPSHOT_THUMB_SCALE;  // IDCT scale of the comparison image
+    double      max_diff    = SNAPSHOT_MAX_DIFF;     // mean luma difference still "unchanged"
+    double      max_age     = SNAPSHOT_MAX_AGE;      // seconds a snapshot may be reused
+    std::size_t capacity    = SNAPSHOT_CAPACITY;     // pose buckets kept
+};
+
+/// An image ready to send to a vision model.
+struct Snapshot {
+    std::string base64;          // the frame's JPEG, base64-encoded
+    FramePtr    frame;           // the frame it came from
+    bool        cached = false;  // true if reused from an earlier frame
+};
+
+/// Snapshot cache counters.
+struct SnapshotCacheStats {
+    uint64_t hits   = 0;
+    uint64_t misses = 0;
+};
+
+/// Reuses the last base64 JPEG snapshot taken from the same pose while
+/// the scene there has not changed.
+///
+/// Frames are already JPEG from the camera, so a snapshot is the frame's
+/// own bytes, base64-encoded once; nothing is re-encoded. Snapshots are
+/// kept per pose bucket (pan, tilt, zoom quantized). A new frame reuses
+/// its bucket's snapshot if a 1/8-scale luma thumbnail (decoded in the
+/// IDCT) differs from the cached one by at most max_diff on average and
+/// the snapshot is younger than max_age, so an agent polling a still
+/// scene re-sends the same string and provider-side image caches hit.
+/// Only settled frames are cached. Thread-safe.
+class SnapshotCache {
+public:
+    /// `history` (e.g. MotionController::pose_history()), if given,
+    /// places frames in pose buckets and must outlive the cache; without
+    /// it all frames share one bucket.
+    explicit SnapshotCache(const PoseHistory* history = nullptr,
+                           const SnapshotCacheConfig& config = SnapshotCacheConfig{});
+
+    /// Snapshot for `frame`: the cached one if still valid, otherwise
+    /// `frame` encoded (and cached if settled).
+    Snapshot get(const FramePtr& frame);
+
+    void clear();
+    std::size_t size() const;
+    SnapshotCacheStats stats() const;
+    const SnapshotCacheConfig& config() const { return config_; }
+
+private:
+    using Key = std::tuple<long, long, long>;
+
+    struct Entry {
+        Snapshot snapshot;
+        ImagePtr thumbnail;
+        uint64_t last_used = 0;
+    };
+
+    const PoseHistory*  history_;
+    SnapshotCacheConfig config_;
+
+    mutable std::mutex   mutex_;
+    std::map<Key, Entry> entries_;
+    uint64_t             clock_ = 0;
+    SnapshotCacheStats   stats_;
+
+    Key key_for(const Frame& frame) const;
+};
+
+} // namespace bcc950
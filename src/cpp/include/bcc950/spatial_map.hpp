@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+namespace bcc950 {
+
+/// One observation stored in a SpatialMap.
+struct SpatialEntry {
+    double   timestamp = 0.0;  // caller's clock, e.g. Unix seconds
+    float    pan  = 0.0f;      // exact position, not the cell center
+    float    tilt = 0.0f;
+    uint64_t id   = 0;         // caller's key for the payload (text, crop, ...)
+};
+
+/// Grid geometry for a SpatialMap.
+struct SpatialGridSpec {
+    double   pan_min   = EST_PAN_MIN;
+    double   pan_max   = EST_PAN_MAX;
+    double   tilt_min  = EST_TILT_MIN;
+    double   tilt_max  = EST_TILT_MAX;
+    double   cell_size = SPATIAL_CELL_SIZE;       // movement-seconds per cell
+    uint32_t cell_capacity = SPATIAL_CELL_CAPACITY;  // newest entries kept per cell
+
+    int pan_cells() const;
+    int tilt_cells() const;
+};
+
+/// Observations keyed by quantized pan/tilt.
+///
+/// A dense grid covers the calibrated range; each cell holds a bounded
+/// ring of its newest entries. Lookups index the grid directly, with no
+/// string keys. Optionally backed by an mmap'd file, so the map survives
+/// restarts without a save step.
+class SpatialMap {
+public:
+    /// In-memory map.
+    explicit SpatialMap(const SpatialGridSpec& spec = SpatialGridSpec{});
+
+    /// Map persisted in `path`, created if missing. Throws
+    /// std::runtime_error if the file cannot be mapped or was written
+    /// with a different grid.
+    SpatialMap(const std::string& path, const SpatialGridSpec& spec = SpatialGridSpec{});
+
+    ~SpatialMap();
+
+    SpatialMap(const SpatialMap&) = delete;
+    SpatialMap& operator=(const SpatialMap&) = delete;
+
+    /// Store an observation. Positions outside the grid land in the
+    /// nearest edge cell. Evicts the cell's oldest entry when full.
+    void insert(double pan, double tilt, uint64_t id, double timestamp);
+
+    /// Entries within `radius` movement-seconds of (pan, tilt) and no
+    /// older than `since`, newest first.
+    std::vector<SpatialEntry> query(
+        double pan, double tilt, double radius,
+        double since = -std::numeric_limits<double>::infinity()) const;
+
+    /// Newest entry of each cell within `radius`, newest first.
+    std::vector<SpatialEntry> latest_per_cell(
+        double pan, double tilt, double radius,
+        double since = -std::numeric_limits<double>::infinity()) const;
+
+    /// Number of stored entries.
+    std::size_t size() const;
+
+    /// Remove every entry.
+    void clear();
+
+    /// Flush a file-backed map to disk. No-op in memory.
+    void sync();
+
+    const SpatialGridSpec& spec() const { return spec_; }
+
+private:
+    struct Header;
+    struct Cell;
+
+    SpatialGridSpec spec_;
+    int         pan_cells_;
+    int         tilt_cells_;
+    std::size_t mapped_bytes_ = 0;
+    void*       mapped_ = nullptr;
+    bool        file_backed_ = false;
+    Header*     header_ = nullptr;
+    Cell*       cells_ = nullptr;
+    SpatialEntry* entries_ = nullptr;
+    mutable std::shared_mutex mutex_;
+
+    std::size_t layout_bytes() const;
+    void map_anonymous();
+    void attach(bool initialize);
+    int  cell_index(double pan, double tilt) const;
+
+    template <typename Visit>
+    void for_each_cell_in(double pan, double tilt, double radius, Visit visit) const;
+};
+
+} // namespace bcc950
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "constants.hpp"
+#include "pose_history.hpp"
+#include "zoom_model.hpp"
+
+namespace bcc950 {
+
+/// One detector box in normalized image coordinates (0..1, y down).
+struct Detection {
+    float x1 = 0.0f;
+    float y1 = 0.0f;
+    float x2 = 0.0f;
+    float y2 = 0.0f;
+    float confidence = 0.0f;
+    int   class_id   = 0;
+
+    float area() const { return (x2 - x1) * (y2 - y1); }
+};
+
+/// World direction in movement-seconds, the units of move_to().
+struct Bearing {
+    double pan  = 0.0;
+    double tilt = 0.0;
+};
+
+/// An object followed across frames.
+struct Track {
+    uint64_t  id = 0;
+    int       class_id = 0;
+    float     confidence = 0.0f;
+    Detection box;                // latest image box
+    Bearing   bearing;            // world bearing of the box center
+    double    width  = 0.0;       // world extent, movement-seconds
+    double    height = 0.0;
+    double    pan_velocity  = 0.0;  // movement-seconds per second
+    double    tilt_velocity = 0.0;
+    double    first_seen = 0.0;
+    double    last_seen  = 0.0;
+    uint32_t  hits = 0;           // frames with a matching detection
+
+    /// Bearing projected to time `t` at the tracked velocity.
+    Bearing predict(double t) const;
+};
+
+/// Tuning for TargetSelector.
+struct TargetSelectorConfig {
+    double    min_iou      = TRACK_MIN_IOU;    // association gate
+    double    max_age      = TRACK_MAX_AGE;    // seconds unseen before a track is dropped
+    int       target_class = TRACK_TARGET_CLASS;
+    uint32_t  min_hits     = 1;                // frames before a track may be the target
+    ZoomModel optics;
+};
+
+/// Turns batches of detector boxes into persistent world-space tracks
+/// and picks the one the camera should follow.
+///
+/// Each box is projected to pan/tilt through the camera pose at the
+/// frame's capture time, so tracks stay put while the camera moves.
+/// Boxes are matched to tracks by world-space IoU with an optimal
+/// (Hungarian) assignment. The target is the largest confirmed track of
+/// the target class, kept until it is lost so the camera does not hop
+/// between people. Thread-safe: detection and motion threads may share
+/// one selector.
+class TargetSelector {
+public:
+    /// `history` (e.g. MotionController::pose_history()) must outlive
+    /// the selector.
+    explicit TargetSelector(const PoseHistory& history,
+                            const TargetSelectorConfig& config = TargetSelectorConfig{});
+
+    /// Feed one frame's detections, captured at `timestamp`
+    /// (PoseHistory::now() clock). Returns false, changing nothing, if
+    /// the pose at that time is no longer known.
+    bool update(const std::vector<Detection>& detections, double timestamp);
+
+    /// Live tracks, oldest first.
+    std::vector<Track> tracks() const;
+
+    /// The track being followed, if any.
+    std::optional<Track> target() const;
+
+    /// Where to point the camera at time `t`: the target's bearing
+    /// projected forward by its velocity, for at most max_age seconds.
+    std::optional<Bearing> target_bearing(double t) const;
+
+    /// Forget all tracks and the target.
+    void clear();
+
+    void set_config(const TargetSelectorConfig& config);
+    TargetSelectorConfig config() const;
+
+private:
+    const PoseHistory& history_;
+
+    mutable std::mutex   mutex_;
+    TargetSelectorConfig config_;
+    std::vector<Track>   tracks_;
+    uint64_t             next_id_ = 1;
+    uint64_t             target_id_ = 0;  // zero: no target
+
+    /// Live track with `id`, or nullptr. Caller must hold mutex_.
+    const Track* find_locked(uint64_t id) const;
+
+    /// Keep the current target if alive, else pick among the tracks
+    /// seen at `timestamp`. Caller must hold mutex_.
+    void select_target_locked(double timestamp);
+};
+
+} // namespace bcc950
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+#include "frame_motion.hpp"
+#include "frame_source.hpp"
+
+namespace bcc950 {
+
+class PoseHistory;
+
+/// Requested stream format. The driver may adjust width and height to
+/// the nearest mode it supports; V4L2Capture reports what it got.
+struct CaptureFormat {
+    int width   = CAPTURE_WIDTH;
+    int height  = CAPTURE_HEIGHT;
+    int fps     = CAPTURE_FPS;
+    int buffers = CAPTURE_BUFFERS;  // mmap'd driver buffers
+};
+
+/// MJPEG passthrough capture from a V4L2 video node.
+///
+/// Streams V4L2_PIX_FMT_MJPEG through mmap'd buffers and hands each
+/// frame out still compressed, so nothing is decoded unless a consumer
+/// asks for pixels. Opens its own descriptor; the control device can
+/// stay open on the same node.
+class V4L2Capture : public FrameSource {
+public:
+    V4L2Capture() = default;
+
+    /// Open and start streaming. Throws V4L2Error on failure.
+    explicit V4L2Capture(const std::string& device,
+                         const CaptureFormat& format = CaptureFormat{});
+
+    ~V4L2Capture() override;
+
+    V4L2Capture(const V4L2Capture&) = delete;
+    V4L2Capture& operator=(const V4L2Capture&) = delete;
+
+    /// Open `device`, negotiate MJPEG and start streaming. Throws
+    /// V4L2Error if the node cannot stream MJPEG.
+    void open(const std::string& device,
+              const CaptureFormat& format = CaptureFormat{});
+
+    /// Stop streaming and release the buffers.
+    void close();
+
+    bool is_open() const;
+
+    /// Dequeue the next frame, copy out its compressed bytes and return
+    /// the buffer to the driver. Frames the driver flags as corrupt are
+    /// skipped.
+    FramePtr read(double timeout) override;
+
+    /// Tag each frame with the head motion during its exposure, read
+    /// from `history` (e.g. MotionController::pose_history(), which must
+    /// outlive the capture). nullptr disables tagging.
+    void set_motion_log(const PoseHistory* history,
+                        const MotionTiming& timing = MotionTiming{});
+
+    /// Negotiated frame size.
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+private:
+    struct Buffer {
+        void*       start  = nullptr;
+        std::size_t length = 0;
+    };
+
+    int fd_ = -1;
+    int width_ = 0;
+    int height_ = 0;
+    bool streaming_ = false;
+    std::vector<Buffer> buffers_;
+    const PoseHistory* motion_log_ = nullptr;
+    MotionTiming       motion_timing_;
+};
+
+} // namespace bcc950
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -14,6 +16,12 @@ public:
     using std::runtime_error::runtime_error;
 };
 
+/// One control write within a batch.
+struct ControlValue {
+    uint32_t id    = 0;
+    int32_t  value = 0;
+};
+
 /// Abstract interface for V4L2 device operations.
 /// Enables dependency injection and test mocking.
 class IV4L2Device {
@@ -23,6 +31,14 @@ public:
     /// Set a V4L2 control to the given value.
     virtual void set_control(uint32_t id, int32_t value) = 0;
 
+    /// Set several controls in one request. The default writes them in
+    /// order with set_control().
+    virtual void set_controls(const ControlValue* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            set_control(values[i].id, values[i].value);
+        }
+    }
+
     /// Get the current value of a V4L2 control.
     virtual int32_t get_control(uint32_t id) = 0;
 
@@ -55,6 +71,11 @@ public:
     V4L2Device& operator=(V4L2Device&& other) noexcept;
 
     void set_control(uint32_t id, int32_t value) override;
+
+    /// One VIDIOC_S_EXT_CTRLS for controls of a single class, falling
+    /// back to set_control() on drivers without extended controls.
+    void set_controls(const ControlValue* values, std::size_t count) override;
+
     int32_t get_control(uint32_t id) override;
     struct v4l2_queryctrl query_control(uint32_t id) override;
 
@@ -68,6 +89,9 @@ public:
 private:
     int fd_ = -1;
     std::string device_path_;
+    // Cleared if S_EXT_CTRLS is unsupported; atomic because the watchdog's
+    // force_stop() writes from its own thread.
+    std::atomic<bool> ext_controls_{true};
 };
 
 } // namespace bcc950
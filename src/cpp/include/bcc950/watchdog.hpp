@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "constants.hpp"
+
+namespace bcc950 {
+
+/// Deadline monitor that forces a stop when a running move overstays.
+///
+/// Every timed move arms a deadline (its duration plus a grace period)
+/// and disarms it after writing its stop. If the mover stalls or dies
+/// in between, the watchdog thread calls `on_expire`. An optional
+/// heartbeat lets an application declare itself alive: while any
+/// deadline is armed, a missed heartbeat also triggers `on_expire`.
+class Watchdog {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// `on_expire` runs on the watchdog thread and must not block on the
+    /// lock held by the stalled mover.
+    explicit Watchdog(std::function<void()> on_expire,
+                      double grace = DEFAULT_WATCHDOG_GRACE);
+
+    /// Joins the watchdog thread.
+    ~Watchdog();
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    /// Arm a deadline `seconds` (plus grace) from now. Returns an id for
+    /// disarm().
+    uint64_t arm(double seconds);
+
+    /// Disarm a deadline. Unknown or already-expired ids are ignored.
+    void disarm(uint64_t id);
+
+    /// Record that the application is alive.
+    void heartbeat();
+
+    /// Seconds allowed between heartbeats while a move is armed; zero
+    /// (the default) disables the heartbeat check.
+    void set_heartbeat_timeout(double seconds);
+
+    /// Number of times on_expire has fired.
+    uint64_t expirations() const;
+
+private:
+    std::function<void()> on_expire_;
+    clock::duration grace_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    std::map<uint64_t, clock::time_point> deadlines_;
+    uint64_t          next_id_ = 1;
+    uint64_t          changes_ = 0;
+    clock::duration   heartbeat_timeout_{0};
+    clock::time_point last_heartbeat_;
+    uint64_t          expirations_ = 0;
+    bool              exit_ = false;
+    std::thread       thread_;
+
+    void run();
+
+    /// Start the thread on first use. Caller must hold mutex_.
+    void ensure_started_locked();
+};
+
+// --- Process-wide emergency stop ---
+
+/// Register an open V4L2 file descriptor for emergency_stop_all().
+/// V4L2Device does this on open(). Returns false if the table is full.
+bool register_emergency_stop_fd(int fd);
+
+/// Remove a descriptor registered with register_emergency_stop_fd().
+void unregister_emergency_stop_fd(int fd);
+
+/// Write pan_speed = tilt_speed = 0 to every registered device with raw
+/// ioctl() calls. Async-signal-safe.
+void emergency_stop_all();
+
+/// Install SIGINT/SIGTERM handlers that call emergency_stop_all() and
+/// then defer to the previous disposition, and an atexit() hook doing
+/// the same at process teardown. Idempotent. Not installed by default:
+/// embedding runtimes (e.g. Python) often own these signals.
+void install_safety_handlers();
+
+} // namespace bcc950
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace bcc950 {
+
+/// PCM audio as interleaved floats in [-1, 1].
+struct WavAudio {
+    int sample_rate = 0;
+    int channels    = 0;
+    std::vector<float> samples;  // frames * channels, interleaved
+
+    std::size_t frames() const {
+        return channels > 0 ? samples.size() / static_cast<std::size_t>(channels) : 0;
+    }
+};
+
+/// Read a RIFF/WAVE file: 8, 16, 24 or 32-bit integer PCM or 32-bit
+/// float, including WAVE_FORMAT_EXTENSIBLE headers. Throws
+/// std::runtime_error on I/O errors and unsupported encodings.
+WavAudio read_wav(const std::string& path);
+
+/// Write 16-bit PCM, clipping samples to [-1, 1]. Throws
+/// std::runtime_error on I/O errors.
+void write_wav(const std::string& path, const WavAudio& audio);
+
+} // namespace bcc950
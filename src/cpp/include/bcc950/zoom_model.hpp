@@ -0,0 +1,46 @@
+#pragma once
+
+#include "constants.hpp"
+#include "position.hpp"
+
+namespace bcc950 {
+
+/// Zoom lens slew and field-of-view model.
+///
+/// CTRL_ZOOM_ABSOLUTE returns at once but the lens takes time to get
+/// there. The model predicts where the lens is during a slew, and how
+/// much of the field of view a movement-second covers at a given zoom,
+/// so pan/tilt can be expressed in fields of view independent of zoom.
+struct ZoomModel {
+    double slew_rate    = ZOOM_SLEW_RATE;     // zoom units per second
+    double slew_latency = ZOOM_SLEW_LATENCY;  // seconds before the lens moves
+    double hfov_wide    = FOV_H_WIDE;         // degrees at ZOOM_MIN
+    double vfov_wide    = FOV_V_WIDE;
+    double pan_rate     = PAN_DEG_PER_SEC;    // degrees per movement-second
+    double tilt_rate    = TILT_DEG_PER_SEC;
+
+    /// Seconds for the lens to travel from `from` to `to`. Zero if equal.
+    double slew_time(double from, double to) const;
+
+    /// Lens position `elapsed` seconds into a slew from `from` to `to`.
+    double zoom_at(double from, double to, double elapsed) const;
+
+    /// Optical magnification relative to ZOOM_MIN.
+    double magnification(double zoom) const;
+
+    /// Field of view along `axis`, in degrees.
+    double fov(Axis axis, double zoom) const;
+
+    /// Fields of view per second covered at full speed along `axis`.
+    double fov_rate(Axis axis, double zoom) const;
+
+    /// Movement-seconds that shift the image by `fovs` fields of view.
+    double movement_seconds(Axis axis, double fovs, double zoom) const;
+
+    /// Movement-seconds from the optical axis to an image point `offset`
+    /// frame-widths (or heights) from the center, -0.5 .. 0.5. Exact for
+    /// a rectilinear lens, unlike scaling movement_seconds().
+    double bearing_offset(Axis axis, double offset, double zoom) const;
+};
+
+} // namespace bcc950
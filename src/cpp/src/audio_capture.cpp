@@ -0,0 +1,264 @@
+#include "bcc950/audio_capture.hpp"
+#include "bcc950/pose_history.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#ifdef BCC950_HAVE_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace bcc950 {
+
+namespace {
+
+// Segments kept for a slow consumer before the oldest is dropped.
+constexpr std::size_t SEGMENT_QUEUE_LIMIT = 16;
+
+} // anonymous namespace
+
+// --- AudioRing ---
+
+AudioRing::AudioRing(int sample_rate, int channels, double seconds)
+    : sample_rate_(sample_rate),
+      channels_(std::max(channels, 1)),
+      capacity_(std::max<std::size_t>(1, static_cast<std::size_t>(
+          std::ceil(std::max(seconds, 0.0) * sample_rate)))),
+      data_(capacity_ * channels_, 0.0f) {}
+
+void AudioRing::write(const float* interleaved, std::size_t frames, double timestamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stamp_index_ = written_;
+    stamp_time_ = timestamp;
+
+    // Only the newest capacity_ frames can survive.
+    if (frames > capacity_) {
+        interleaved += (frames - capacity_) * channels_;
+        written_ += frames - capacity_;
+        frames = capacity_;
+    }
+    std::size_t pos = written_ % capacity_;
+    std::size_t first = std::min(frames, capacity_ - pos);
+    std::copy(interleaved, interleaved + first * channels_,
+              data_.begin() + pos * channels_);
+    std::copy(interleaved + first * channels_, interleaved + frames * channels_,
+              data_.begin());
+    written_ += frames;
+}
+
+std::optional<double> AudioRing::latest(std::size_t frames, std::vector<float>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frames == 0 || frames > capacity_ || frames > written_) {
+        return std::nullopt;
+    }
+    uint64_t begin = written_ - frames;
+    out.resize(frames * channels_);
+    std::size_t pos = begin % capacity_;
+    std::size_t first = std::min(frames, capacity_ - pos);
+    std::copy(data_.begin() + pos * channels_,
+              data_.begin() + (pos + first) * channels_, out.begin());
+    std::copy(data_.begin(), data_.begin() + (frames - first) * channels_,
+              out.begin() + first * channels_);
+    double offset = static_cast<double>(static_cast<int64_t>(begin - stamp_index_));
+    return stamp_time_ + offset / sample_rate_;
+}
+
+uint64_t AudioRing::frames_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+// --- AudioCapture ---
+
+AudioCapture::AudioCapture(const AudioFormat& format, const VadConfig& vad)
+    : format_(format),
+      ring_(format.sample_rate, format.channels, format.ring_seconds),
+      vad_(format.sample_rate, vad) {}
+
+AudioCapture::~AudioCapture() {
+    stop();
+}
+
+bool AudioCapture::supported() {
+#ifdef BCC950_HAVE_ALSA
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AudioCapture::running() const {
+    return running_;
+}
+
+std::string AudioCapture::last_error() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return last_error_;
+}
+
+void AudioCapture::feed(const float* interleaved, std::size_t frames, double timestamp) {
+    ring_.write(interleaved, frames, timestamp);
+
+    std::vector<SpeechSegment> done;
+    {
+        std::lock_guard<std::mutex> lock(vad_mutex_);
+        const float* mono = interleaved;
+        const int channels = ring_.channels();
+        if (channels > 1) {
+            mono_.resize(frames);
+            for (std::size_t i = 0; i < frames; ++i) {
+                float sum = 0.0f;
+                for (int c = 0; c < channels; ++c) {
+                    sum += interleaved[i * channels + c];
+                }
+                mono_[i] = sum / channels;
+            }
+            mono = mono_.data();
+        }
+        done = vad_.process(mono, frames, timestamp);
+    }
+    if (done.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        for (SpeechSegment& s : done) {
+            queue_.push_back(std::move(s));
+        }
+        while (queue_.size() > SEGMENT_QUEUE_LIMIT) {
+            queue_.pop_front();
+            ++dropped_;
+        }
+    }
+    queue_cv_.notify_all();
+}
+
+std::optional<SpeechSegment> AudioCapture::next_segment(double timeout) {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    // A capture failure wakes waiters early so they can check running().
+    queue_cv_.wait_for(lock, std::chrono::duration<double>(timeout),
+                       [this] { return !queue_.empty() || failed_; });
+    if (queue_.empty()) {
+        return std::nullopt;
+    }
+    SpeechSegment s = std::move(queue_.front());
+    queue_.pop_front();
+    return s;
+}
+
+uint64_t AudioCapture::dropped_segments() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return dropped_;
+}
+
+#ifdef BCC950_HAVE_ALSA
+
+void AudioCapture::start() {
+    if (running()) {
+        return;
+    }
+    stop();  // reap a thread that died on a device error
+    snd_pcm_t* pcm = nullptr;
+    int err = snd_pcm_open(&pcm, format_.device.c_str(), SND_PCM_STREAM_CAPTURE, 0);
+    if (err < 0) {
+        throw std::runtime_error("Failed to open audio device " + format_.device +
+                                 ": " + snd_strerror(err));
+    }
+    // Latency of a few periods; ALSA resamples if the rate is not native.
+    unsigned int latency_us = static_cast<unsigned int>(format_.period_seconds * 4e6);
+    err = snd_pcm_set_params(pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED,
+                             static_cast<unsigned int>(format_.channels),
+                             static_cast<unsigned int>(format_.sample_rate),
+                             1, latency_us);
+    if (err < 0) {
+        snd_pcm_close(pcm);
+        throw std::runtime_error("Failed to configure audio device " + format_.device +
+                                 ": " + snd_strerror(err));
+    }
+    pcm_ = pcm;
+    exit_ = false;
+    failed_ = false;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        last_error_.clear();
+    }
+    running_ = true;
+    thread_ = std::thread(&AudioCapture::run, this);
+}
+
+void AudioCapture::run() {
+    auto* pcm = static_cast<snd_pcm_t*>(pcm_);
+    const int channels = format_.channels;
+    const auto period = static_cast<snd_pcm_uframes_t>(
+        std::max(1L, std::lround(format_.period_seconds * format_.sample_rate)));
+    std::vector<int16_t> raw(period * channels);
+    std::vector<float> samples(period * channels);
+
+    while (!exit_) {
+        snd_pcm_sframes_t n = snd_pcm_readi(pcm, raw.data(), period);
+        if (n < 0) {
+            if (n == -EPIPE) {
+                ++overruns_;
+            }
+            int err = snd_pcm_recover(pcm, static_cast<int>(n), 1);
+            if (err < 0) {
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex_);
+                    last_error_ = "Audio capture from " + format_.device +
+                                  " failed: " + snd_strerror(err);
+                }
+                failed_ = true;
+                running_ = false;
+                queue_cv_.notify_all();
+                break;
+            }
+            continue;
+        }
+        // The last frame read was captured `delay` frames ago.
+        snd_pcm_sframes_t delay = 0;
+        if (snd_pcm_delay(pcm, &delay) < 0) {
+            delay = 0;
+        }
+        double end = PoseHistory::now() - static_cast<double>(delay) / format_.sample_rate;
+        double first = end - static_cast<double>(n) / format_.sample_rate;
+
+        const std::size_t count = static_cast<std::size_t>(n) * channels;
+        for (std::size_t i = 0; i < count; ++i) {
+            samples[i] = raw[i] * (1.0f / 32768.0f);
+        }
+        feed(samples.data(), static_cast<std::size_t>(n), first);
+    }
+}
+
+void AudioCapture::stop() {
+    exit_ = true;
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (pcm_) {
+        snd_pcm_close(static_cast<snd_pcm_t*>(pcm_));
+        pcm_ = nullptr;
+    }
+}
+
+#else
+
+void AudioCapture::start() {
+    throw std::runtime_error("libbcc950 was built without ALSA support");
+}
+
+void AudioCapture::run() {}
+
+void AudioCapture::stop() {
+    exit_ = true;
+}
+
+#endif
+
+} // namespace bcc950
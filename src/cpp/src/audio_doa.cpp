@@ -0,0 +1,198 @@
+#include "bcc950/audio_doa.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace bcc950 {
+
+namespace {
+
+using cfloat = std::complex<float>;
+
+std::size_t next_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/// In-place iterative radix-2 FFT of `n` points (a power of two). The
+/// `twiddles` table holds exp(-2*pi*i*k/M) for k < M/2, for any M that
+/// is a multiple of n. Unnormalized; `inverse` conjugates the twiddles.
+/// Complex products are spelled out so the butterflies stay inline and
+/// vectorizable.
+void fft(cfloat* x, std::size_t n, const std::vector<cfloat>& twiddles, bool inverse) {
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(x[i], x[j]);
+        }
+    }
+    const float sign = inverse ? -1.0f : 1.0f;
+    const std::size_t table = twiddles.size() * 2;
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+        const std::size_t half = len / 2;
+        const std::size_t step = table / len;
+        for (std::size_t i = 0; i < n; i += len) {
+            cfloat* a = x + i;
+            cfloat* b = x + i + half;
+            for (std::size_t k = 0; k < half; ++k) {
+                const float wr = twiddles[k * step].real();
+                const float wi = sign * twiddles[k * step].imag();
+                const float br = b[k].real();
+                const float bi = b[k].imag();
+                const cfloat v(br * wr - bi * wi, br * wi + bi * wr);
+                b[k] = a[k] - v;
+                a[k] = a[k] + v;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+DoaEstimator::DoaEstimator(int sample_rate, const DoaConfig& config)
+    : sample_rate_(sample_rate), config_(config) {
+    config_.interpolation = std::max(1, config_.interpolation);
+    window_ = std::max<std::size_t>(2, static_cast<std::size_t>(
+        std::lround(std::max(config_.window_seconds, 0.0) * sample_rate)));
+    // Pad so the correlation does not wrap within the searched lags.
+    auto max_lag = static_cast<std::size_t>(std::ceil(max_delay() * sample_rate));
+    fft_size_ = next_pow2(window_ + max_lag + 1);
+    ifft_size_ = fft_size_ * next_pow2(static_cast<std::size_t>(config_.interpolation));
+
+    twiddles_.resize(ifft_size_ / 2);
+    for (std::size_t k = 0; k < twiddles_.size(); ++k) {
+        double phase = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(ifft_size_);
+        twiddles_[k] = cfloat(static_cast<float>(std::cos(phase)),
+                              static_cast<float>(std::sin(phase)));
+    }
+    spectrum_.resize(fft_size_);
+    cross_.resize(ifft_size_);
+}
+
+double DoaEstimator::max_delay() const {
+    return config_.speed_of_sound > 0.0
+        ? std::abs(config_.mic_spacing) / config_.speed_of_sound
+        : 0.0;
+}
+
+std::optional<DoaEstimate> DoaEstimator::estimate(const float* interleaved,
+                                                  std::size_t frames, int channels,
+                                                  double timestamp) {
+    const int left = config_.left_channel;
+    const int right = config_.right_channel;
+    if (frames < window_ || left < 0 || right < 0 || left >= channels ||
+        right >= channels || left == right) {
+        return std::nullopt;
+    }
+
+    // Pack right + i*left so one complex FFT transforms both channels.
+    double sum_l = 0.0;
+    double sum_r = 0.0;
+    for (std::size_t t = 0; t < window_; ++t) {
+        const float r = interleaved[t * channels + right];
+        const float l = interleaved[t * channels + left];
+        spectrum_[t] = cfloat(r, l);
+        sum_r += static_cast<double>(r) * r;
+        sum_l += static_cast<double>(l) * l;
+    }
+    std::fill(spectrum_.begin() + static_cast<std::ptrdiff_t>(window_), spectrum_.end(),
+              cfloat{});
+    const double rms = std::sqrt(std::max(sum_l, sum_r) / static_cast<double>(window_));
+    if (rms < config_.min_rms) {
+        return std::nullopt;
+    }
+    fft(spectrum_.data(), fft_size_, twiddles_, false);
+
+    // Whitened cross spectrum conj(R) * L, upsampled by zero-padding the
+    // high bins. DC and Nyquist carry no usable phase and are left out.
+    std::fill(cross_.begin(), cross_.end(), cfloat{});
+    const std::size_t n = fft_size_;
+    std::size_t bins = 0;
+    for (std::size_t k = 1; k < n / 2; ++k) {
+        const cfloat zk = spectrum_[k];
+        const cfloat zn = std::conj(spectrum_[n - k]);
+        const cfloat r = 0.5f * (zk + zn);
+        const cfloat l = cfloat(0.0f, -0.5f) * (zk - zn);
+        const cfloat g = std::conj(r) * l;
+        const float mag = std::abs(g);
+        if (!(mag > 1e-20f)) {
+            continue;
+        }
+        const cfloat w = g / mag;
+        cross_[k] = w;
+        cross_[ifft_size_ - k] = std::conj(w);
+        bins += 2;
+    }
+    if (bins == 0) {
+        return std::nullopt;
+    }
+    fft(cross_.data(), ifft_size_, twiddles_, true);
+
+    // Peak within the physically possible lags.
+    const auto interp = static_cast<double>(ifft_size_ / fft_size_);
+    const auto limit = std::min<long>(
+        static_cast<long>(std::ceil(max_delay() * sample_rate_ * interp)) + 1,
+        static_cast<long>(ifft_size_ / 2) - 1);
+    const long m_size = static_cast<long>(ifft_size_);
+    auto at = [&](long m) { return cross_[static_cast<std::size_t>((m + m_size) % m_size)].real(); };
+    long best = 0;
+    float peak = at(0);
+    for (long m = -limit; m <= limit; ++m) {
+        if (at(m) > peak) {
+            peak = at(m);
+            best = m;
+        }
+    }
+    // Parabolic refinement between neighboring lags.
+    double frac = 0.0;
+    const float y0 = at(best - 1);
+    const float y2 = at(best + 1);
+    const float denom = y0 - 2.0f * peak + y2;
+    if (denom < 0.0f) {
+        frac = std::clamp(0.5 * (y0 - y2) / denom, -0.5, 0.5);
+    }
+
+    DoaEstimate e;
+    e.timestamp = timestamp + 0.5 * static_cast<double>(window_) / sample_rate_;
+    e.delay = (static_cast<double>(best) + frac) / (interp * sample_rate_);
+    e.strength = static_cast<double>(peak) / static_cast<double>(bins);
+    if (e.strength < config_.min_strength) {
+        return std::nullopt;
+    }
+    const double max = max_delay();
+    const double ratio = max > 0.0 ? std::clamp(e.delay / max, -1.0, 1.0) : 0.0;
+    e.azimuth = std::asin(ratio) * 180.0 / M_PI;
+    return e;
+}
+
+std::optional<DoaEstimate> DoaEstimator::estimate(const AudioRing& ring) {
+    std::optional<double> first = ring.latest(window_, ring_buf_);
+    if (!first) {
+        return std::nullopt;
+    }
+    return estimate(ring_buf_.data(), window_, ring.channels(), *first);
+}
+
+std::optional<Bearing> speaker_bearing(const PoseHistory& history,
+                                       const DoaEstimate& estimate,
+                                       const DoaConfig& config,
+                                       const ZoomModel& optics) {
+    std::optional<PoseSample> pose = history.pose_at(estimate.timestamp);
+    if (!pose || optics.pan_rate <= 0.0) {
+        return std::nullopt;
+    }
+    Bearing b;
+    b.pan = config.pan_offset + estimate.azimuth / optics.pan_rate;
+    b.tilt = pose->tilt;
+    return b;
+}
+
+} // namespace bcc950
@@ -0,0 +1,187 @@
+#include "bcc950/audio_vad.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace bcc950 {
+
+namespace {
+
+std::size_t samples_for(double seconds, int sample_rate) {
+    return static_cast<std::size_t>(std::lround(std::max(seconds, 0.0) * sample_rate));
+}
+
+} // anonymous namespace
+
+// --- Block statistics ---
+
+BlockStats block_stats(const float* samples, std::size_t n) {
+    if (n == 0) {
+        return BlockStats{};
+    }
+    std::size_t i = 0;
+    float peak = 0.0f;
+    double sum_sq = 0.0;
+
+#if defined(__SSE2__)
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 vpeak = _mm_setzero_ps();
+    __m128 vsum = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(samples + i);
+        vpeak = _mm_max_ps(vpeak, _mm_andnot_ps(sign, x));
+        vsum = _mm_add_ps(vsum, _mm_mul_ps(x, x));
+    }
+    alignas(16) float lanes_peak[4];
+    alignas(16) float lanes_sum[4];
+    _mm_store_ps(lanes_peak, vpeak);
+    _mm_store_ps(lanes_sum, vsum);
+    for (int k = 0; k < 4; ++k) {
+        peak = std::max(peak, lanes_peak[k]);
+        sum_sq += lanes_sum[k];
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t vpeak = vdupq_n_f32(0.0f);
+    float32x4_t vsum = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t x = vld1q_f32(samples + i);
+        vpeak = vmaxq_f32(vpeak, vabsq_f32(x));
+        vsum = vmlaq_f32(vsum, x, x);
+    }
+    float lanes_peak[4];
+    float lanes_sum[4];
+    vst1q_f32(lanes_peak, vpeak);
+    vst1q_f32(lanes_sum, vsum);
+    for (int k = 0; k < 4; ++k) {
+        peak = std::max(peak, lanes_peak[k]);
+        sum_sq += lanes_sum[k];
+    }
+#endif
+
+    for (; i < n; ++i) {
+        float x = samples[i];
+        peak = std::max(peak, std::abs(x));
+        sum_sq += static_cast<double>(x) * x;
+    }
+    return BlockStats{peak, static_cast<float>(std::sqrt(sum_sq / static_cast<double>(n)))};
+}
+
+// --- VoiceActivityDetector ---
+
+VoiceActivityDetector::VoiceActivityDetector(int sample_rate, const VadConfig& config)
+    : sample_rate_(sample_rate), config_(config) {
+    block_size_ = std::max<std::size_t>(1, samples_for(config.block_seconds, sample_rate));
+    auto blocks = [&](double seconds) {
+        return static_cast<std::size_t>(
+            std::ceil(std::max(seconds, 0.0) * sample_rate / block_size_));
+    };
+    onset_blocks_ = std::max<std::size_t>(1, blocks(config.onset_seconds));
+    hangover_blocks_ = std::max<std::size_t>(1, blocks(config.hangover_seconds));
+    pre_roll_size_ = samples_for(config.pre_roll_seconds, sample_rate);
+    max_segment_size_ = std::max(block_size_, samples_for(config.max_segment_seconds, sample_rate));
+    block_.reserve(block_size_);
+    segment_.sample_rate = sample_rate;
+}
+
+std::vector<SpeechSegment> VoiceActivityDetector::process(const float* samples,
+                                                          std::size_t n,
+                                                          double timestamp) {
+    std::vector<SpeechSegment> out;
+    std::size_t i = 0;
+    while (i < n) {
+        if (block_.empty()) {
+            block_start_ = timestamp + static_cast<double>(i) / sample_rate_;
+        }
+        std::size_t take = std::min(n - i, block_size_ - block_.size());
+        block_.insert(block_.end(), samples + i, samples + i + take);
+        i += take;
+        if (block_.size() == block_size_) {
+            handle_block(block_start_, out);
+            block_.clear();
+        }
+    }
+    return out;
+}
+
+std::vector<SpeechSegment> VoiceActivityDetector::flush() {
+    std::vector<SpeechSegment> out;
+    if (in_speech_) {
+        segment_.samples.insert(segment_.samples.end(), block_.begin(), block_.end());
+        segment_.end += static_cast<double>(block_.size()) / sample_rate_;
+        close_segment(out);
+    }
+    block_.clear();
+    pre_roll_.clear();
+    onset_run_ = 0;
+    return out;
+}
+
+void VoiceActivityDetector::handle_block(double start, std::vector<SpeechSegment>& out) {
+    last_block_ = block_stats(block_.data(), block_.size());
+    const bool speech = last_block_.peak >= config_.peak_threshold &&
+                        last_block_.rms >= config_.rms_threshold;
+    const double end = start + static_cast<double>(block_.size()) / sample_rate_;
+
+    if (!in_speech_) {
+        pre_roll_.insert(pre_roll_.end(), block_.begin(), block_.end());
+        pre_roll_end_ = end;
+        onset_run_ = speech ? onset_run_ + 1 : 0;
+
+        if (onset_run_ >= onset_blocks_) {
+            in_speech_ = true;
+            silent_run_ = 0;
+            onset_run_ = 0;
+            segment_.samples.assign(pre_roll_.begin(), pre_roll_.end());
+            segment_.start = pre_roll_end_ -
+                static_cast<double>(pre_roll_.size()) / sample_rate_;
+            segment_.end = end;
+            pre_roll_.clear();
+            return;
+        }
+        // Keep the pre-roll plus any unconfirmed onset blocks.
+        std::size_t keep = pre_roll_size_ + onset_run_ * block_size_;
+        while (pre_roll_.size() > keep) {
+            pre_roll_.pop_front();
+        }
+        return;
+    }
+
+    segment_.samples.insert(segment_.samples.end(), block_.begin(), block_.end());
+    segment_.end = end;
+    silent_run_ = speech ? 0 : silent_run_ + 1;
+
+    if (silent_run_ >= hangover_blocks_) {
+        // Keep at most a pre-roll's worth of the trailing silence.
+        std::size_t silent = silent_run_ * block_size_;
+        std::size_t trim = silent - std::min(silent, pre_roll_size_);
+        trim = std::min(trim, segment_.samples.size());
+        segment_.samples.resize(segment_.samples.size() - trim);
+        segment_.end -= static_cast<double>(trim) / sample_rate_;
+        close_segment(out);
+    } else if (segment_.samples.size() >= max_segment_size_) {
+        // Split a long utterance; speech continues in a new segment.
+        close_segment(out);
+        in_speech_ = true;
+        segment_.start = end;
+        segment_.end = end;
+    }
+}
+
+void VoiceActivityDetector::close_segment(std::vector<SpeechSegment>& out) {
+    if (segment_.duration() >= config_.min_segment_seconds) {
+        out.push_back(std::move(segment_));
+    }
+    segment_ = SpeechSegment{};
+    segment_.sample_rate = sample_rate_;
+    in_speech_ = false;
+    silent_run_ = 0;
+}
+
+} // namespace bcc950
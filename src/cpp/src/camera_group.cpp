@@ -0,0 +1,77 @@
+#include "bcc950/camera_group.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+namespace bcc950 {
+
+bool GroupMoveReport::completed() const {
+    return std::all_of(cameras.begin(), cameras.end(),
+                       [](const GroupMemberTiming& c) { return c.completed; });
+}
+
+GroupMoveReport synchronized_move(const std::vector<GroupMove>& moves, double duration,
+                                  double lead) {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now() + std::chrono::duration_cast<clock::duration>(
+                                          std::chrono::duration<double>(lead));
+    const auto stop = start + std::chrono::duration_cast<clock::duration>(
+                                  std::chrono::duration<double>(duration));
+
+    std::vector<MoveTiming> timings(moves.size());
+    std::vector<char> completed(moves.size(), 0);
+    std::vector<std::exception_ptr> errors(moves.size());
+    std::vector<std::thread> threads;
+    threads.reserve(moves.size());
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        threads.emplace_back([&, i] {
+            try {
+                const GroupMove& m = moves[i];
+                completed[i] = m.camera->move_at(m.pan_dir, m.tilt_dir, duration, start,
+                                                 &timings[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (const auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+    GroupMoveReport report;
+    double first_start = 0.0, last_start = 0.0, first_stop = 0.0, last_stop = 0.0;
+    bool any = false;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        GroupMemberTiming member;
+        member.completed = completed[i];
+        member.clamped = timings[i].clamped;
+        // A move truncated to nothing by the soft limits writes nothing,
+        // so it has no timing to compare.
+        if (member.completed && timings[i].started != clock::time_point{}) {
+            member.start_late = std::chrono::duration<double>(timings[i].started - start).count();
+            member.stop_late  = std::chrono::duration<double>(timings[i].stopped - stop).count();
+            if (!any) {
+                first_start = last_start = member.start_late;
+                first_stop = last_stop = member.stop_late;
+                any = true;
+            }
+            first_start = std::min(first_start, member.start_late);
+            last_start  = std::max(last_start, member.start_late);
+            first_stop  = std::min(first_stop, member.stop_late);
+            last_stop   = std::max(last_stop, member.stop_late);
+        }
+        report.cameras.push_back(member);
+    }
+    report.start_skew = last_start - first_start;
+    report.stop_skew  = last_stop - first_stop;
+    return report;
+}
+
+} // namespace bcc950
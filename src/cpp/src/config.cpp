@@ -37,6 +37,8 @@ void Config::set_defaults() {
     data_["PAN_SPEED"] = std::to_string(DEFAULT_PAN_SPEED);
     data_["TILT_SPEED"] = std::to_string(DEFAULT_TILT_SPEED);
     data_["ZOOM_STEP"] = std::to_string(DEFAULT_ZOOM_STEP);
+    data_["PTZ_MODE"]  = DEFAULT_PTZ_MODE;
+    data_["PTZ_RELATIVE_SCALE"] = std::to_string(DEFAULT_PTZ_RELATIVE_SCALE);
 }
 
 void Config::load() {
@@ -132,4 +134,25 @@ void Config::set_zoom_step(int value) {
     data_["ZOOM_STEP"] = std::to_string(value);
 }
 
+std::string Config::ptz_mode() const {
+    return get("PTZ_MODE", DEFAULT_PTZ_MODE);
+}
+
+void Config::set_ptz_mode(const std::string& value) {
+    data_["PTZ_MODE"] = value;
+}
+
+double Config::ptz_relative_scale() const {
+    try {
+        return std::stod(get("PTZ_RELATIVE_SCALE",
+                             std::to_string(DEFAULT_PTZ_RELATIVE_SCALE)));
+    } catch (...) {
+        return DEFAULT_PTZ_RELATIVE_SCALE;
+    }
+}
+
+void Config::set_ptz_relative_scale(double value) {
+    data_["PTZ_RELATIVE_SCALE"] = std::to_string(value);
+}
+
 } // namespace bcc950
@@ -0,0 +1,188 @@
+#include "bcc950/control_pacer.hpp"
+
+#include <algorithm>
+
+namespace bcc950 {
+
+namespace {
+
+/// True if every write sets a pan or tilt speed to zero. Stopping a
+/// motor must never wait behind the pacing.
+bool is_motor_stop(const ControlValue* values, std::size_t count) {
+    return std::all_of(values, values + count, [](const ControlValue& v) {
+        return (v.id == CTRL_PAN_SPEED || v.id == CTRL_TILT_SPEED) && v.value == 0;
+    });
+}
+
+} // anonymous namespace
+
+ControlPacer::ControlPacer(std::unique_ptr<IV4L2Device> device, const PacerConfig& config)
+    : device_(std::move(device))
+    , config_(config)
+    , tokens_(config.burst)
+    , refilled_(clock::now())
+    , rate_(std::clamp(config.initial_rate, config.min_rate, config.max_rate))
+{
+}
+
+void ControlPacer::set_control(uint32_t id, int32_t value) {
+    ControlValue v{id, value};
+    write(&v, 1);
+}
+
+void ControlPacer::set_controls(const ControlValue* values, std::size_t count) {
+    write(values, count);
+}
+
+void ControlPacer::write(const ControlValue* values, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    const double cost = static_cast<double>(count);
+    std::unique_lock<std::mutex> lock(mutex_);
+    refill_locked(clock::now());
+    if (tokens_ < cost && !is_motor_stop(values, count)) {
+        ++stats_.delayed;
+        // Claim each control. A newer write to any of them replaces this
+        // one; a batch is dropped whole rather than split, so its
+        // controls still change together.
+        const uint64_t ticket = ++next_ticket_;
+        for (std::size_t i = 0; i < count; ++i) {
+            newest_[values[i].id] = ticket;
+        }
+        cv_.notify_all();  // older waiters for these controls can leave
+        auto overtaken = [&] {
+            return std::any_of(values, values + count, [&](const ControlValue& v) {
+                auto it = newest_.find(v.id);
+                return it == newest_.end() || it->second != ticket;
+            });
+        };
+        ++waiting_;
+        bool superseded = false;
+        while (true) {
+            if (overtaken()) {
+                superseded = true;
+                break;
+            }
+            refill_locked(clock::now());
+            if (tokens_ >= cost) {
+                break;
+            }
+            cv_.wait_for(lock, std::chrono::duration<double>((cost - tokens_) / rate_));
+        }
+        --waiting_;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto it = newest_.find(values[i].id);
+            if (it != newest_.end() && (it->second == ticket || it->second == 0)) {
+                newest_.erase(it);
+            }
+        }
+        if (superseded) {
+            ++stats_.merged;
+            return;
+        }
+    }
+    // Stops may overdraw the bucket; later writes wait it back out.
+    tokens_ -= cost;
+    supersede_locked(values, count);
+    lock.unlock();
+
+    auto started = clock::now();
+    auto elapsed = [&] { return std::chrono::duration<double>(clock::now() - started).count(); };
+    try {
+        if (count == 1) {
+            device_->set_control(values[0].id, values[0].value);
+        } else {
+            device_->set_controls(values, count);
+        }
+    } catch (const V4L2Error&) {
+        double latency = elapsed();
+        lock.lock();
+        stats_.writes += count;
+        adapt_locked(latency, true);
+        throw;
+    }
+    double latency = elapsed();
+    lock.lock();
+    stats_.writes += count;
+    adapt_locked(latency, false);
+}
+
+void ControlPacer::refill_locked(clock::time_point now) const {
+    double dt = std::chrono::duration<double>(now - refilled_).count();
+    tokens_ = std::min(config_.burst, tokens_ + rate_ * dt);
+    refilled_ = now;
+}
+
+void ControlPacer::supersede_locked(const ControlValue* values, std::size_t count) {
+    bool any = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto it = newest_.find(values[i].id);
+        if (it != newest_.end()) {
+            it->second = 0;
+            any = true;
+        }
+    }
+    if (any) {
+        cv_.notify_all();
+    }
+}
+
+void ControlPacer::adapt_locked(double latency, bool failed) {
+    refill_locked(clock::now());  // bank tokens at the old rate first
+    const bool stalled = !failed && stats_.latency > 0.0 &&
+                         latency > std::max(config_.min_stall,
+                                            config_.stall_factor * stats_.latency);
+    if (failed || stalled) {
+        if (failed) {
+            ++stats_.errors;
+        } else {
+            ++stats_.stalls;
+        }
+        rate_ = std::max(config_.min_rate, rate_ * config_.backoff);
+        if (failed) {
+            tokens_ = std::min(tokens_, 0.0);  // let the firmware recover
+        }
+        return;
+    }
+    stats_.latency = stats_.latency > 0.0
+        ? stats_.latency + PACER_LATENCY_WEIGHT * (latency - stats_.latency)
+        : latency;
+    rate_ = std::min(config_.max_rate, rate_ + config_.increase);
+}
+
+double ControlPacer::backlog() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refill_locked(clock::now());
+    double needed = static_cast<double>(waiting_) + 1.0;
+    return std::max(0.0, (needed - tokens_) / rate_);
+}
+
+PacerStats ControlPacer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PacerStats s = stats_;
+    s.rate = rate_;
+    return s;
+}
+
+int32_t ControlPacer::get_control(uint32_t id) {
+    return device_->get_control(id);
+}
+
+struct v4l2_queryctrl ControlPacer::query_control(uint32_t id) {
+    return device_->query_control(id);
+}
+
+void ControlPacer::open(const std::string& device) {
+    device_->open(device);
+}
+
+void ControlPacer::close() {
+    device_->close();
+}
+
+bool ControlPacer::is_open() const {
+    return device_->is_open();
+}
+
+} // namespace bcc950
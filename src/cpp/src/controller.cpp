@@ -22,6 +22,13 @@ Controller::Controller(
     if (!v4l2_device_->is_open()) {
         v4l2_device_->open(device_path_);
     }
+
+    PtzMode limit = parse_ptz_mode(config_.ptz_mode());
+    if (limit != PtzMode::Velocity) {
+        PtzCapabilities caps = probe_ptz(*v4l2_device_);
+        set_relative_scale(caps, config_.ptz_relative_scale());
+        motion_.set_ptz_capabilities(caps, limit);
+    }
 }
 
 const std::string& Controller::device_path() const {
@@ -36,8 +43,16 @@ void Controller::set_device_path(const std::string& path) {
     v4l2_device_->open(path);
 }
 
-const PositionTracker& Controller::position() const {
-    return position_;
+PositionTracker Controller::position() const {
+    return motion_.snapshot();
+}
+
+std::optional<PoseSample> Controller::pose_at(double t) const {
+    return motion_.pose_at(t);
+}
+
+const PoseHistory& Controller::pose_history() const {
+    return motion_.pose_history();
 }
 
 Config& Controller::config() {
@@ -80,7 +95,7 @@ void Controller::reset_position() {
     motion_.tilt(1, 0.1);
     motion_.tilt(-1, 0.1);
     motion_.zoom_absolute(ZOOM_MIN);
-    position_.reset();
+    motion_.reset_position();
 }
 
 // --- New API ---
@@ -89,17 +104,55 @@ void Controller::move(int pan_dir, int tilt_dir, double duration) {
     motion_.combined_move(pan_dir, tilt_dir, duration);
 }
 
+bool Controller::move_at(int pan_dir, int tilt_dir, double duration,
+                         std::chrono::steady_clock::time_point start, MoveTiming* timing) {
+    return motion_.combined_move_at(pan_dir, tilt_dir, duration, start, timing);
+}
+
 void Controller::zoom_to(int value) {
     motion_.zoom_absolute(value);
 }
 
+void Controller::move_fov(double pan_fovs, double tilt_fovs) {
+    motion_.move_fov(pan_fovs, tilt_fovs);
+}
+
+void Controller::move_to(double pan, double tilt) {
+    motion_.move_to(pan, tilt);
+}
+
+bool Controller::run_trajectory(const Trajectory& trajectory) {
+    return motion_.run_trajectory(trajectory);
+}
+
+bool Controller::scan(const ScanSpec& spec) {
+    uint64_t token = motion_.cancel_token();
+    motion_.zoom_absolute(spec.zoom);
+    if (!motion_.wait_zoom_settled()) {
+        return false;
+    }
+    // Tile spacing follows the calibrated lens, not the spec's defaults.
+    ScanSpec planned = spec;
+    planned.optics = motion_.zoom_model();
+    PositionTracker pos = motion_.snapshot();
+    return motion_.run_trajectory(plan_scan(planned, pos.pan, pos.tilt), token);
+}
+
+void Controller::set_zoom_model(const ZoomModel& model) {
+    motion_.set_zoom_model(model);
+}
+
+void Controller::set_velocity(int pan_dir, int tilt_dir) {
+    motion_.set_velocity(pan_dir, tilt_dir);
+}
+
 void Controller::move_with_zoom(int pan_dir, int tilt_dir,
                                  int zoom_target, double duration) {
     motion_.combined_move_with_zoom(pan_dir, tilt_dir, zoom_target, duration);
 }
 
 void Controller::save_preset(const std::string& name) {
-    presets_.save_preset(name, position_);
+    presets_.save_preset(name, motion_.snapshot());
 }
 
 bool Controller::recall_preset(const std::string& name) {
@@ -108,6 +161,11 @@ bool Controller::recall_preset(const std::string& name) {
         return false;
     }
     motion_.zoom_absolute(pos->zoom);
+    // Dead-reckoned speed bursts would drift, so velocity-only heads
+    // restore zoom alone, as the Python controller does.
+    if (motion_.ptz_mode() != PtzMode::Velocity) {
+        motion_.move_to(pos->pan, pos->tilt);
+    }
     return true;
 }
 
@@ -136,8 +194,61 @@ bool Controller::has_ptz_support() {
     }
 }
 
+PtzMode Controller::ptz_mode() const {
+    return motion_.ptz_mode();
+}
+
+bool Controller::sync_position() {
+    return motion_.sync_position();
+}
+
 void Controller::stop() {
     motion_.stop();
 }
 
+bool Controller::home() {
+    return motion_.home();
+}
+
+void Controller::set_homing_profile(const HomingProfile& profile) {
+    motion_.set_homing_profile(profile);
+}
+
+// --- Safety ---
+
+void Controller::heartbeat() {
+    motion_.heartbeat();
+}
+
+void Controller::set_heartbeat_timeout(double seconds) {
+    motion_.set_heartbeat_timeout(seconds);
+}
+
+bool Controller::set_realtime(const RealtimeConfig& config) {
+    return motion_.set_realtime(config);
+}
+
+JitterStats Controller::wake_jitter() const {
+    return motion_.wake_jitter();
+}
+
+// --- Scheduling ---
+
+CommandScheduler& Controller::scheduler() {
+    std::call_once(scheduler_once_, [this] {
+        scheduler_ = std::make_unique<CommandScheduler>(motion_);
+        if (auto* pacer = dynamic_cast<ControlPacer*>(v4l2_device_.get())) {
+            scheduler_->set_backpressure([pacer] { return pacer->backlog(); });
+        }
+    });
+    return *scheduler_;
+}
+
+std::optional<PacerStats> Controller::pacer_stats() const {
+    if (auto* pacer = dynamic_cast<const ControlPacer*>(v4l2_device_.get())) {
+        return pacer->stats();
+    }
+    return std::nullopt;
+}
+
 } // namespace bcc950
@@ -0,0 +1,29 @@
+#include "bcc950/frame.hpp"
+
+namespace bcc950 {
+
+ImagePtr Frame::decode(int scale, PixelFormat format) const {
+    Decoded* slot;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto& entry = cache_[{scale, format}];
+        if (!entry) {
+            entry = std::make_unique<Decoded>();
+        }
+        slot = entry.get();
+    }
+    // Other resolutions decode in parallel; a failed decode is retried
+    // by the next caller.
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if (!slot->image) {
+        slot->image = decode_jpeg(data(), size(), scale, format);
+    }
+    return slot->image;
+}
+
+ImagePtr Frame::decode_at_least(int min_width, int min_height,
+                                PixelFormat format) const {
+    return decode(jpeg_scale_for(width_, height_, min_width, min_height), format);
+}
+
+} // namespace bcc950
@@ -0,0 +1,118 @@
+#include "bcc950/frame_buffer.hpp"
+#include "bcc950/pose_history.hpp"
+
+#include <chrono>
+#include <exception>
+#include <limits>
+
+namespace bcc950 {
+
+namespace {
+
+// Bound on one blocking read, so stop() is noticed promptly.
+constexpr double READ_TIMEOUT  = 0.1;
+// Pause after a failed read before retrying.
+constexpr double ERROR_BACKOFF = 0.1;
+
+} // namespace
+
+FrameBuffer::FrameBuffer(FrameSource& source)
+    : source_(source) {}
+
+FrameBuffer::~FrameBuffer() {
+    stop();
+}
+
+void FrameBuffer::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    exit_ = false;
+    thread_ = std::thread(&FrameBuffer::run, this);
+}
+
+void FrameBuffer::stop() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exit_ = true;
+        thread.swap(thread_);
+    }
+    cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+FramePtr FrameBuffer::latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+}
+
+FramePtr FrameBuffer::wait_next(uint64_t frame_id, double timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool fresh = cv_.wait_for(lock, std::chrono::duration<double>(timeout), [&] {
+        return frame_id_ > frame_id || exit_;
+    });
+    return fresh && frame_id_ > frame_id ? latest_ : nullptr;
+}
+
+FramePtr FrameBuffer::wait_settled(uint64_t frame_id, double timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool found = cv_.wait_for(lock, std::chrono::duration<double>(timeout), [&] {
+        return exit_ || (frame_id_ > frame_id && latest_->settled());
+    });
+    return found && !exit_ ? latest_ : nullptr;
+}
+
+uint64_t FrameBuffer::frame_id() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frame_id_;
+}
+
+double FrameBuffer::frame_age() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!latest_) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return PoseHistory::now() - latest_->timestamp();
+}
+
+uint64_t FrameBuffer::errors() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return errors_;
+}
+
+void FrameBuffer::run() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (exit_) {
+                return;
+            }
+        }
+
+        FramePtr frame;
+        try {
+            frame = source_.read(READ_TIMEOUT);
+        } catch (const std::exception&) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ++errors_;
+            cv_.wait_for(lock, std::chrono::duration<double>(ERROR_BACKOFF),
+                         [this] { return exit_; });
+            continue;
+        }
+
+        if (frame) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                latest_ = std::move(frame);
+                ++frame_id_;
+            }
+            cv_.notify_all();
+        }
+    }
+}
+
+} // namespace bcc950
@@ -0,0 +1,90 @@
+#include "bcc950/frame_motion.hpp"
+#include "bcc950/pose_history.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace bcc950 {
+
+namespace {
+
+/// Interval over which the head was continuously moving or still.
+struct Span {
+    double start;
+    double end;
+    bool   moving;
+};
+
+/// Moving/still spans from the motion log. Zoom-only samples stop
+/// moving when the lens arrives, which is not itself logged.
+std::vector<Span> spans_of(const std::vector<PoseSample>& samples) {
+    constexpr double never = std::numeric_limits<double>::infinity();
+    std::vector<Span> spans;
+    auto append = [&](double start, double end, bool moving) {
+        if (!spans.empty() && spans.back().moving == moving) {
+            spans.back().end = end;
+        } else {
+            spans.push_back(Span{start, end, moving});
+        }
+    };
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const PoseSample& s = samples[i];
+        double end = i + 1 < samples.size() ? samples[i + 1].timestamp : never;
+        if (s.pan_speed != 0 || s.tilt_speed != 0) {
+            append(s.timestamp, end, true);
+        } else if (s.zoom_rate != 0.0) {
+            double arrive = s.timestamp +
+                std::abs(s.zoom_target - s.zoom) / std::abs(s.zoom_rate);
+            append(s.timestamp, std::min(arrive, end), true);
+            if (arrive < end) {
+                append(arrive, end, false);
+            }
+        } else {
+            append(s.timestamp, end, false);
+        }
+    }
+    return spans;
+}
+
+} // anonymous namespace
+
+MotionState motion_state(const PoseHistory& history, double t,
+                         const MotionTiming& timing) {
+    const double from = t - std::max(timing.exposure, 0.0);
+    const double lookback = from - std::max(timing.accel_time, timing.settle_time);
+    std::vector<Span> spans = spans_of(history.samples_between(lookback, t));
+
+    bool moving = false;
+    bool accelerating = false;
+    bool settling = false;
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        const Span& span = spans[i];
+        if (span.end <= from || span.start > t) {
+            continue;  // outside the exposure
+        }
+        double lo = std::max(span.start, from);
+        double hi = std::min(span.end, t);
+        if (span.moving) {
+            if (hi >= span.start + timing.accel_time) {
+                moving = true;
+            } else {
+                accelerating = true;
+            }
+        } else if (i > 0 && lo < span.start + timing.settle_time) {
+            settling = true;  // spans alternate, so spans[i - 1] moved
+        }
+    }
+
+    if (moving) {
+        return MotionState::Moving;
+    }
+    if (accelerating) {
+        return MotionState::Accelerating;
+    }
+    return settling ? MotionState::Settling : MotionState::Stationary;
+}
+
+} // namespace bcc950
@@ -0,0 +1,168 @@
+#include "bcc950/jpeg_decoder.hpp"
+
+#include <string>
+#include <utility>
+
+#ifdef BCC950_HAVE_JPEG
+#include <csetjmp>
+#include <cstdio>   // jpeglib.h needs FILE
+#include <jpeglib.h>
+#endif
+
+namespace bcc950 {
+
+namespace {
+
+bool valid_scale(int scale) {
+    return scale == 1 || scale == 2 || scale == 4 || scale == 8;
+}
+
+int channels_of(PixelFormat format) {
+    return format == PixelFormat::Gray ? 1 : 3;
+}
+
+#ifdef BCC950_HAVE_JPEG
+
+// libjpeg reports fatal errors through error_exit, which must not
+// return. Jump back to decode_jpeg() and throw from there, never across
+// the library's C frames.
+struct ErrorManager {
+    jpeg_error_mgr base;
+    std::jmp_buf   jump;
+    char           message[JMSG_LENGTH_MAX];
+};
+
+void on_error(j_common_ptr cinfo) {
+    auto* err = reinterpret_cast<ErrorManager*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    std::longjmp(err->jump, 1);
+}
+
+// Camera MJPEG routinely trips recoverable warnings (e.g. padding after
+// EOI); keep them off stderr.
+void on_message(j_common_ptr) {}
+
+#endif
+
+} // namespace
+
+bool jpeg_decode_supported() {
+#ifdef BCC950_HAVE_JPEG
+    return true;
+#else
+    return false;
+#endif
+}
+
+int jpeg_scale_for(int width, int height, int min_width, int min_height) {
+    int best = 1;
+    for (int scale : {2, 4, 8}) {
+        // libjpeg rounds scaled dimensions up.
+        int w = (width + scale - 1) / scale;
+        int h = (height + scale - 1) / scale;
+        if (w < min_width || h < min_height) {
+            break;
+        }
+        best = scale;
+    }
+    return best;
+}
+
+#ifdef BCC950_HAVE_JPEG
+
+ImagePtr decode_jpeg(const uint8_t* data, std::size_t size,
+                     int scale, PixelFormat format) {
+    if (!valid_scale(scale)) {
+        throw JpegError("JPEG scale must be 1, 2, 4 or 8, got " +
+                        std::to_string(scale));
+    }
+    if (data == nullptr || size == 0) {
+        throw JpegError("Empty JPEG buffer");
+    }
+
+    // Everything with a destructor is constructed before setjmp, so the
+    // longjmp back here skips nothing.
+    auto image = std::make_shared<Image>();
+    std::string error;
+    jpeg_decompress_struct cinfo{};
+    ErrorManager err{};
+
+    cinfo.err = jpeg_std_error(&err.base);
+    err.base.error_exit = on_error;
+    err.base.output_message = on_message;
+
+    if (setjmp(err.jump)) {
+        error = err.message;
+        jpeg_destroy_decompress(&cinfo);
+        image.reset();
+        throw JpegError("JPEG decode failed: " + error);
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, const_cast<unsigned char*>(data),
+                 static_cast<unsigned long>(size));
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale);
+    bool swap_rb = false;
+    switch (format) {
+    case PixelFormat::Gray:
+        // Chroma components are then marked unneeded and never decoded.
+        cinfo.out_color_space = JCS_GRAYSCALE;
+        break;
+    case PixelFormat::RGB:
+        cinfo.out_color_space = JCS_RGB;
+        break;
+    case PixelFormat::BGR:
+#ifdef JCS_EXTENSIONS
+        cinfo.out_color_space = JCS_EXT_BGR;
+#else
+        cinfo.out_color_space = JCS_RGB;
+        swap_rb = true;
+#endif
+        break;
+    }
+
+    jpeg_start_decompress(&cinfo);
+
+    image->width = static_cast<int>(cinfo.output_width);
+    image->height = static_cast<int>(cinfo.output_height);
+    image->channels = static_cast<int>(cinfo.output_components);
+    image->format = format;
+    const std::size_t stride =
+        static_cast<std::size_t>(image->width) * image->channels;
+    image->pixels.resize(stride * image->height);
+
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = image->pixels.data() + stride * cinfo.output_scanline;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+
+    if (swap_rb) {
+        for (std::size_t i = 0; i + 2 < image->pixels.size(); i += 3) {
+            std::swap(image->pixels[i], image->pixels[i + 2]);
+        }
+    }
+    if (image->channels != channels_of(format)) {
+        throw JpegError("Unexpected JPEG component count");
+    }
+    return image;
+}
+
+#else
+
+ImagePtr decode_jpeg(const uint8_t*, std::size_t, int scale, PixelFormat) {
+    if (!valid_scale(scale)) {
+        throw JpegError("JPEG scale must be 1, 2, 4 or 8, got " +
+                        std::to_string(scale));
+    }
+    throw JpegError("libbcc950 was built without JPEG support");
+}
+
+#endif
+
+} // namespace bcc950
@@ -8,6 +8,7 @@
 
 #include "bcc950/controller.hpp"
 #include "bcc950/v4l2_device.hpp"
+#include "bcc950/watchdog.hpp"
 
 namespace {
 
@@ -36,6 +37,7 @@ struct Args {
 
     bool show_position = false;
     bool reset         = false;
+    bool home          = false;
     bool setup         = false;
     bool info          = false;
     bool help          = false;
@@ -70,6 +72,7 @@ void print_usage(const char* prog) {
         << "Info / Setup:\n"
         << "      --position           Show estimated position\n"
         << "      --reset              Reset camera to default position\n"
+        << "      --home               Home against the hard stops, then center\n"
         << "      --setup              Detect camera and test connection\n"
         << "      --info               Show camera information\n"
         << "  -h, --help               Show this help message\n";
@@ -145,6 +148,8 @@ bool parse_args(int argc, char* argv[], Args& args) {
             args.show_position = true;
         } else if (arg == "--reset") {
             args.reset = true;
+        } else if (arg == "--home") {
+            args.home = true;
         } else if (arg == "--setup") {
             args.setup = true;
         } else if (arg == "--info") {
@@ -181,7 +186,7 @@ int main(int argc, char* argv[]) {
         !args.recall_preset.empty() ||
         !args.delete_preset.empty() ||
         args.list_presets ||
-        args.show_position || args.reset ||
+        args.show_position || args.reset || args.home ||
         args.setup || args.info;
 
     if (!has_action) {
@@ -189,6 +194,9 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    // Ctrl+C or a kill during --duration must not leave the motors running.
+    bcc950::install_safety_handlers();
+
     try {
         auto v4l2_dev = std::make_unique<bcc950::V4L2Device>();
         bcc950::Controller ctrl(std::move(v4l2_dev), args.device);
@@ -244,7 +252,7 @@ int main(int argc, char* argv[]) {
                 }
             }
         } else if (args.show_position) {
-            const auto& pos = ctrl.position();
+            const auto pos = ctrl.position();
             std::cout << std::fixed << std::setprecision(2);
             std::cout << "Pan: " << pos.pan
                       << "  Tilt: " << pos.tilt
@@ -252,6 +260,12 @@ int main(int argc, char* argv[]) {
         } else if (args.reset) {
             ctrl.reset_position();
             std::cout << "Camera reset to default position.\n";
+        } else if (args.home) {
+            if (!ctrl.home()) {
+                std::cerr << "Homing interrupted.\n";
+                return 1;
+            }
+            std::cout << "Camera homed.\n";
         } else if (args.info) {
             std::cout << "Device: " << ctrl.device_path() << "\n";
             std::cout << "PTZ support: "
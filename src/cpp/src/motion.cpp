@@ -1,95 +1,986 @@
 #include "bcc950/motion.hpp"
 
+#include "bcc950/controls.hpp"
+
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <thread>
 #include <chrono>
 
 namespace bcc950 {
 
+namespace {
+
+/// Travel shorter than this counts as already being at a soft limit.
+constexpr double LIMIT_EPSILON = 1e-3;
+
+} // anonymous namespace
+
+/// Disarms a watchdog deadline when a timed move finishes. If the move
+/// unwinds early (a device write threw), stops both axes on the way out.
+class MotionController::StopGuard {
+public:
+    StopGuard(MotionController& motion, uint64_t deadline_id)
+        : motion_(motion), deadline_id_(deadline_id) {}
+
+    ~StopGuard() {
+        motion_.watchdog_.disarm(deadline_id_);
+        if (released_) {
+            return;
+        }
+        try {
+            set_all<PanSpeed, TiltSpeed>(*motion_.device_, 0, 0);
+        } catch (const V4L2Error&) {
+            // Already unwinding from a device error; nothing more to do.
+        }
+    }
+
+    StopGuard(const StopGuard&) = delete;
+    StopGuard& operator=(const StopGuard&) = delete;
+
+    /// The stop was written normally.
+    void release() { released_ = true; }
+
+private:
+    MotionController& motion_;
+    uint64_t deadline_id_;
+    bool released_ = false;
+};
+
 MotionController::MotionController(IV4L2Device* device, PositionTracker* position)
     : device_(device)
     , owned_position_()
-    , position_(position ? position : &owned_position_) {
+    , position_(position ? position : &owned_position_)
+    , zoom_from_(position_->zoom)
+    , zoom_to_(position_->zoom)
+    , watchdog_([this] { force_stop(); }) {
+    commit_pose_locked(0, 0);
 }
 
-int MotionController::clamp_speed(int value) {
-    return std::clamp(value, PAN_SPEED_MIN, PAN_SPEED_MAX);
+MotionController::~MotionController() {
+    {
+        std::lock_guard<std::mutex> lock(engine_mutex_);
+        engine_exit_ = true;
+    }
+    engine_cv_.notify_all();
+    if (engine_.joinable()) {
+        engine_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    try {
+        halt_velocity_locked(true);
+    } catch (const V4L2Error&) {
+        // Device already gone; nothing left to stop.
+    }
 }
 
-int MotionController::clamp_zoom(int value) {
-    return std::clamp(value, ZOOM_MIN, ZOOM_MAX);
+double MotionController::spin_seconds() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return realtime_.enabled ? realtime_.spin : 0.0;
+}
+
+double MotionController::interruptible_sleep(double duration, uint64_t token) {
+    return interruptible_sleep_until(std::chrono::steady_clock::now(), duration, token);
+}
+
+double MotionController::interruptible_sleep_until(std::chrono::steady_clock::time_point origin,
+                                                   double offset, uint64_t token) {
+    using clock = std::chrono::steady_clock;
+    const double spin = spin_seconds();
+    auto deadline = origin + std::chrono::duration_cast<clock::duration>(
+                                 std::chrono::duration<double>(offset));
+    std::unique_lock<std::mutex> lock(cancel_mutex_);
+    bool cancelled = wait_until_precise(lock, cancel_cv_, deadline, spin,
+                                        [&] { return cancel_seq_ != token; });
+    auto now = clock::now();
+    if (!cancelled) {
+        jitter_.record(std::chrono::duration<double>(now - deadline).count());
+        return offset;
+    }
+    double elapsed = std::chrono::duration<double>(now - origin).count();
+    return std::clamp(elapsed, 0.0, offset);
+}
+
+bool MotionController::timed_move_locked(const TimedMove& move, uint64_t token) {
+    {
+        // A move preempted before it acquired the mutex never starts.
+        std::lock_guard<std::mutex> cancel_lock(cancel_mutex_);
+        if (cancel_seq_ != token) {
+            return false;
+        }
+    }
+
+    // Predictive soft limits: each axis runs only until its estimate
+    // would reach a limit rather than grinding into the hard stop.
+    double pan_time  = move.pan_duration;
+    double tilt_time = move.tilt_duration;
+    if (move.respect_limits) {
+        pan_time  = std::min(pan_time,  position_->time_to_pan_limit(move.pan_speed));
+        tilt_time = std::min(tilt_time, position_->time_to_tilt_limit(move.tilt_speed));
+    }
+    bool drive_pan  = move.use_pan  && pan_time  > LIMIT_EPSILON;
+    bool drive_tilt = move.use_tilt && tilt_time > LIMIT_EPSILON;
+    if (move.timing) {
+        move.timing->clamped = (move.use_pan  && pan_time  < move.pan_duration) ||
+                               (move.use_tilt && tilt_time < move.tilt_duration);
+    }
+    if (!drive_pan && !drive_tilt && !move.zoom) {
+        return true;
+    }
+
+    double total = std::max(drive_pan ? pan_time : 0.0, drive_tilt ? tilt_time : 0.0);
+    ScopedRealtime rt(realtime());
+    halt_velocity_locked(true);
+    ControlBatch<PanSpeed, TiltSpeed, ZoomAbsolute> start;
+    if (drive_pan)  start.set<PanSpeed>(move.pan_speed);
+    if (drive_tilt) start.set<TiltSpeed>(move.tilt_speed);
+    if (move.zoom)  start.set<ZoomAbsolute>(*move.zoom);
+
+    // Seconds the start went out past move.start_at; travel before it
+    // never happened, but the stop deadlines stay where they were.
+    double late = 0.0;
+    if (move.start_at) {
+        std::unique_lock<std::mutex> cancel_lock(cancel_mutex_);
+        if (wait_until_precise(cancel_lock, cancel_cv_, *move.start_at,
+                               std::max(spin_seconds(), GROUP_START_SPIN),
+                               [&] { return cancel_seq_ != token; })) {
+            return false;
+        }
+        late = std::max(0.0, std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - *move.start_at).count());
+        if (late >= total) {
+            // Every stop deadline has passed: a start and an immediate
+            // stop would only twitch the head.
+            return false;
+        }
+    }
+    StopGuard guard(*this, watchdog_.arm(total));
+    start.apply(*device_);
+    // Stop deadlines count from the moment the motors started, so the
+    // bookkeeping below and each stop write do not push later ones back.
+    const auto started = move.start_at ? *move.start_at : std::chrono::steady_clock::now();
+    if (move.timing) {
+        move.timing->started = std::chrono::steady_clock::now();
+    }
+    auto travel = [late](double t) { return std::max(0.0, t - late); };
+    if (move.zoom) {
+        begin_zoom_slew(*move.zoom);
+    }
+    const double start_pan  = position_->pan;
+    const double start_tilt = position_->tilt;
+    commit_pose_locked(drive_pan ? move.pan_speed : 0, drive_tilt ? move.tilt_speed : 0);
+
+    // Stop each axis at its own time (pan first on ties), or when the
+    // stall detector reports it has hit something. A cancel stops
+    // whatever is still running.
+    constexpr double never = std::numeric_limits<double>::infinity();
+    bool pan_running  = drive_pan;
+    bool tilt_running = drive_tilt;
+    bool cancelled = false;
+    double pan_travelled  = 0.0;
+    double tilt_travelled = 0.0;
+    double elapsed = 0.0;
+    while (pan_running || tilt_running) {
+        double next = std::min(pan_running  ? pan_time  : never,
+                               tilt_running ? tilt_time : never);
+        double want = next - elapsed;
+        bool to_next = true;
+        if (move.stalled && move.poll_interval < want) {
+            want = move.poll_interval;
+            to_next = false;
+        }
+        double target = elapsed + want;
+        double reached = interruptible_sleep_until(started, target, token);
+        bool cut = reached < target;
+        cancelled = cancelled || cut;
+        elapsed = cut ? reached : (to_next ? next : target);
+
+        bool pan_stop = cut || pan_time <= elapsed ||
+                        (move.stalled && pan_running && move.stalled(Axis::Pan));
+        bool tilt_stop = cut || tilt_time <= elapsed ||
+                         (move.stalled && tilt_running && move.stalled(Axis::Tilt));
+        ControlBatch<PanSpeed, TiltSpeed> stops;
+        if (pan_running && pan_stop) {
+            stops.set<PanSpeed>(0);
+            pan_travelled = elapsed;
+            pan_running = false;
+        }
+        if (tilt_running && tilt_stop) {
+            stops.set<TiltSpeed>(0);
+            tilt_travelled = elapsed;
+            tilt_running = false;
+        }
+        stops.apply(*device_);
+        if (move.timing) {
+            move.timing->stopped = std::chrono::steady_clock::now();
+        }
+        if (pan_running != tilt_running) {
+            // One axis stopped, the other carries on.
+            double pan_at  = pan_running  ? elapsed : pan_travelled;
+            double tilt_at = tilt_running ? elapsed : tilt_travelled;
+            record_pose(start_pan  + move.pan_speed  * (drive_pan  ? travel(pan_at)  : 0.0),
+                        start_tilt + move.tilt_speed * (drive_tilt ? travel(tilt_at) : 0.0),
+                        pan_running  ? move.pan_speed  : 0,
+                        tilt_running ? move.tilt_speed : 0);
+        }
+    }
+    guard.release();
+
+    if (drive_pan)  position_->update_pan(move.pan_speed, travel(pan_travelled));
+    if (drive_tilt) position_->update_tilt(move.tilt_speed, travel(tilt_travelled));
+    if (move.zoom)  position_->update_zoom(*move.zoom);
+    commit_pose_locked(0, 0);
+    return !cancelled;
 }
 
 void MotionController::pan(int direction, double duration) {
-    int speed = clamp_speed(direction);
+    TimedMove move;
+    move.use_pan   = true;
+    move.pan_speed = PanSpeed::clamp(direction);
+    move.pan_duration = duration;
+    uint64_t token = cancel_token();
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_PAN_SPEED, speed);
-    std::this_thread::sleep_for(
-        std::chrono::duration<double>(duration));
-    device_->set_control(CTRL_PAN_SPEED, 0);
-    position_->update_pan(speed, duration);
+    timed_move_locked(move, token);
 }
 
 void MotionController::tilt(int direction, double duration) {
-    int speed = clamp_speed(direction);
+    TimedMove move;
+    move.use_tilt   = true;
+    move.tilt_speed = TiltSpeed::clamp(direction);
+    move.tilt_duration = duration;
+    uint64_t token = cancel_token();
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_TILT_SPEED, speed);
-    std::this_thread::sleep_for(
-        std::chrono::duration<double>(duration));
-    device_->set_control(CTRL_TILT_SPEED, 0);
-    position_->update_tilt(speed, duration);
+    timed_move_locked(move, token);
 }
 
 void MotionController::combined_move(int pan_dir, int tilt_dir, double duration) {
-    int pan_speed  = clamp_speed(pan_dir);
-    int tilt_speed = clamp_speed(tilt_dir);
+    combined_move(pan_dir, tilt_dir, duration, cancel_token());
+}
+
+void MotionController::combined_move(int pan_dir, int tilt_dir, double duration,
+                                     uint64_t token) {
+    TimedMove move;
+    move.use_pan    = true;
+    move.pan_speed  = PanSpeed::clamp(pan_dir);
+    move.use_tilt   = true;
+    move.tilt_speed = TiltSpeed::clamp(tilt_dir);
+    move.pan_duration  = duration;
+    move.tilt_duration = duration;
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_PAN_SPEED, pan_speed);
-    device_->set_control(CTRL_TILT_SPEED, tilt_speed);
-    std::this_thread::sleep_for(
-        std::chrono::duration<double>(duration));
-    device_->set_control(CTRL_PAN_SPEED, 0);
-    device_->set_control(CTRL_TILT_SPEED, 0);
-    position_->update_pan(pan_speed, duration);
-    position_->update_tilt(tilt_speed, duration);
+    timed_move_locked(move, token);
+}
+
+bool MotionController::combined_move_at(int pan_dir, int tilt_dir, double duration,
+                                        std::chrono::steady_clock::time_point start,
+                                        MoveTiming* timing) {
+    TimedMove move;
+    move.use_pan    = true;
+    move.pan_speed  = PanSpeed::clamp(pan_dir);
+    move.use_tilt   = true;
+    move.tilt_speed = TiltSpeed::clamp(tilt_dir);
+    move.pan_duration  = duration;
+    move.tilt_duration = duration;
+    move.start_at   = start;
+    move.timing     = timing;
+    uint64_t token = cancel_token();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timed_move_locked(move, token);
 }
 
 void MotionController::combined_move_with_zoom(int pan_dir, int tilt_dir,
                                                 int zoom_target, double duration) {
-    int pan_speed  = clamp_speed(pan_dir);
-    int tilt_speed = clamp_speed(tilt_dir);
-    zoom_target    = clamp_zoom(zoom_target);
+    TimedMove move;
+    move.use_pan    = true;
+    move.pan_speed  = PanSpeed::clamp(pan_dir);
+    move.use_tilt   = true;
+    move.tilt_speed = TiltSpeed::clamp(tilt_dir);
+    move.pan_duration  = duration;
+    move.tilt_duration = duration;
+    move.zoom       = ZoomAbsolute::clamp(zoom_target);
+    uint64_t token = cancel_token();
+    std::lock_guard<std::mutex> lock(mutex_);
+    timed_move_locked(move, token);
+}
+
+MotionController::TimedMove MotionController::move_toward_locked(double pan,
+                                                                 double tilt) const {
+    double dp = pan  - position_->pan;
+    double dt = tilt - position_->tilt;
+    TimedMove move;
+    move.use_pan       = dp != 0.0;
+    move.pan_speed     = dp > 0.0 ? 1 : -1;
+    move.pan_duration  = std::abs(dp);
+    move.use_tilt      = dt != 0.0;
+    move.tilt_speed    = dt > 0.0 ? 1 : -1;
+    move.tilt_duration = std::abs(dt);
+    return move;
+}
+
+bool MotionController::move_to_locked(double pan, double tilt, uint64_t token) {
+    if (ptz_mode() != PtzMode::Velocity) {
+        return positional_move_locked(pan, tilt, token);
+    }
+    return timed_move_locked(move_toward_locked(pan, tilt), token);
+}
+
+bool MotionController::positional_move_locked(double pan, double tilt, uint64_t token) {
+    {
+        std::lock_guard<std::mutex> cancel_lock(cancel_mutex_);
+        if (cancel_seq_ != token) {
+            return false;
+        }
+    }
+    PtzCapabilities caps;
+    PtzMode mode;
+    ZoomModel model;
+    {
+        std::lock_guard<std::mutex> config_lock(config_mutex_);
+        caps = ptz_;
+        mode = ptz_mode_;
+        model = zoom_model_;
+    }
+    const bool absolute = mode == PtzMode::Absolute;
+    const PtzControl& pan_control  = absolute ? caps.pan_absolute  : caps.pan_relative;
+    const PtzControl& tilt_control = absolute ? caps.tilt_absolute : caps.tilt_relative;
+    // Absolute targets go out as one batch; relative offsets one by one.
+    auto write = [&](std::optional<int32_t> pan_value, std::optional<int32_t> tilt_value) {
+        if (absolute) {
+            ControlBatch<PanAbsolute, TiltAbsolute> batch;
+            if (pan_value)  batch.set<PanAbsolute>(*pan_value);
+            if (tilt_value) batch.set<TiltAbsolute>(*tilt_value);
+            batch.apply(*device_);
+        } else {
+            if (pan_value)  set<PanRelative>(*device_, *pan_value);
+            if (tilt_value) set<TiltRelative>(*device_, *tilt_value);
+        }
+    };
+    // Control units per movement-second.
+    const double pan_scale  = model.pan_rate  * pan_control.units_per_degree;
+    const double tilt_scale = model.tilt_rate * tilt_control.units_per_degree;
+
+    pan  = std::clamp(pan,  position_->pan_min,  position_->pan_max);
+    tilt = std::clamp(tilt, position_->tilt_min, position_->tilt_max);
+    const double start_pan  = position_->pan;
+    const double start_tilt = position_->tilt;
+
+    // Commands rounded to the controls' steps and ranges, and the travel
+    // they actually produce.
+    const int32_t pan_cmd  = pan_control.clamp((absolute ? pan : pan - start_pan) * pan_scale);
+    const int32_t tilt_cmd = tilt_control.clamp((absolute ? tilt : tilt - start_tilt) * tilt_scale);
+    const double dp = pan_cmd / pan_scale - (absolute ? start_pan : 0.0);
+    const double dt = tilt_cmd / tilt_scale - (absolute ? start_tilt : 0.0);
+    const bool drive_pan  = std::abs(dp) > LIMIT_EPSILON;
+    const bool drive_tilt = std::abs(dt) > LIMIT_EPSILON;
+    if (!drive_pan && !drive_tilt) {
+        return true;
+    }
+    const int pan_dir  = dp > 0.0 ? 1 : -1;
+    const int tilt_dir = dt > 0.0 ? 1 : -1;
+
+    halt_velocity_locked(true);
+    write(drive_pan  ? std::optional<int32_t>(pan_cmd)  : std::nullopt,
+          drive_tilt ? std::optional<int32_t>(tilt_cmd) : std::nullopt);
+    commit_pose_locked(drive_pan ? pan_dir : 0, drive_tilt ? tilt_dir : 0);
+
+    // The head travels at full speed, one movement-second per second.
+    const double pan_time  = drive_pan  ? std::abs(dp) : 0.0;
+    const double tilt_time = drive_tilt ? std::abs(dt) : 0.0;
+    const double first = drive_pan && drive_tilt ? std::min(pan_time, tilt_time)
+                                                 : std::max(pan_time, tilt_time);
+    const double last  = std::max(pan_time, tilt_time);
+    double elapsed = interruptible_sleep(first, token);
+    bool cancelled = elapsed < first;
+    if (!cancelled && last > first) {
+        record_pose(start_pan  + (pan_time  > first ? pan_dir  * first : dp),
+                    start_tilt + (tilt_time > first ? tilt_dir * first : dt),
+                    pan_time  > first ? pan_dir  : 0,
+                    tilt_time > first ? tilt_dir : 0);
+        double more = interruptible_sleep(last - first, token);
+        cancelled = more < last - first;
+        elapsed += more;
+    }
+
+    const double pan_now  = start_pan  + (elapsed < pan_time  ? pan_dir  * elapsed : dp);
+    const double tilt_now = start_tilt + (elapsed < tilt_time ? tilt_dir * elapsed : dt);
+    if (cancelled) {
+        // Re-target whatever is still travelling to where it is now.
+        std::optional<int32_t> pan_stop, tilt_stop;
+        if (elapsed < pan_time) {
+            pan_stop = pan_control.clamp(
+                (absolute ? pan_now : pan_now - (start_pan + dp)) * pan_scale);
+        }
+        if (elapsed < tilt_time) {
+            tilt_stop = tilt_control.clamp(
+                (absolute ? tilt_now : tilt_now - (start_tilt + dt)) * tilt_scale);
+        }
+        write(pan_stop, tilt_stop);
+    }
+    if (!absolute || !sync_position_locked()) {
+        position_->pan  = pan_now;
+        position_->tilt = tilt_now;
+    }
+    commit_pose_locked(0, 0);
+    return !cancelled;
+}
+
+void MotionController::move_to(double pan, double tilt) {
+    uint64_t token = cancel_token();
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_PAN_SPEED, pan_speed);
-    device_->set_control(CTRL_TILT_SPEED, tilt_speed);
-    device_->set_control(CTRL_ZOOM_ABSOLUTE, zoom_target);
-    std::this_thread::sleep_for(
-        std::chrono::duration<double>(duration));
-    device_->set_control(CTRL_PAN_SPEED, 0);
-    device_->set_control(CTRL_TILT_SPEED, 0);
-    position_->update_pan(pan_speed, duration);
-    position_->update_tilt(tilt_speed, duration);
-    position_->update_zoom(zoom_target);
+    move_to_locked(pan, tilt, token);
+}
+
+bool MotionController::run_trajectory(const Trajectory& trajectory) {
+    return run_trajectory(trajectory, cancel_token());
+}
+
+bool MotionController::run_trajectory(const Trajectory& trajectory, uint64_t token) {
+    for (const auto& waypoint : trajectory.waypoints) {
+        {
+            // Released between legs so a stop() need not wait for the
+            // whole trajectory.
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!move_to_locked(waypoint.pan, waypoint.tilt, token)) {
+                return false;
+            }
+        }
+        if (waypoint.dwell > 0.0 &&
+            interruptible_sleep(waypoint.dwell, token) < waypoint.dwell) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void MotionController::zoom_absolute(int value) {
-    value = clamp_zoom(value);
+    value = ZoomAbsolute::clamp(value);
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_ZOOM_ABSOLUTE, value);
+    set<ZoomAbsolute>(*device_, value);
+    begin_zoom_slew(value);
     position_->update_zoom(value);
+    integrate_velocity_locked();
+    commit_pose_locked(applied_pan_, applied_tilt_);
 }
 
 void MotionController::zoom_relative(int delta) {
     std::lock_guard<std::mutex> lock(mutex_);
-    int new_value = clamp_zoom(position_->zoom + delta);
-    device_->set_control(CTRL_ZOOM_ABSOLUTE, new_value);
+    int new_value = ZoomAbsolute::clamp(position_->zoom + delta);
+    set<ZoomAbsolute>(*device_, new_value);
+    begin_zoom_slew(new_value);
     position_->update_zoom(new_value);
+    integrate_velocity_locked();
+    commit_pose_locked(applied_pan_, applied_tilt_);
+}
+
+// --- Zoom slew and field-of-view motion ---
+
+void MotionController::begin_zoom_slew(int target) {
+    ZoomModel model = zoom_model();
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(zoom_mutex_);
+    // A new command redirects the lens from wherever it has got to.
+    double elapsed = std::chrono::duration<double>(now - zoom_started_).count();
+    zoom_from_    = model.zoom_at(zoom_from_, zoom_to_, elapsed);
+    zoom_to_      = target;
+    zoom_started_ = now;
+}
+
+double MotionController::lens_zoom() const {
+    ZoomModel model = zoom_model();
+    std::lock_guard<std::mutex> lock(zoom_mutex_);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - zoom_started_).count();
+    return model.zoom_at(zoom_from_, zoom_to_, elapsed);
+}
+
+double MotionController::zoom_settle_time() const {
+    ZoomModel model = zoom_model();
+    std::lock_guard<std::mutex> lock(zoom_mutex_);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - zoom_started_).count();
+    return std::max(model.slew_time(zoom_from_, zoom_to_) - elapsed, 0.0);
+}
+
+bool MotionController::wait_zoom_settled() {
+    return wait_zoom_settled(cancel_token());
+}
+
+bool MotionController::wait_zoom_settled(uint64_t token) {
+    double remaining = zoom_settle_time();
+    if (remaining <= 0.0) {
+        return true;
+    }
+    return interruptible_sleep(remaining, token) >= remaining;
+}
+
+void MotionController::move_fov(double pan_fovs, double tilt_fovs) {
+    uint64_t token = cancel_token();
+    if (!wait_zoom_settled(token)) {
+        return;
+    }
+    constexpr double unlimited = std::numeric_limits<double>::infinity();
+    fov_move(pan_fovs, tilt_fovs, lens_zoom(), unlimited, token);
+}
+
+void MotionController::move_fov_velocity(double pan_rate, double tilt_rate,
+                                         double period) {
+    fov_move(pan_rate * period, tilt_rate * period, lens_zoom(), period,
+             cancel_token());
+}
+
+void MotionController::fov_move(double pan_fovs, double tilt_fovs, double zoom,
+                                double max_seconds, uint64_t token) {
+    ZoomModel model = zoom_model();
+    double dp = std::clamp(model.movement_seconds(Axis::Pan, pan_fovs, zoom),
+                           -max_seconds, max_seconds);
+    double dt = std::clamp(model.movement_seconds(Axis::Tilt, tilt_fovs, zoom),
+                           -max_seconds, max_seconds);
+    std::lock_guard<std::mutex> lock(mutex_);
+    move_to_locked(position_->pan + dp, position_->tilt + dt, token);
+}
+
+void MotionController::set_zoom_model(const ZoomModel& model) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    zoom_model_ = model;
+}
+
+ZoomModel MotionController::zoom_model() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return zoom_model_;
+}
+
+PtzMode MotionController::set_ptz_capabilities(const PtzCapabilities& caps, PtzMode limit) {
+    PtzMode mode = caps.mode(limit);
+    {
+        std::lock_guard<std::mutex> config_lock(config_mutex_);
+        ptz_ = caps;
+        ptz_mode_ = mode;
+    }
+    if (mode == PtzMode::Absolute) {
+        sync_position();
+    }
+    return mode;
+}
+
+PtzMode MotionController::ptz_mode() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return ptz_mode_;
+}
+
+PtzCapabilities MotionController::ptz_capabilities() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return ptz_;
+}
+
+bool MotionController::sync_position() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!sync_position_locked()) {
+        return false;
+    }
+    commit_pose_locked(applied_pan_, applied_tilt_);
+    return true;
+}
+
+bool MotionController::sync_position_locked() {
+    if (ptz_mode() != PtzMode::Absolute) {
+        return false;
+    }
+    ZoomModel model = zoom_model();
+    PtzCapabilities caps = ptz_capabilities();
+    int32_t pan, tilt;
+    try {
+        pan  = get<PanAbsolute>(*device_);
+        tilt = get<TiltAbsolute>(*device_);
+    } catch (const V4L2Error&) {
+        return false;
+    }
+    position_->pan  = pan  / (model.pan_rate  * caps.pan_absolute.units_per_degree);
+    position_->tilt = tilt / (model.tilt_rate * caps.tilt_absolute.units_per_degree);
+    return true;
+}
+
+void MotionController::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(cancel_mutex_);
+        ++cancel_seq_;
+    }
+    cancel_cv_.notify_all();
+}
+
+uint64_t MotionController::cancel_token() const {
+    std::lock_guard<std::mutex> lock(cancel_mutex_);
+    return cancel_seq_;
 }
 
 void MotionController::stop() {
+    cancel();
+    std::lock_guard<std::mutex> lock(mutex_);
+    halt_velocity_locked(false);
+    set_all<PanSpeed, TiltSpeed>(*device_, 0, 0);
+}
+
+// --- Homing ---
+
+bool MotionController::home() {
+    return home(cancel_token());
+}
+
+bool MotionController::home(uint64_t token) {
+    HomingProfile profile = homing_profile();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Seek: both axes into their stops, past the soft limits.
+    TimedMove seek;
+    seek.use_pan        = true;
+    seek.pan_speed      = PanSpeed::clamp(profile.pan_stop_dir);
+    seek.pan_duration   = profile.pan_travel + profile.overdrive;
+    seek.use_tilt       = true;
+    seek.tilt_speed     = TiltSpeed::clamp(profile.tilt_stop_dir);
+    seek.tilt_duration  = profile.tilt_travel + profile.overdrive;
+    seek.respect_limits = false;
+    seek.stalled        = profile.stall_detector;
+    seek.poll_interval  = profile.poll_interval;
+    if (!timed_move_locked(seek, token)) {
+        return false;
+    }
+
+    // The stops are a known reference, whatever the estimate said.
+    position_->pan  = profile.pan_stop();
+    position_->tilt = profile.tilt_stop();
+    commit_pose_locked(0, 0);
+
+    TimedMove center = move_toward_locked(profile.center_pan, profile.center_tilt);
+    if (!timed_move_locked(center, token)) {
+        return false;
+    }
+    position_->pan  = profile.center_pan;
+    position_->tilt = profile.center_tilt;
+    commit_pose_locked(0, 0);
+    return true;
+}
+
+void MotionController::set_homing_profile(const HomingProfile& profile) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    homing_profile_ = profile;
+}
+
+HomingProfile MotionController::homing_profile() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return homing_profile_;
+}
+
+// --- Safety watchdog ---
+
+void MotionController::heartbeat() {
+    watchdog_.heartbeat();
+}
+
+void MotionController::set_heartbeat_timeout(double seconds) {
+    watchdog_.set_heartbeat_timeout(seconds);
+}
+
+uint64_t MotionController::watchdog_expirations() const {
+    return watchdog_.expirations();
+}
+
+bool MotionController::set_realtime(const RealtimeConfig& config) {
+    std::string error;
+    if (config.enabled) {
+        // Try the scheduling on this thread so a refusal is reported now
+        // rather than silently on every move.
+        ScopedRealtime probe(config);
+        error = probe.error();
+    }
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        bool want_lock = config.enabled && config.lock_memory;
+        if (want_lock && !memory_locked_) {
+            std::string lock_error = lock_process_memory();
+            memory_locked_ = lock_error.empty();
+            if (!lock_error.empty()) {
+                error += (error.empty() ? "" : "; ") + lock_error;
+            }
+        } else if (!want_lock && memory_locked_) {
+            unlock_process_memory();
+            memory_locked_ = false;
+        }
+        realtime_ = config;
+        realtime_error_ = error;
+    }
+    {
+        std::lock_guard<std::mutex> lock(engine_mutex_);
+        engine_realtime_ = config;
+        ++realtime_epoch_;
+    }
+    engine_cv_.notify_one();
+    return error.empty();
+}
+
+RealtimeConfig MotionController::realtime() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return realtime_;
+}
+
+std::string MotionController::realtime_error() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return realtime_error_;
+}
+
+JitterStats MotionController::wake_jitter() const {
+    return jitter_.stats();
+}
+
+void MotionController::reset_wake_jitter() {
+    jitter_.reset();
+}
+
+void MotionController::force_stop() {
+    cancel();
+    {
+        std::lock_guard<std::mutex> lock(engine_mutex_);
+        desired_pan_    = 0;
+        desired_tilt_   = 0;
+        setpoint_dirty_ = true;
+    }
+    engine_cv_.notify_one();
+    try {
+        set_all<PanSpeed, TiltSpeed>(*device_, 0, 0);
+    } catch (const V4L2Error&) {
+        // The stalled mover will see the error on its own write.
+    }
+    // The stalled mover holds mutex_, so dead-reckon from the history.
+    if (auto pose = history_.pose_at(PoseHistory::now())) {
+        record_pose(pose->pan, pose->tilt, 0, 0);
+    }
+}
+
+// --- Continuous velocity mode ---
+
+void MotionController::set_velocity(int pan_dir, int tilt_dir) {
+    {
+        std::lock_guard<std::mutex> lock(engine_mutex_);
+        desired_pan_    = PanSpeed::clamp(pan_dir);
+        desired_tilt_   = TiltSpeed::clamp(tilt_dir);
+        setpoint_dirty_ = true;
+        last_update_    = std::chrono::steady_clock::now();
+        ++velocity_stats_.updates;
+        if (!engine_.joinable()) {
+            engine_ = std::thread(&MotionController::engine_loop, this);
+        }
+    }
+    engine_cv_.notify_one();
+}
+
+void MotionController::set_velocity_timeout(double seconds) {
+    {
+        std::lock_guard<std::mutex> lock(engine_mutex_);
+        velocity_timeout_ = seconds;
+    }
+    engine_cv_.notify_one();
+}
+
+double MotionController::velocity_timeout() const {
+    std::lock_guard<std::mutex> lock(engine_mutex_);
+    return velocity_timeout_;
+}
+
+VelocityStats MotionController::velocity_stats() const {
+    std::lock_guard<std::mutex> lock(engine_mutex_);
+    return velocity_stats_;
+}
+
+void MotionController::engine_loop() {
+    using clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> lock(engine_mutex_);
+    std::unique_ptr<ScopedRealtime> rt;
+    uint64_t rt_epoch = ~realtime_epoch_;
+    while (true) {
+        if (rt_epoch != realtime_epoch_) {
+            rt.reset();
+            rt = std::make_unique<ScopedRealtime>(engine_realtime_);
+            rt_epoch = realtime_epoch_;
+        }
+        auto woken = [&] {
+            return engine_exit_ || setpoint_dirty_ || rt_epoch != realtime_epoch_;
+        };
+        bool active = desired_pan_ != 0 || desired_tilt_ != 0;
+        auto timeout_at = active
+            ? last_update_ + std::chrono::duration_cast<clock::duration>(
+                  std::chrono::duration<double>(velocity_timeout_))
+            : clock::time_point::max();
+        auto wake_at = std::min(timeout_at, limit_deadline_);
+        if (wake_at != clock::time_point::max()) {
+            double spin = engine_realtime_.enabled ? engine_realtime_.spin : 0.0;
+            wait_until_precise(lock, engine_cv_, wake_at, spin, woken);
+        } else {
+            engine_cv_.wait(lock, woken);
+        }
+        if (engine_exit_) {
+            break;
+        }
+        if (!setpoint_dirty_) {
+            auto now = clock::now();
+            if (active && now >= timeout_at) {
+                // Updates stopped arriving: the caller stalled or died.
+                desired_pan_  = 0;
+                desired_tilt_ = 0;
+                ++velocity_stats_.timeouts;
+            } else if (now < limit_deadline_) {
+                continue;  // halted or rescheduled while we waited
+            }
+            // Otherwise a soft limit is due: re-applying the setpoint
+            // stops the axis that reached it.
+        }
+        setpoint_dirty_ = false;
+        int pan_speed  = desired_pan_;
+        int tilt_speed = desired_tilt_;
+        uint64_t epoch = velocity_epoch_;
+
+        lock.unlock();
+        try {
+            apply_velocity(pan_speed, tilt_speed, epoch);
+        } catch (const V4L2Error&) {
+            // Leave applied state unchanged; the next setpoint retries.
+        }
+        lock.lock();
+    }
+}
+
+void MotionController::apply_velocity(int pan_speed, int tilt_speed,
+                                      uint64_t epoch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    {
+        std::lock_guard<std::mutex> engine_lock(engine_mutex_);
+        if (epoch != velocity_epoch_) {
+            return;  // a timed move or stop() ended velocity mode
+        }
+    }
+    integrate_velocity_locked();
+
+    // Never drive an axis past its soft limit.
+    uint64_t limit_stops = 0;
+    if (pan_speed != 0 && position_->time_to_pan_limit(pan_speed) <= LIMIT_EPSILON) {
+        limit_stops += applied_pan_ != 0;
+        pan_speed = 0;
+    }
+    if (tilt_speed != 0 && position_->time_to_tilt_limit(tilt_speed) <= LIMIT_EPSILON) {
+        limit_stops += applied_tilt_ != 0;
+        tilt_speed = 0;
+    }
+
+    uint64_t writes = 0;
+    ControlBatch<PanSpeed, TiltSpeed> batch;
+    if (pan_speed != applied_pan_) {
+        batch.set<PanSpeed>(pan_speed);
+        ++writes;
+    }
+    if (tilt_speed != applied_tilt_) {
+        batch.set<TiltSpeed>(tilt_speed);
+        ++writes;
+    }
+    batch.apply(*device_);
+    applied_pan_  = pan_speed;
+    applied_tilt_ = tilt_speed;
+    // Schedule a stop at the earliest predicted limit crossing.
+    double until_limit = std::min(position_->time_to_pan_limit(applied_pan_),
+                                  position_->time_to_tilt_limit(applied_tilt_));
+
+    if (writes > 0) {
+        commit_pose_locked(applied_pan_, applied_tilt_);
+    }
+
+    std::lock_guard<std::mutex> engine_lock(engine_mutex_);
+    velocity_stats_.writes += writes;
+    velocity_stats_.limit_stops += limit_stops;
+    limit_deadline_ = std::isinf(until_limit)
+        ? std::chrono::steady_clock::time_point::max()
+        : applied_since_ + std::chrono::duration_cast<
+              std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(until_limit));
+}
+
+void MotionController::integrate_velocity_locked() {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - applied_since_).count();
+    if (applied_pan_ != 0)  position_->update_pan(applied_pan_, elapsed);
+    if (applied_tilt_ != 0) position_->update_tilt(applied_tilt_, elapsed);
+    applied_since_ = now;
+    if (applied_pan_ != 0 || applied_tilt_ != 0) {
+        published_.store(*position_);
+    }
+}
+
+void MotionController::halt_velocity_locked(bool write_stop) {
+    {
+        std::lock_guard<std::mutex> engine_lock(engine_mutex_);
+        ++velocity_epoch_;
+        desired_pan_    = 0;
+        desired_tilt_   = 0;
+        setpoint_dirty_ = false;
+        limit_deadline_ = std::chrono::steady_clock::time_point::max();
+    }
+    if (applied_pan_ == 0 && applied_tilt_ == 0) {
+        return;
+    }
+    integrate_velocity_locked();
+    if (write_stop) {
+        ControlBatch<PanSpeed, TiltSpeed> stops;
+        if (applied_pan_ != 0)  stops.set<PanSpeed>(0);
+        if (applied_tilt_ != 0) stops.set<TiltSpeed>(0);
+        stops.apply(*device_);
+    }
+    applied_pan_  = 0;
+    applied_tilt_ = 0;
+    commit_pose_locked(0, 0);
+}
+
+// --- Pose history ---
+
+void MotionController::record_pose(double pan, double tilt,
+                                   int pan_speed, int tilt_speed) {
+    ZoomModel model = zoom_model();
+    PoseSample sample;
+    sample.timestamp  = PoseHistory::now();
+    sample.pan        = pan;
+    sample.tilt       = tilt;
+    sample.pan_speed  = static_cast<int8_t>(pan_speed);
+    sample.tilt_speed = static_cast<int8_t>(tilt_speed);
+    {
+        std::lock_guard<std::mutex> lock(zoom_mutex_);
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - zoom_started_).count();
+        sample.zoom        = model.zoom_at(zoom_from_, zoom_to_, elapsed);
+        sample.zoom_target = static_cast<int32_t>(zoom_to_);
+    }
+    if (sample.zoom != sample.zoom_target) {
+        sample.zoom_rate = sample.zoom < sample.zoom_target ? model.slew_rate
+                                                            : -model.slew_rate;
+    }
+    history_.record(sample);
+}
+
+void MotionController::commit_pose_locked(int pan_speed, int tilt_speed) {
+    published_.store(*position_);
+    record_pose(position_->pan, position_->tilt, pan_speed, tilt_speed);
+}
+
+PositionTracker MotionController::snapshot() const {
+    return published_.load();
+}
+
+std::optional<PoseSample> MotionController::pose_at(double t) const {
+    return history_.pose_at(t);
+}
+
+const PoseHistory& MotionController::pose_history() const {
+    return history_;
+}
+
+void MotionController::reset_position() {
     std::lock_guard<std::mutex> lock(mutex_);
-    device_->set_control(CTRL_PAN_SPEED, 0);
-    device_->set_control(CTRL_TILT_SPEED, 0);
+    halt_velocity_locked(true);
+    position_->reset();
+    commit_pose_locked(0, 0);
 }
 
 PositionTracker& MotionController::position() {
@@ -0,0 +1,132 @@
+#include "bcc950/pose_history.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace bcc950 {
+
+namespace {
+
+std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // anonymous namespace
+
+PoseHistory::PoseHistory(std::size_t capacity)
+    : mask_(round_up_pow2(std::max<std::size_t>(capacity, 2)) - 1)
+    , slots_(new SeqLock<Slot>[mask_ + 1]) {
+}
+
+double PoseHistory::now() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PoseHistory::record(const PoseSample& sample) {
+    uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    slots_[index & mask_].store(Slot{index + 1, sample});
+}
+
+bool PoseHistory::read(uint64_t index, PoseSample& out) const {
+    Slot slot;
+    if (!slots_[index & mask_].try_load(slot) || slot.index != index + 1) {
+        return false;
+    }
+    out = slot.sample;
+    return true;
+}
+
+std::optional<PoseSample> PoseHistory::latest() const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > capacity() ? head - capacity() : 0;
+    for (uint64_t i = head; i-- > oldest;) {
+        PoseSample s;
+        if (read(i, s)) {
+            return s;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<PoseSample> PoseHistory::pose_at(double t) const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > capacity() ? head - capacity() : 0;
+
+    // Walk back from the newest sample to the one at or before t. Slots
+    // mid-write or already overwritten are skipped.
+    std::optional<PoseSample> after;
+    for (uint64_t i = head; i-- > oldest;) {
+        PoseSample s;
+        if (!read(i, s)) {
+            continue;
+        }
+        if (s.timestamp > t) {
+            after = s;
+            continue;
+        }
+        PoseSample pose = extrapolate(s, t);
+        if (after) {
+            double span = after->timestamp - s.timestamp;
+            double f = span > 0.0 ? (t - s.timestamp) / span : 1.0;
+            pose.pan  = s.pan  + (after->pan  - s.pan)  * f;
+            pose.tilt = s.tilt + (after->tilt - s.tilt) * f;
+        }
+        return pose;
+    }
+    return std::nullopt;
+}
+
+std::vector<PoseSample> PoseHistory::samples() const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > capacity() ? head - capacity() : 0;
+    std::vector<PoseSample> out;
+    out.reserve(static_cast<std::size_t>(head - oldest));
+    for (uint64_t i = oldest; i < head; ++i) {
+        PoseSample s;
+        if (read(i, s)) {
+            out.push_back(s);
+        }
+    }
+    return out;
+}
+
+std::vector<PoseSample> PoseHistory::samples_between(double t0, double t1) const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > capacity() ? head - capacity() : 0;
+    std::vector<PoseSample> out;
+    for (uint64_t i = head; i-- > oldest;) {
+        PoseSample s;
+        if (!read(i, s) || s.timestamp > t1) {
+            continue;
+        }
+        out.push_back(s);
+        if (s.timestamp <= t0) {
+            break;
+        }
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+PoseSample extrapolate(const PoseSample& from, double t) {
+    double dt = std::max(t - from.timestamp, 0.0);
+    PoseSample pose = from;
+    pose.timestamp = t;
+    pose.pan  += from.pan_speed  * dt;
+    pose.tilt += from.tilt_speed * dt;
+    if (from.zoom_rate != 0.0) {
+        double target = from.zoom_target;
+        double zoom = from.zoom + from.zoom_rate * dt;
+        bool arrived = from.zoom_rate > 0.0 ? zoom >= target : zoom <= target;
+        pose.zoom      = arrived ? target : zoom;
+        pose.zoom_rate = arrived ? 0.0 : from.zoom_rate;
+    }
+    return pose;
+}
+
+} // namespace bcc950
@@ -2,9 +2,23 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
 
 namespace bcc950 {
 
+namespace {
+
+double time_to_limit(double value, double lo, double hi, int speed) {
+    if (speed == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double remaining = speed > 0 ? hi - value : value - lo;
+    return std::max(remaining, 0.0) / std::abs(speed);
+}
+
+} // anonymous namespace
+
 void PositionTracker::update_pan(int speed, double duration) {
     pan += speed * duration;
     pan = std::clamp(pan, pan_min, pan_max);
@@ -19,6 +33,14 @@ void PositionTracker::update_zoom(int value) {
     zoom = std::clamp(value, ZOOM_MIN, ZOOM_MAX);
 }
 
+double PositionTracker::time_to_pan_limit(int speed) const {
+    return time_to_limit(pan, pan_min, pan_max, speed);
+}
+
+double PositionTracker::time_to_tilt_limit(int speed) const {
+    return time_to_limit(tilt, tilt_min, tilt_max, speed);
+}
+
 double PositionTracker::distance_to(const PositionTracker& other) const {
     double dp = pan - other.pan;
     double dt = tilt - other.tilt;
@@ -0,0 +1,95 @@
+#include "bcc950/ptz_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bcc950 {
+
+namespace {
+
+PtzControl probe_control(IV4L2Device& device, uint32_t id) {
+    PtzControl control;
+    struct v4l2_queryctrl q{};
+    try {
+        q = device.query_control(id);
+    } catch (const V4L2Error&) {
+        return control;  // not in the catalog
+    }
+    const uint32_t unusable = V4L2_CTRL_FLAG_DISABLED | V4L2_CTRL_FLAG_READ_ONLY |
+                              V4L2_CTRL_FLAG_INACTIVE;
+    if ((q.flags & unusable) || q.type != V4L2_CTRL_TYPE_INTEGER || q.maximum <= q.minimum) {
+        return control;
+    }
+    control.supported = true;
+    control.minimum = q.minimum;
+    control.maximum = q.maximum;
+    control.step = std::max(q.step, 1);
+    return control;
+}
+
+PtzControl probe_relative(IV4L2Device& device, uint32_t id, double travel_degrees) {
+    PtzControl control = probe_control(device, id);
+    double reach = std::max(std::abs(static_cast<double>(control.minimum)),
+                            std::abs(static_cast<double>(control.maximum)));
+    if (control.supported) {
+        control.units_per_degree = reach / travel_degrees;
+    }
+    return control;
+}
+
+} // anonymous namespace
+
+int32_t PtzControl::clamp(double value) const {
+    double steps = std::round((value - minimum) / step);
+    double v = minimum + steps * step;
+    return static_cast<int32_t>(std::clamp(v, static_cast<double>(minimum),
+                                           static_cast<double>(maximum)));
+}
+
+PtzMode PtzCapabilities::mode(PtzMode limit) const {
+    if (limit >= PtzMode::Absolute && pan_absolute.supported && tilt_absolute.supported) {
+        return PtzMode::Absolute;
+    }
+    if (limit >= PtzMode::Relative && pan_relative.supported && tilt_relative.supported) {
+        return PtzMode::Relative;
+    }
+    return PtzMode::Velocity;
+}
+
+PtzCapabilities probe_ptz(IV4L2Device& device) {
+    PtzCapabilities caps;
+    caps.pan_absolute  = probe_control(device, CTRL_PAN_ABSOLUTE);
+    caps.tilt_absolute = probe_control(device, CTRL_TILT_ABSOLUTE);
+    caps.pan_relative  = probe_relative(device, CTRL_PAN_RELATIVE, PTZ_PAN_TRAVEL_DEG);
+    caps.tilt_relative = probe_relative(device, CTRL_TILT_RELATIVE, PTZ_TILT_TRAVEL_DEG);
+    return caps;
+}
+
+void set_relative_scale(PtzCapabilities& caps, double units_per_degree) {
+    if (units_per_degree <= 0.0) {
+        return;
+    }
+    caps.pan_relative.units_per_degree  = units_per_degree;
+    caps.tilt_relative.units_per_degree = units_per_degree;
+}
+
+PtzMode parse_ptz_mode(const std::string& value) {
+    if (value == "velocity") {
+        return PtzMode::Velocity;
+    }
+    if (value == "relative") {
+        return PtzMode::Relative;
+    }
+    return PtzMode::Absolute;
+}
+
+const char* ptz_mode_name(PtzMode mode) {
+    switch (mode) {
+    case PtzMode::Velocity: return "velocity";
+    case PtzMode::Relative: return "relative";
+    case PtzMode::Absolute: return "absolute";
+    }
+    return "velocity";
+}
+
+} // namespace bcc950
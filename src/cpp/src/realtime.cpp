@@ -0,0 +1,136 @@
+#include "bcc950/realtime.hpp"
+
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace bcc950 {
+
+ScopedRealtime::ScopedRealtime(const RealtimeConfig& config) {
+    if (!config.enabled) {
+        return;
+    }
+    pthread_t self = pthread_self();
+    if (config.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config.cpu, &cpus);
+        int err = pthread_getaffinity_np(self, sizeof(old_cpus_), &old_cpus_);
+        if (err == 0) {
+            err = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+        }
+        if (err == 0) {
+            pinned_ = true;
+        } else {
+            error_ = std::string("pin to CPU ") + std::to_string(config.cpu) + ": " +
+                     std::strerror(err);
+        }
+    }
+
+    int err = pthread_getschedparam(self, &old_policy_, &old_param_);
+    if (err == 0) {
+        sched_param param{};
+        param.sched_priority = std::clamp(config.priority, sched_get_priority_min(SCHED_FIFO),
+                                          sched_get_priority_max(SCHED_FIFO));
+        err = pthread_setschedparam(self, SCHED_FIFO, &param);
+    }
+    if (err == 0) {
+        scheduled_ = true;
+    } else {
+        if (!error_.empty()) {
+            error_ += "; ";
+        }
+        error_ += std::string("SCHED_FIFO: ") + std::strerror(err);
+    }
+}
+
+ScopedRealtime::~ScopedRealtime() {
+    pthread_t self = pthread_self();
+    if (scheduled_) {
+        pthread_setschedparam(self, old_policy_, &old_param_);
+    }
+    if (pinned_) {
+        pthread_setaffinity_np(self, sizeof(old_cpus_), &old_cpus_);
+    }
+}
+
+std::string lock_process_memory() {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        return std::string("mlockall: ") + std::strerror(errno);
+    }
+    return {};
+}
+
+void unlock_process_memory() {
+    munlockall();
+}
+
+double JitterStats::bucket_limit(std::size_t i) {
+    if (i + 1 >= JitterHistogram::BUCKETS) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::ldexp(1e-6, static_cast<int>(i));
+}
+
+double JitterStats::quantile(double q) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count);
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > 0 && static_cast<double>(seen) >= rank) {
+            return bucket_limit(i);
+        }
+    }
+    return bucket_limit(buckets.size() - 1);
+}
+
+void JitterHistogram::record(double late) {
+    uint64_t ns = late > 0.0 ? static_cast<uint64_t>(late * 1e9) : 0;
+    uint64_t us = ns / 1000;
+    std::size_t i = 0;
+    if (us > 0) {
+        // 1 + floor(log2(us)): [1, 2) µs is bucket 1, [2, 4) bucket 2...
+        i = static_cast<std::size_t>(64 - __builtin_clzll(us));
+    }
+    i = std::min(i, BUCKETS - 1);
+    buckets_[i].fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+    }
+}
+
+JitterStats JitterHistogram::stats() const {
+    JitterStats s;
+    s.buckets.resize(BUCKETS);
+    uint64_t total = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += s.buckets[i];
+    }
+    s.count = total;
+    if (total > 0) {
+        s.mean = static_cast<double>(total_ns_.load(std::memory_order_relaxed)) * 1e-9 /
+                 static_cast<double>(total);
+        s.max = static_cast<double>(max_ns_.load(std::memory_order_relaxed)) * 1e-9;
+    }
+    return s;
+}
+
+void JitterHistogram::reset() {
+    for (auto& b : buckets_) {
+        b.store(0, std::memory_order_relaxed);
+    }
+    total_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace bcc950
@@ -0,0 +1,544 @@
+#include "bcc950/recorder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef BCC950_HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+namespace bcc950 {
+
+namespace {
+
+std::size_t round_up(std::size_t n, std::size_t alignment) {
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+[[noreturn]] void fail_errno(const std::string& what, int err) {
+    throw std::runtime_error(what + ": " + std::strerror(err));
+}
+
+/// pwrite all of `len` bytes. If the filesystem rejects O_DIRECT only
+/// at write time (EINVAL), drop the flag and retry buffered.
+void pwrite_all(int fd, const uint8_t* data, std::size_t len, uint64_t offset) {
+    while (len > 0) {
+        ssize_t n = ::pwrite(fd, data, len, static_cast<off_t>(offset));
+        if (n < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+            int flags = ::fcntl(fd, F_GETFL);
+            if (err == EINVAL && flags >= 0 && (flags & O_DIRECT) &&
+                ::fcntl(fd, F_SETFL, flags & ~O_DIRECT) == 0) {
+                continue;
+            }
+            fail_errno("Recording write failed", err);
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+void write_all(int fd, const void* data, std::size_t len) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = ::write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail_errno("Recording index write failed", errno);
+        }
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+}
+
+/// Aligned staging chunks and the writes that drain them. Chunks are
+/// filled and submitted in order; with io_uring up to `depth` are in
+/// flight while the next one fills, otherwise each is written with
+/// pwrite on submit.
+class ChunkWriter {
+public:
+    ChunkWriter(int fd, std::size_t chunk_bytes, std::size_t depth)
+        : fd_(fd), chunk_bytes_(chunk_bytes) {
+        chunks_.resize(std::max<std::size_t>(depth, 1));
+        for (Chunk& c : chunks_) {
+            c.data = static_cast<uint8_t*>(
+                ::operator new(chunk_bytes_, std::align_val_t(RECORD_ALIGNMENT)));
+        }
+#ifdef BCC950_HAVE_LIBURING
+        uring_ = chunks_.size() > 1 &&
+                 io_uring_queue_init(static_cast<unsigned>(chunks_.size()), &ring_, 0) == 0;
+#endif
+    }
+
+    ~ChunkWriter() {
+        // The kernel may still be reading the buffers.
+        try {
+            drain();
+        } catch (const std::exception&) {
+        }
+#ifdef BCC950_HAVE_LIBURING
+        if (uring_) {
+            io_uring_queue_exit(&ring_);
+        }
+#endif
+        for (Chunk& c : chunks_) {
+            ::operator delete(c.data, std::align_val_t(RECORD_ALIGNMENT));
+        }
+    }
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    /// The chunk being filled; never in flight.
+    uint8_t* buffer() { return chunks_[next_].data; }
+
+    /// Write the first `len` bytes of the current chunk at `offset` and
+    /// move on to the next chunk, waiting for it to be free.
+    void submit(std::size_t len, uint64_t offset) {
+        Chunk& c = chunks_[next_];
+        c.len = len;
+        c.offset = offset;
+#ifdef BCC950_HAVE_LIBURING
+        if (uring_) {
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+            if (!sqe) {
+                throw std::runtime_error("io_uring submission queue full");
+            }
+            io_uring_prep_write(sqe, fd_, c.data, static_cast<unsigned>(len), offset);
+            io_uring_sqe_set_data(sqe, &c);
+            int r = io_uring_submit(&ring_);
+            if (r < 0) {
+                fail_errno("io_uring submit failed", -r);
+            }
+            c.in_flight = true;
+        } else
+#endif
+        {
+            pwrite_all(fd_, c.data, len, offset);
+        }
+        next_ = (next_ + 1) % chunks_.size();
+        while (chunks_[next_].in_flight) {
+            reap(true);
+        }
+    }
+
+    /// Wait for every submitted chunk.
+    void drain() {
+        for (const Chunk& c : chunks_) {
+            while (c.in_flight) {
+                reap(true);
+            }
+        }
+    }
+
+    /// Offset below which everything submitted is written, given that
+    /// `submitted_end` bytes have been submitted.
+    uint64_t durable_end(uint64_t submitted_end) {
+        while (reap(false)) {
+        }
+        uint64_t end = submitted_end;
+        for (const Chunk& c : chunks_) {
+            if (c.in_flight) {
+                end = std::min(end, c.offset);
+            }
+        }
+        return end;
+    }
+
+    bool uses_io_uring() const { return uring_; }
+    std::size_t chunk_bytes() const { return chunk_bytes_; }
+
+private:
+    struct Chunk {
+        uint8_t*    data = nullptr;
+        std::size_t len = 0;
+        uint64_t    offset = 0;
+        bool        in_flight = false;
+    };
+
+    int                fd_;
+    std::size_t        chunk_bytes_;
+    std::vector<Chunk> chunks_;
+    std::size_t        next_ = 0;
+    bool               uring_ = false;
+#ifdef BCC950_HAVE_LIBURING
+    io_uring           ring_{};
+#endif
+
+    /// Retire one completion. Short or failed writes (e.g. EINVAL from
+    /// O_DIRECT) are finished with pwrite. Returns false if `wait` is
+    /// false and nothing has completed.
+    bool reap(bool wait) {
+#ifdef BCC950_HAVE_LIBURING
+        if (!uring_) {
+            return false;
+        }
+        io_uring_cqe* cqe = nullptr;
+        int r;
+        do {
+            r = wait ? io_uring_wait_cqe(&ring_, &cqe) : io_uring_peek_cqe(&ring_, &cqe);
+        } while (r == -EINTR);
+        if (r < 0 || !cqe) {
+            if (wait) {
+                fail_errno("io_uring wait failed", -r);
+            }
+            return false;
+        }
+        auto* c = static_cast<Chunk*>(io_uring_cqe_get_data(cqe));
+        int res = cqe->res;
+        io_uring_cqe_seen(&ring_, cqe);
+        c->in_flight = false;
+        if (res != static_cast<int>(c->len)) {
+            std::size_t done = res > 0 ? static_cast<std::size_t>(res) : 0;
+            pwrite_all(fd_, c->data + done, c->len - done, c->offset + done);
+        }
+        return true;
+#else
+        (void)wait;
+        return false;
+#endif
+    }
+};
+
+} // anonymous namespace
+
+struct Recorder::Segment {
+    std::string base;
+    int         data_fd = -1;
+    int         index_fd = -1;
+    double      first_timestamp = 0.0;
+    uint64_t    size = 0;          // JPEG bytes appended
+    uint64_t    chunk_offset = 0;  // file offset of the chunk being filled
+    uint64_t    synced = 0;        // data bytes known to be on stable storage
+    std::size_t fill = 0;          // bytes in that chunk
+    std::unique_ptr<ChunkWriter> writer;
+    std::deque<RecordIndexEntry> pending;  // waiting for their bytes to land
+
+    ~Segment() {
+        writer.reset();
+        if (data_fd >= 0) {
+            ::close(data_fd);
+        }
+        if (index_fd >= 0) {
+            ::close(index_fd);
+        }
+    }
+
+    void append(const uint8_t* data, std::size_t len) {
+        const std::size_t chunk = writer->chunk_bytes();
+        while (len > 0) {
+            std::size_t take = std::min(len, chunk - fill);
+            std::memcpy(writer->buffer() + fill, data, take);
+            fill += take;
+            data += take;
+            len -= take;
+            if (fill == chunk) {
+                writer->submit(chunk, chunk_offset);
+                chunk_offset += chunk;
+                fill = 0;
+            }
+        }
+        size = chunk_offset + fill;
+    }
+};
+
+Recorder::Recorder(const RecorderConfig& config, const PoseHistory* history)
+    : config_(config), history_(history) {
+    config_.chunk_bytes = round_up(std::max<std::size_t>(config_.chunk_bytes, 1),
+                                   RECORD_ALIGNMENT);
+    config_.queue_frames = std::max<std::size_t>(config_.queue_frames, 1);
+}
+
+Recorder::~Recorder() {
+    stop();
+}
+
+bool Recorder::io_uring_supported() {
+#ifdef BCC950_HAVE_LIBURING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Recorder::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    exit_ = false;
+    retry_at_ = {};  // a restart tries the disk again at once
+    retry_delay_ = RECORD_RETRY_MIN;
+    thread_ = std::thread(&Recorder::run, this);
+}
+
+void Recorder::stop() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exit_ = true;
+        thread.swap(thread_);
+    }
+    cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool Recorder::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return thread_.joinable() && !exit_;
+}
+
+bool Recorder::write(FramePtr frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!frame || !thread_.joinable() || exit_) {
+            return false;
+        }
+        if (queue_.size() >= config_.queue_frames) {
+            ++stats_.dropped;
+            return false;
+        }
+        queue_.push_back(std::move(frame));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void Recorder::rotate() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rotate_ = true;
+    }
+    cv_.notify_one();
+}
+
+RecorderStats Recorder::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RecorderStats s = stats_;
+    s.dropped += lost_;
+    return s;
+}
+
+std::vector<std::string> Recorder::segments() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_;
+}
+
+std::string Recorder::last_error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_error_;
+}
+
+void Recorder::run() {
+    for (;;) {
+        FramePtr frame;
+        bool rotate = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return exit_ || rotate_ || !queue_.empty(); });
+            if (exit_ && queue_.empty()) {
+                break;
+            }
+            rotate = std::exchange(rotate_, false);
+            if (!queue_.empty()) {
+                frame = std::move(queue_.front());
+                queue_.pop_front();
+                ++taken_;
+            }
+        }
+        try {
+            if (rotate && segment_) {
+                close_segment();
+            }
+            if (frame) {
+                record(*frame);
+            }
+        } catch (const std::exception& e) {
+            fail(e.what());
+        }
+    }
+    try {
+        if (segment_) {
+            close_segment();
+        }
+    } catch (const std::exception& e) {
+        fail(e.what());
+    }
+}
+
+void Recorder::record(const Frame& frame) {
+    if (segment_) {
+        bool full = segment_->size > 0 &&
+                    segment_->size + frame.size() > config_.max_segment_bytes;
+        bool old = frame.timestamp() - segment_->first_timestamp >= config_.max_segment_seconds;
+        if (full || old) {
+            close_segment();
+        }
+    }
+    if (!segment_) {
+        if (std::chrono::steady_clock::now() < retry_at_) {
+            // Backing off after a failure: drop rather than churn files.
+            std::lock_guard<std::mutex> lock(mutex_);
+            lost_ = taken_ - stats_.frames;
+            return;
+        }
+        open_segment(frame.timestamp());
+    }
+
+    RecordIndexEntry e{};
+    e.sequence = frame.sequence();
+    e.timestamp = frame.timestamp();
+    e.offset = segment_->size;
+    e.size = static_cast<uint32_t>(frame.size());
+    e.width = static_cast<uint16_t>(frame.width());
+    e.height = static_cast<uint16_t>(frame.height());
+    e.motion = static_cast<uint8_t>(frame.motion());
+    if (history_) {
+        if (std::optional<PoseSample> pose = history_->pose_at(frame.timestamp())) {
+            e.pan = pose->pan;
+            e.tilt = pose->tilt;
+            e.zoom = pose->zoom;
+            e.pan_speed = pose->pan_speed;
+            e.tilt_speed = pose->tilt_speed;
+            e.flags |= RECORD_FLAG_POSE_VALID;
+        }
+    }
+    segment_->pending.push_back(e);
+    segment_->append(frame.data(), frame.size());
+    flush_index(false);
+}
+
+void Recorder::open_segment(double timestamp) {
+    auto seg = std::make_unique<Segment>();
+    seg->first_timestamp = timestamp;
+
+    // Claim the next free index; the index file is created exclusively.
+    std::string index_path;
+    for (;;) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "_%06u", next_index_++);
+        seg->base = config_.directory + "/" + config_.prefix + name;
+        index_path = seg->base + ".idx";
+        seg->index_fd = ::open(index_path.c_str(),
+                               O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (seg->index_fd >= 0) {
+            break;
+        }
+        if (errno != EEXIST) {
+            fail_errno("Cannot create " + index_path, errno);
+        }
+    }
+
+    std::string path = seg->base + ".mjpg";
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    seg->data_fd = config_.direct_io ? ::open(path.c_str(), flags | O_DIRECT, 0644) : -1;
+    if (seg->data_fd < 0) {
+        // tmpfs and some network filesystems refuse O_DIRECT.
+        seg->data_fd = ::open(path.c_str(), flags, 0644);
+    }
+    if (seg->data_fd < 0) {
+        int err = errno;
+        ::unlink(index_path.c_str());  // no half-made pair left behind
+        fail_errno("Cannot create " + path, err);
+    }
+
+    RecordIndexHeader header{};
+    std::memcpy(header.magic, RECORD_INDEX_MAGIC, sizeof(header.magic));
+    header.version = RECORD_INDEX_VERSION;
+    header.entry_size = sizeof(RecordIndexEntry);
+    try {
+        write_all(seg->index_fd, &header, sizeof(header));
+    } catch (const std::exception&) {
+        ::unlink(index_path.c_str());
+        ::unlink(path.c_str());
+        throw;
+    }
+
+    seg->writer = std::make_unique<ChunkWriter>(seg->data_fd, config_.chunk_bytes,
+                                                config_.queue_depth);
+    segment_ = std::move(seg);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.segments;
+    segments_.push_back(segment_->base);
+}
+
+void Recorder::close_segment() {
+    Segment& seg = *segment_;
+    if (seg.fill > 0) {
+        // O_DIRECT writes whole blocks; pad the tail, then cut it off.
+        std::size_t padded = round_up(seg.fill, RECORD_ALIGNMENT);
+        std::memset(seg.writer->buffer() + seg.fill, 0, padded - seg.fill);
+        seg.writer->submit(padded, seg.chunk_offset);
+        seg.chunk_offset += seg.fill;
+        seg.fill = 0;
+    }
+    seg.writer->drain();
+    if (::ftruncate(seg.data_fd, static_cast<off_t>(seg.size)) < 0) {
+        fail_errno("Cannot truncate " + seg.base + ".mjpg", errno);
+    }
+    flush_index(true);
+    segment_.reset();
+}
+
+void Recorder::flush_index(bool all) {
+    Segment& seg = *segment_;
+    uint64_t durable = all ? seg.size : seg.writer->durable_end(seg.chunk_offset);
+    std::vector<RecordIndexEntry> ready;
+    while (!seg.pending.empty() &&
+           seg.pending.front().offset + seg.pending.front().size <= durable) {
+        ready.push_back(seg.pending.front());
+        seg.pending.pop_front();
+    }
+    if (ready.empty()) {
+        return;
+    }
+    // The entries may reach the disk before the data they describe, so
+    // make the data stable first.
+    uint64_t end = ready.back().offset + ready.back().size;
+    if (end > seg.synced) {
+        if (::fdatasync(seg.data_fd) < 0) {
+            fail_errno("Cannot sync " + seg.base + ".mjpg", errno);
+        }
+        seg.synced = durable;
+    }
+    write_all(seg.index_fd, ready.data(), ready.size() * sizeof(RecordIndexEntry));
+    retry_delay_ = RECORD_RETRY_MIN;  // recording works again
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.frames += ready.size();
+    for (const RecordIndexEntry& e : ready) {
+        stats_.bytes += e.size;
+    }
+}
+
+void Recorder::fail(const std::string& message) {
+    // Abandon the segment; what is indexed so far stays readable.
+    segment_.reset();
+    retry_at_ = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(retry_delay_));
+    retry_delay_ = std::min(retry_delay_ * 2.0, RECORD_RETRY_MAX);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.errors;
+    last_error_ = message;
+    lost_ = taken_ - stats_.frames;
+}
+
+} // namespace bcc950
@@ -0,0 +1,260 @@
+#include "bcc950/replay_source.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bcc950 {
+
+namespace {
+
+// Spacing kept between the last frame before a seek or loop and the
+// first one after it on the rebased timeline.
+constexpr double REANCHOR_GAP = 1e-3;
+
+} // anonymous namespace
+
+/// A read-only mapping of one file.
+struct ReplaySource::Mapping {
+    const uint8_t* data = nullptr;
+    std::size_t    size = 0;
+
+    explicit Mapping(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) < 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path + ": " + std::strerror(err));
+        }
+        size = static_cast<std::size_t>(st.st_size);
+        if (size > 0) {
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path + ": " + std::strerror(err));
+            }
+            data = static_cast<const uint8_t*>(addr);
+        }
+        ::close(fd);
+    }
+
+    ~Mapping() {
+        if (data) {
+            ::munmap(const_cast<uint8_t*>(data), size);
+        }
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+};
+
+ReplaySource::ReplaySource(const std::vector<std::string>& segments,
+                           const ReplayConfig& config)
+    : config_(config) {
+    config_.speed = std::max(config_.speed, 0.0);
+    for (const std::string& base : segments) {
+        load(base);
+    }
+    // Segments are in recording order already; this only guards against
+    // callers listing them out of order.
+    std::stable_sort(items_.begin(), items_.end(), [](const Item& a, const Item& b) {
+        return a.entry->timestamp < b.entry->timestamp;
+    });
+}
+
+ReplaySource::~ReplaySource() = default;
+
+void ReplaySource::load(const std::string& base) {
+    auto index = std::make_unique<Mapping>(base + ".idx");
+    auto frames = std::make_unique<Mapping>(base + ".mjpg");
+
+    RecordIndexHeader header{};
+    if (index->size >= sizeof(header)) {
+        std::memcpy(&header, index->data, sizeof(header));
+    }
+    if (index->size < sizeof(header) ||
+        std::memcmp(header.magic, RECORD_INDEX_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a recording index: " + base + ".idx");
+    }
+    if (header.version != RECORD_INDEX_VERSION ||
+        header.entry_size != sizeof(RecordIndexEntry)) {
+        throw std::runtime_error("Unsupported recording index version " +
+                                 std::to_string(header.version) + ": " + base + ".idx");
+    }
+
+    // The header is 16 bytes, so entries are 8-byte aligned in the map.
+    const auto* entries = reinterpret_cast<const RecordIndexEntry*>(index->data + sizeof(header));
+    const std::size_t count = (index->size - sizeof(header)) / sizeof(RecordIndexEntry);
+    for (std::size_t i = 0; i < count; ++i) {
+        const RecordIndexEntry& e = entries[i];
+        if (e.offset > frames->size || e.size > frames->size - e.offset) {
+            break;  // bytes never made it to disk
+        }
+        items_.push_back(Item{&e, frames->data});
+    }
+    mappings_.push_back(std::move(index));
+    mappings_.push_back(std::move(frames));
+}
+
+std::vector<std::string> ReplaySource::find_segments(const std::string& directory,
+                                                     const std::string& prefix) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> out;
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory, ec)) {
+        const fs::path& path = entry.path();
+        std::string stem = path.stem().string();
+        if (path.extension() == ".idx" && stem.rfind(prefix + "_", 0) == 0) {
+            out.push_back((path.parent_path() / stem).string());
+        }
+    }
+    if (ec) {
+        throw std::runtime_error("Cannot list " + directory + ": " + ec.message());
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void ReplaySource::reanchor_locked() {
+    double now = PoseHistory::now();
+    anchor_recorded_ = items_[cursor_].entry->timestamp;
+    anchor_wall_ = now;
+    anchor_emitted_ = last_emitted_ > 0.0 ? std::max(now, last_emitted_ + REANCHOR_GAP) : now;
+    anchored_ = true;
+}
+
+FramePtr ReplaySource::read(double timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const double deadline = PoseHistory::now() + timeout;
+
+    for (;;) {
+        const uint64_t generation = generation_;
+        auto changed = [&] { return generation_ != generation; };
+        double now = PoseHistory::now();
+
+        if (cursor_ >= items_.size()) {
+            if (config_.loop && !items_.empty()) {
+                cursor_ = 0;
+                anchored_ = false;
+                continue;
+            }
+            if (now >= deadline) {
+                return nullptr;
+            }
+            cv_.wait_for(lock, std::chrono::duration<double>(deadline - now), changed);
+            continue;
+        }
+        if (!anchored_) {
+            reanchor_locked();
+        }
+
+        const RecordIndexEntry& e = *items_[cursor_].entry;
+        const double offset = e.timestamp - anchor_recorded_;
+        if (config_.speed > 0.0) {
+            double due = anchor_wall_ + offset / config_.speed;
+            if (due > now) {
+                if (now >= deadline) {
+                    return nullptr;
+                }
+                cv_.wait_for(lock, std::chrono::duration<double>(std::min(due, deadline) - now),
+                             changed);
+                continue;
+            }
+        }
+
+        const uint8_t* data = items_[cursor_].data + e.offset;
+        const double timestamp = anchor_emitted_ + offset;
+        if (e.flags & RECORD_FLAG_POSE_VALID) {
+            PoseSample pose;
+            pose.timestamp = timestamp;
+            pose.pan = e.pan;
+            pose.tilt = e.tilt;
+            pose.zoom = e.zoom;
+            pose.zoom_target = static_cast<int32_t>(std::lround(e.zoom));
+            pose.pan_speed = e.pan_speed;
+            pose.tilt_speed = e.tilt_speed;
+            poses_.record(pose);
+        }
+        last_emitted_ = timestamp;
+        ++cursor_;
+        return std::make_shared<const Frame>(std::vector<uint8_t>(data, data + e.size),
+                                             e.width, e.height, e.sequence, timestamp,
+                                             static_cast<MotionState>(e.motion));
+    }
+}
+
+bool ReplaySource::seek(double timestamp) {
+    auto it = std::lower_bound(items_.begin(), items_.end(), timestamp,
+                               [](const Item& item, double t) {
+                                   return item.entry->timestamp < t;
+                               });
+    return seek_frame(static_cast<std::size_t>(it - items_.begin()));
+}
+
+bool ReplaySource::seek_frame(std::size_t index) {
+    bool found;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursor_ = std::min(index, items_.size());
+        anchored_ = false;
+        ++generation_;
+        found = cursor_ < items_.size();
+    }
+    cv_.notify_all();
+    return found;
+}
+
+void ReplaySource::set_speed(double speed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Keep the timeline continuous; only the pacing restarts.
+        if (anchored_ && cursor_ < items_.size()) {
+            double recorded = items_[cursor_].entry->timestamp;
+            anchor_emitted_ += recorded - anchor_recorded_;
+            anchor_recorded_ = recorded;
+            anchor_wall_ = PoseHistory::now();
+        }
+        config_.speed = std::max(speed, 0.0);
+        ++generation_;
+    }
+    cv_.notify_all();
+}
+
+double ReplaySource::speed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.speed;
+}
+
+std::size_t ReplaySource::position() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cursor_;
+}
+
+double ReplaySource::start_time() const {
+    return items_.empty() ? 0.0 : items_.front().entry->timestamp;
+}
+
+double ReplaySource::end_time() const {
+    return items_.empty() ? 0.0 : items_.back().entry->timestamp;
+}
+
+bool ReplaySource::finished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !config_.loop && cursor_ >= items_.size();
+}
+
+} // namespace bcc950
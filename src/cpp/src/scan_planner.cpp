@@ -0,0 +1,134 @@
+#include "bcc950/scan_planner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace bcc950 {
+
+namespace {
+
+double leg_time(double from_pan, double from_tilt, const Waypoint& to) {
+    return std::max(std::abs(to.pan - from_pan), std::abs(to.tilt - from_tilt));
+}
+
+/// Back-and-forth order over a grid. `rows_along_pan` sweeps each row
+/// along pan and steps in tilt between rows; otherwise the reverse.
+/// `flip_outer` / `flip_inner` pick the starting corner.
+Trajectory serpentine(const std::vector<double>& pans,
+                      const std::vector<double>& tilts,
+                      bool rows_along_pan, bool flip_outer, bool flip_inner,
+                      bool endpoints_only, double dwell) {
+    const auto& outer = rows_along_pan ? tilts : pans;
+    const auto& inner = rows_along_pan ? pans : tilts;
+    Trajectory t;
+    for (std::size_t r = 0; r < outer.size(); ++r) {
+        double o = outer[flip_outer ? outer.size() - 1 - r : r];
+        bool reverse = (r % 2 == 1) != flip_inner;
+        for (std::size_t c = 0; c < inner.size(); ++c) {
+            bool is_end = c == 0 || c + 1 == inner.size();
+            if (endpoints_only && !is_end) {
+                continue;
+            }
+            double i = inner[reverse ? inner.size() - 1 - c : c];
+            Waypoint w;
+            w.pan   = rows_along_pan ? i : o;
+            w.tilt  = rows_along_pan ? o : i;
+            w.dwell = endpoints_only ? 0.0 : dwell;
+            t.waypoints.push_back(w);
+        }
+    }
+    return t;
+}
+
+/// Square rings of grid cells around the cell nearest the start.
+Trajectory spiral(const std::vector<double>& pans, const std::vector<double>& tilts,
+                  double from_pan, double from_tilt, double dwell) {
+    auto nearest = [](const std::vector<double>& v, double x) {
+        auto it = std::min_element(v.begin(), v.end(), [x](double a, double b) {
+            return std::abs(a - x) < std::abs(b - x);
+        });
+        return static_cast<int>(it - v.begin());
+    };
+    int cols = static_cast<int>(pans.size());
+    int rows = static_cast<int>(tilts.size());
+    int c0 = nearest(pans, from_pan);
+    int r0 = nearest(tilts, from_tilt);
+
+    Trajectory t;
+    auto visit = [&](int c, int r) {
+        if (c >= 0 && c < cols && r >= 0 && r < rows) {
+            t.waypoints.push_back({pans[c], tilts[r], dwell});
+        }
+    };
+    visit(c0, r0);
+    int max_ring = std::max({c0, cols - 1 - c0, r0, rows - 1 - r0});
+    for (int k = 1; k <= max_ring; ++k) {
+        // Walk the ring clockwise from its top-left corner.
+        for (int c = c0 - k; c < c0 + k; ++c) visit(c, r0 + k);
+        for (int r = r0 + k; r > r0 - k; --r) visit(c0 + k, r);
+        for (int c = c0 + k; c > c0 - k; --c) visit(c, r0 - k);
+        for (int r = r0 - k; r < r0 + k; ++r) visit(c0 - k, r);
+    }
+    return t;
+}
+
+} // anonymous namespace
+
+double Trajectory::duration(double from_pan, double from_tilt) const {
+    double total = 0.0;
+    for (const auto& w : waypoints) {
+        total += leg_time(from_pan, from_tilt, w) + w.dwell;
+        from_pan  = w.pan;
+        from_tilt = w.tilt;
+    }
+    return total;
+}
+
+std::vector<double> scan_positions(double lo, double hi, double step) {
+    if (hi < lo) {
+        std::swap(lo, hi);
+    }
+    double span = hi - lo;
+    if (step <= 0.0 || span <= step) {
+        return {lo + span / 2.0};  // one view covers it
+    }
+    std::size_t n = static_cast<std::size_t>(std::ceil(span / step)) + 1;
+    std::vector<double> out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = lo + span * static_cast<double>(i) / static_cast<double>(n - 1);
+    }
+    return out;
+}
+
+Trajectory plan_scan(const ScanSpec& spec, double from_pan, double from_tilt) {
+    double overlap = std::clamp(spec.overlap, 0.0, 0.95);
+    double pan_step  = spec.optics.movement_seconds(Axis::Pan, 1.0 - overlap, spec.zoom);
+    double tilt_step = spec.optics.movement_seconds(Axis::Tilt, 1.0 - overlap, spec.zoom);
+    auto pans  = scan_positions(spec.pan_min, spec.pan_max, pan_step);
+    auto tilts = scan_positions(spec.tilt_min, spec.tilt_max, tilt_step);
+
+    if (spec.pattern == ScanPattern::Spiral) {
+        return spiral(pans, tilts, from_pan, from_tilt, spec.dwell);
+    }
+
+    bool endpoints_only = spec.pattern == ScanPattern::Boustrophedon;
+    Trajectory best;
+    double best_time = std::numeric_limits<double>::infinity();
+    for (int orientation = 0; orientation < 2; ++orientation) {
+        for (int corner = 0; corner < 4; ++corner) {
+            Trajectory t = serpentine(pans, tilts, orientation == 0,
+                                      corner & 1, corner & 2,
+                                      endpoints_only, spec.dwell);
+            double time = t.duration(from_pan, from_tilt);
+            if (time < best_time) {
+                best_time = time;
+                best = std::move(t);
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace bcc950
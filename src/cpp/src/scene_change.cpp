@@ -0,0 +1,191 @@
+#include "bcc950/scene_change.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace bcc950 {
+
+namespace {
+
+// Widen one row of bytes into 32-bit column sums.
+void add_row(const uint8_t* row, uint32_t* sums, int width) {
+    int x = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 16 <= width; x += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        auto* s = reinterpret_cast<__m128i*>(sums + x);
+        _mm_storeu_si128(s + 0, _mm_add_epi32(_mm_loadu_si128(s + 0), _mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2), _mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3), _mm_unpackhi_epi16(hi, zero)));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t v = vld1q_u8(row + x);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        vst1q_u32(sums + x + 0,  vaddw_u16(vld1q_u32(sums + x + 0),  vget_low_u16(lo)));
+        vst1q_u32(sums + x + 4,  vaddw_u16(vld1q_u32(sums + x + 4),  vget_high_u16(lo)));
+        vst1q_u32(sums + x + 8,  vaddw_u16(vld1q_u32(sums + x + 8),  vget_low_u16(hi)));
+        vst1q_u32(sums + x + 12, vaddw_u16(vld1q_u32(sums + x + 12), vget_high_u16(hi)));
+    }
+#endif
+    for (; x < width; ++x) {
+        sums[x] += row[x];
+    }
+}
+
+// Cell i of n over length len: [begin, end), never empty.
+int cell_begin(int i, int n, int len) {
+    return std::min(i * len / n, len - 1);
+}
+
+int cell_end(int i, int n, int len) {
+    return std::max((i + 1) * len / n, cell_begin(i, n, len) + 1);
+}
+
+// Area-average means of a cols x rows grid over a gray image.
+void grid_means(const Image& image, int cols, int rows, uint8_t* out) {
+    const int w = image.width;
+    const int h = image.height;
+    std::vector<uint32_t> sums(static_cast<std::size_t>(w));
+    for (int r = 0; r < rows; ++r) {
+        const int y0 = cell_begin(r, rows, h);
+        const int y1 = cell_end(r, rows, h);
+        std::fill(sums.begin(), sums.end(), 0u);
+        for (int y = y0; y < y1; ++y) {
+            add_row(image.pixels.data() + static_cast<std::size_t>(y) * w, sums.data(), w);
+        }
+        for (int c = 0; c < cols; ++c) {
+            const int x0 = cell_begin(c, cols, w);
+            const int x1 = cell_end(c, cols, w);
+            uint64_t total = 0;
+            for (int x = x0; x < x1; ++x) {
+                total += sums[x];
+            }
+            const uint64_t count = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+            out[r * cols + c] = static_cast<uint8_t>((total + count / 2) / count);
+        }
+    }
+}
+
+} // anonymous namespace
+
+SceneSignature scene_signature(const Image& gray) {
+    if (gray.channels != 1 || gray.width <= 0 || gray.height <= 0 ||
+        gray.pixels.size() < static_cast<std::size_t>(gray.width) * gray.height) {
+        throw std::invalid_argument("scene_signature needs a non-empty grayscale image");
+    }
+    constexpr int N = SceneSignature::GRID;
+    SceneSignature sig;
+    grid_means(gray, N, N, sig.blocks.data());
+
+    uint8_t wide[(N + 1) * N];
+    grid_means(gray, N + 1, N, wide);
+    for (int r = 0; r < N; ++r) {
+        for (int c = 0; c < N; ++c) {
+            if (wide[r * (N + 1) + c] > wide[r * (N + 1) + c + 1]) {
+                sig.dhash |= uint64_t{1} << (r * N + c);
+            }
+        }
+    }
+    return sig;
+}
+
+SceneSignature scene_signature(const Frame& frame, int scale) {
+    return scene_signature(*frame.decode(scale, PixelFormat::Gray));
+}
+
+int hash_distance(const SceneSignature& a, const SceneSignature& b) {
+    return __builtin_popcountll(a.dhash ^ b.dhash);
+}
+
+double block_distance(const SceneSignature& a, const SceneSignature& b) {
+    int total = 0;
+    for (std::size_t i = 0; i < a.blocks.size(); ++i) {
+        total += std::abs(static_cast<int>(a.blocks[i]) - static_cast<int>(b.blocks[i]));
+    }
+    return static_cast<double>(total) / static_cast<double>(a.blocks.size());
+}
+
+// --- SceneChangeDetector ---
+
+SceneChangeDetector::SceneChangeDetector(const SceneChangeConfig& config)
+    : config_(config) {}
+
+SceneDecision SceneChangeDetector::update(const Frame& frame) {
+    SceneSignature signature;
+    try {
+        signature = scene_signature(frame, config_.thumb_scale);
+    } catch (const JpegError&) {
+        ++frames_;
+        SceneDecision d;
+        d.trigger = SceneTrigger::NoSignature;
+        return ran(d, nullptr, frame.timestamp());
+    }
+    return update(signature, frame.timestamp(), frame.settled());
+}
+
+SceneDecision SceneChangeDetector::update(const SceneSignature& signature,
+                                          double timestamp, bool settled) {
+    ++frames_;
+    SceneDecision d;
+    if (!have_reference_) {
+        d.trigger = SceneTrigger::First;
+        d = ran(d, &signature, timestamp);
+        moved_ = !settled;  // a First pass mid-motion still owes a Settled one
+        return d;
+    }
+    d.hash_distance = hash_distance(signature, reference_);
+    d.block_distance = block_distance(signature, reference_);
+
+    if (!settled) {
+        moved_ = true;
+    } else if (moved_) {
+        d.trigger = SceneTrigger::Settled;
+    } else if (d.hash_distance > config_.hash_threshold ||
+               d.block_distance > config_.block_threshold) {
+        d.trigger = SceneTrigger::Changed;
+    }
+    if (d.trigger == SceneTrigger::None && timestamp - last_run_ >= config_.max_interval) {
+        d.trigger = SceneTrigger::Timeout;
+    }
+    if (d.trigger == SceneTrigger::None) {
+        return d;
+    }
+    return ran(d, &signature, timestamp);
+}
+
+SceneDecision SceneChangeDetector::ran(SceneDecision decision, const SceneSignature* signature,
+                                       double timestamp) {
+    decision.run = true;
+    ++runs_;
+    last_run_ = timestamp;
+    if (signature) {
+        reference_ = *signature;
+        have_reference_ = true;
+        // A pass on a moving frame does not end the motion.
+        if (decision.trigger != SceneTrigger::Timeout) {
+            moved_ = false;
+        }
+    }
+    return decision;
+}
+
+void SceneChangeDetector::reset() {
+    have_reference_ = false;
+    moved_ = false;
+}
+
+} // namespace bcc950
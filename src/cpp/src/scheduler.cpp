@@ -0,0 +1,286 @@
+#include "bcc950/scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace bcc950 {
+
+MotionCommand MotionCommand::move(int pan_dir, int tilt_dir, double duration) {
+    MotionCommand cmd;
+    cmd.type     = Type::Move;
+    cmd.pan_dir  = pan_dir;
+    cmd.tilt_dir = tilt_dir;
+    cmd.duration = duration;
+    return cmd;
+}
+
+MotionCommand MotionCommand::velocity(int pan_dir, int tilt_dir) {
+    MotionCommand cmd;
+    cmd.type     = Type::Velocity;
+    cmd.pan_dir  = pan_dir;
+    cmd.tilt_dir = tilt_dir;
+    return cmd;
+}
+
+MotionCommand MotionCommand::zoom_to(int value) {
+    MotionCommand cmd;
+    cmd.type = Type::Zoom;
+    cmd.zoom = value;
+    return cmd;
+}
+
+MotionCommand MotionCommand::stop() {
+    MotionCommand cmd;
+    cmd.type = Type::Stop;
+    return cmd;
+}
+
+MotionCommand MotionCommand::home() {
+    MotionCommand cmd;
+    cmd.type = Type::Home;
+    return cmd;
+}
+
+MotionCommand MotionCommand::follow(Trajectory trajectory) {
+    MotionCommand cmd;
+    cmd.type = Type::Trajectory;
+    cmd.trajectory = std::make_shared<const Trajectory>(std::move(trajectory));
+    return cmd;
+}
+
+SourcePolicy default_policy(CommandSource source) {
+    using std::chrono::milliseconds;
+    SourcePolicy p;
+    switch (source) {
+    case CommandSource::Operator:
+        p.latency_budget = milliseconds(20);
+        p.max_queue      = 16;
+        break;
+    case CommandSource::Tracker:
+        // Only the newest target update matters.
+        p.latency_budget = milliseconds(50);
+        p.max_queue      = 1;
+        p.coalesce       = true;
+        p.drop_stale     = true;
+        break;
+    case CommandSource::Tour:
+        p.latency_budget = milliseconds(1000);
+        p.max_queue      = 64;
+        break;
+    case CommandSource::Idle:
+        p.latency_budget = milliseconds(5000);
+        p.max_queue      = 4;
+        p.coalesce       = true;
+        p.drop_stale     = true;
+        break;
+    }
+    return p;
+}
+
+CommandScheduler::CommandScheduler(MotionController& motion)
+    : motion_(motion) {
+    for (std::size_t i = 0; i < COMMAND_SOURCE_COUNT; ++i) {
+        lanes_[i].policy = default_policy(static_cast<CommandSource>(i));
+    }
+    worker_ = std::thread(&CommandScheduler::run, this);
+}
+
+CommandScheduler::~CommandScheduler() {
+    shutdown();
+}
+
+void CommandScheduler::set_policy(CommandSource source, const SourcePolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lanes_[index(source)].policy = policy;
+}
+
+SourcePolicy CommandScheduler::policy(CommandSource source) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lanes_[index(source)].policy;
+}
+
+bool CommandScheduler::submit(CommandSource source, const MotionCommand& command) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_) {
+        return false;
+    }
+
+    Lane& lane = lanes_[index(source)];
+    ++lane.stats.submitted;
+
+    bool is_stop = command.type == MotionCommand::Type::Stop;
+    if (is_stop) {
+        // A stop supersedes everything queued at its level and below.
+        for (std::size_t i = index(source); i < COMMAND_SOURCE_COUNT; ++i) {
+            lanes_[i].stats.coalesced += lanes_[i].queue.size();
+            lanes_[i].queue.clear();
+        }
+    } else if (lane.policy.coalesce) {
+        lane.stats.coalesced += lane.queue.size();
+        lane.queue.clear();
+    } else if (!lane.queue.empty() && backlog_ && backlog_() > 0.0) {
+        // The device is behind: queueing more would only deepen it.
+        lane.stats.paced += lane.queue.size();
+        lane.queue.clear();
+    } else if (lane.queue.size() >= std::max<std::size_t>(lane.policy.max_queue, 1)) {
+        lane.queue.pop_front();
+        ++lane.stats.overflowed;
+    }
+    lane.queue.push_back({command, clock::now()});
+
+    if (running_ && !running_preempted_ &&
+        (preempts(source, *running_) || (is_stop && source == *running_))) {
+        running_preempted_ = true;
+        motion_.cancel();
+    }
+
+    work_cv_.notify_one();
+    return true;
+}
+
+void CommandScheduler::set_backpressure(std::function<double()> backlog) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    backlog_ = std::move(backlog);
+}
+
+void CommandScheduler::clear(CommandSource source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Lane& lane = lanes_[index(source)];
+    lane.stats.coalesced += lane.queue.size();
+    lane.queue.clear();
+    if (queues_empty_locked() && !running_) {
+        idle_cv_.notify_all();
+    }
+}
+
+void CommandScheduler::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [&] {
+        return shutdown_ || (queues_empty_locked() && !running_);
+    });
+}
+
+std::optional<CommandSource> CommandScheduler::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+SourceStats CommandScheduler::stats(CommandSource source) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lanes_[index(source)].stats;
+}
+
+void CommandScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shutdown_) {
+            return;
+        }
+        shutdown_ = true;
+        for (auto& lane : lanes_) {
+            lane.queue.clear();
+        }
+        if (running_) {
+            motion_.cancel();
+        }
+    }
+    work_cv_.notify_all();
+    idle_cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool CommandScheduler::queues_empty_locked() const {
+    return std::all_of(lanes_.begin(), lanes_.end(),
+                       [](const Lane& l) { return l.queue.empty(); });
+}
+
+void CommandScheduler::execute(const MotionCommand& command, uint64_t token) {
+    switch (command.type) {
+    case MotionCommand::Type::Move:
+        motion_.combined_move(command.pan_dir, command.tilt_dir,
+                              command.duration, token);
+        break;
+    case MotionCommand::Type::Velocity:
+        motion_.set_velocity(command.pan_dir, command.tilt_dir);
+        break;
+    case MotionCommand::Type::Zoom:
+        motion_.zoom_absolute(command.zoom);
+        break;
+    case MotionCommand::Type::Stop:
+        motion_.stop();
+        break;
+    case MotionCommand::Type::Home:
+        motion_.home(token);
+        break;
+    case MotionCommand::Type::Trajectory:
+        if (command.trajectory) {
+            motion_.run_trajectory(*command.trajectory, token);
+        }
+        break;
+    }
+}
+
+void CommandScheduler::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [&] { return shutdown_ || !queues_empty_locked(); });
+        if (shutdown_) {
+            break;
+        }
+
+        // Highest-priority non-empty lane wins.
+        std::size_t src = 0;
+        while (lanes_[src].queue.empty()) {
+            ++src;
+        }
+        Lane& lane = lanes_[src];
+        Pending next = lane.queue.front();
+        lane.queue.pop_front();
+
+        double wait_ms = std::chrono::duration<double, std::milli>(
+            clock::now() - next.enqueued).count();
+        bool late = wait_ms > static_cast<double>(lane.policy.latency_budget.count());
+        if (late && lane.policy.drop_stale &&
+            next.command.type != MotionCommand::Type::Stop) {
+            ++lane.stats.expired;
+            if (queues_empty_locked()) {
+                idle_cv_.notify_all();
+            }
+            continue;
+        }
+        if (late) {
+            ++lane.stats.budget_misses;
+        }
+        lane.stats.max_wait_ms = std::max(lane.stats.max_wait_ms, wait_ms);
+        lane.stats.total_wait_ms += wait_ms;
+
+        running_ = static_cast<CommandSource>(src);
+        running_preempted_ = false;
+        uint64_t token = motion_.cancel_token();
+
+        lock.unlock();
+        bool ok = true;
+        try {
+            execute(next.command, token);
+        } catch (const V4L2Error&) {
+            ok = false;
+        }
+        lock.lock();
+
+        ++lane.stats.executed;
+        if (!ok) {
+            ++lane.stats.failed;
+        }
+        if (running_preempted_) {
+            ++lane.stats.preempted;
+        }
+        running_.reset();
+        if (queues_empty_locked()) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+} // namespace bcc950
@@ -0,0 +1,176 @@
+#include "bcc950/snapshot_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace bcc950 {
+
+double mean_abs_diff(const uint8_t* a, const uint8_t* b, std::size_t n) {
+    if (n == 0) {
+        return 0.0;
+    }
+    std::size_t i = 0;
+    uint64_t sum = 0;
+
+#if defined(__SSE2__)
+    // PSADBW sums |a - b| over 8-byte halves into two 64-bit lanes.
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum = lanes[0] + lanes[1];
+#elif defined(__ARM_NEON)
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t d = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        acc = vpadalq_u16(acc, vpaddlq_u8(d));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, acc);
+    sum = static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < n; ++i) {
+        sum += static_cast<uint64_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+    }
+    return static_cast<double>(sum) / static_cast<double>(n);
+}
+
+std::string base64_encode(const uint8_t* data, std::size_t size) {
+    static constexpr char ALPHABET[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.resize((size + 2) / 3 * 4);
+    char* p = out.data();
+    std::size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t v = (static_cast<uint32_t>(data[i]) << 16) |
+                     (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+        *p++ = ALPHABET[(v >> 18) & 63];
+        *p++ = ALPHABET[(v >> 12) & 63];
+        *p++ = ALPHABET[(v >> 6) & 63];
+        *p++ = ALPHABET[v & 63];
+    }
+    if (i < size) {
+        uint32_t v = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < size) {
+            v |= static_cast<uint32_t>(data[i + 1]) << 8;
+        }
+        *p++ = ALPHABET[(v >> 18) & 63];
+        *p++ = ALPHABET[(v >> 12) & 63];
+        *p++ = i + 1 < size ? ALPHABET[(v >> 6) & 63] : '=';
+        *p++ = '=';
+    }
+    return out;
+}
+
+// --- SnapshotCache ---
+
+SnapshotCache::SnapshotCache(const PoseHistory* history, const SnapshotCacheConfig& config)
+    : history_(history), config_(config) {
+    config_.capacity = std::max<std::size_t>(config_.capacity, 1);
+}
+
+SnapshotCache::Key SnapshotCache::key_for(const Frame& frame) const {
+    std::optional<PoseSample> pose;
+    if (history_) {
+        pose = history_->pose_at(frame.timestamp());
+    }
+    if (!pose) {
+        return Key{0, 0, 0};
+    }
+    auto bucket = [](double v, double size) {
+        return size > 0.0 ? std::lround(v / size) : 0L;
+    };
+    return Key{bucket(pose->pan, config_.pan_bucket),
+               bucket(pose->tilt, config_.tilt_bucket),
+               bucket(pose->zoom, config_.zoom_bucket)};
+}
+
+Snapshot SnapshotCache::get(const FramePtr& frame) {
+    if (!frame) {
+        return Snapshot{};
+    }
+    const Key key = key_for(*frame);
+
+    // Outside the lock: decoding is cached per frame and may be shared.
+    ImagePtr thumbnail;
+    try {
+        thumbnail = frame->decode(config_.thumb_scale, PixelFormat::Gray);
+    } catch (const JpegError&) {
+        // Undecodable (or no libjpeg): never reused, never cached.
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && thumbnail) {
+            const Entry& e = it->second;
+            const Image& a = *thumbnail;
+            const Image& b = *e.thumbnail;
+            bool fresh = frame->timestamp() - e.snapshot.frame->timestamp() <= config_.max_age;
+            bool same_size = a.width == b.width && a.height == b.height &&
+                             a.pixels.size() == b.pixels.size();
+            if (fresh && same_size &&
+                mean_abs_diff(a.pixels.data(), b.pixels.data(), a.pixels.size()) <=
+                    config_.max_diff) {
+                ++stats_.hits;
+                it->second.last_used = ++clock_;
+                Snapshot s = e.snapshot;
+                s.cached = true;
+                return s;
+            }
+        }
+        ++stats_.misses;
+    }
+
+    Snapshot s;
+    s.base64 = base64_encode(frame->data(), frame->size());
+    s.frame = frame;
+    if (!frame->settled() || !thumbnail) {
+        return s;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& e = entries_[key];
+    e.snapshot = s;
+    e.thumbnail = std::move(thumbnail);
+    e.last_used = ++clock_;
+    if (entries_.size() > config_.capacity) {
+        auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                                       [](const auto& x, const auto& y) {
+                                           return x.second.last_used < y.second.last_used;
+                                       });
+        entries_.erase(oldest);
+    }
+    return s;
+}
+
+void SnapshotCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+std::size_t SnapshotCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+SnapshotCacheStats SnapshotCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace bcc950
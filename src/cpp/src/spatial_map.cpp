@@ -0,0 +1,289 @@
+#include "bcc950/spatial_map.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bcc950 {
+
+namespace {
+
+constexpr char     MAP_MAGIC[8] = {'B', 'C', 'C', '9', '5', '0', 'S', 'M'};
+constexpr uint32_t MAP_VERSION  = 1;
+
+static_assert(sizeof(SpatialEntry) == 24, "SpatialEntry is part of the file format");
+
+} // anonymous namespace
+
+/// File header. Fixed layout: part of the on-disk format.
+struct SpatialMap::Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t cell_capacity;
+    int32_t  pan_cells;
+    int32_t  tilt_cells;
+    double   pan_min;
+    double   tilt_min;
+    double   cell_size;
+    uint64_t count;
+    uint8_t  reserved[8];
+};
+
+/// Ring state of one grid cell.
+struct SpatialMap::Cell {
+    uint32_t head;   // next slot to write
+    uint32_t count;  // entries held, up to cell_capacity
+};
+
+int SpatialGridSpec::pan_cells() const {
+    return std::max(1, static_cast<int>(std::ceil((pan_max - pan_min) / cell_size)));
+}
+
+int SpatialGridSpec::tilt_cells() const {
+    return std::max(1, static_cast<int>(std::ceil((tilt_max - tilt_min) / cell_size)));
+}
+
+SpatialMap::SpatialMap(const SpatialGridSpec& spec)
+    : spec_(spec)
+    , pan_cells_(spec.pan_cells())
+    , tilt_cells_(spec.tilt_cells()) {
+    spec_.cell_capacity = std::max<uint32_t>(spec_.cell_capacity, 1);
+    map_anonymous();
+    attach(true);
+}
+
+SpatialMap::SpatialMap(const std::string& path, const SpatialGridSpec& spec)
+    : spec_(spec)
+    , pan_cells_(spec.pan_cells())
+    , tilt_cells_(spec.tilt_cells()) {
+    spec_.cell_capacity = std::max<uint32_t>(spec_.cell_capacity, 1);
+    mapped_bytes_ = layout_bytes();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open spatial map " + path + ": " +
+                                 std::strerror(errno));
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat spatial map " + path);
+    }
+    bool fresh = st.st_size == 0;
+    if (fresh && ::ftruncate(fd, static_cast<off_t>(mapped_bytes_)) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot size spatial map " + path + ": " +
+                                 std::strerror(errno));
+    }
+    if (!fresh && static_cast<std::size_t>(st.st_size) != mapped_bytes_) {
+        ::close(fd);
+        throw std::runtime_error("Spatial map " + path + " has a different grid");
+    }
+
+    mapped_ = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file open
+    if (mapped_ == MAP_FAILED) {
+        mapped_ = nullptr;
+        throw std::runtime_error("Cannot map spatial map " + path + ": " +
+                                 std::strerror(errno));
+    }
+    file_backed_ = true;
+    attach(fresh);
+
+    const Header& h = *header_;
+    bool same_grid =
+        std::memcmp(h.magic, MAP_MAGIC, sizeof(MAP_MAGIC)) == 0 &&
+        h.version == MAP_VERSION &&
+        h.cell_capacity == spec_.cell_capacity &&
+        h.pan_cells == pan_cells_ && h.tilt_cells == tilt_cells_ &&
+        h.pan_min == spec_.pan_min && h.tilt_min == spec_.tilt_min &&
+        h.cell_size == spec_.cell_size;
+    if (!same_grid) {
+        ::munmap(mapped_, mapped_bytes_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Spatial map " + path + " has a different grid");
+    }
+    // Queries walk each ring up to count, so a corrupt cell would read
+    // past its slots.
+    std::size_t cells = static_cast<std::size_t>(pan_cells_) * tilt_cells_;
+    bool rings_valid = std::all_of(cells_, cells_ + cells, [&](const Cell& c) {
+        return c.count <= spec_.cell_capacity && c.head < spec_.cell_capacity;
+    });
+    if (!rings_valid) {
+        ::munmap(mapped_, mapped_bytes_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Spatial map " + path + " is corrupt");
+    }
+}
+
+SpatialMap::~SpatialMap() {
+    if (mapped_) {
+        ::munmap(mapped_, mapped_bytes_);
+    }
+}
+
+std::size_t SpatialMap::layout_bytes() const {
+    std::size_t cells = static_cast<std::size_t>(pan_cells_) * tilt_cells_;
+    return sizeof(Header) + cells * sizeof(Cell) +
+           cells * spec_.cell_capacity * sizeof(SpatialEntry);
+}
+
+void SpatialMap::map_anonymous() {
+    mapped_bytes_ = layout_bytes();
+    mapped_ = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped_ == MAP_FAILED) {
+        mapped_ = nullptr;
+        throw std::runtime_error("Cannot allocate spatial map");
+    }
+}
+
+void SpatialMap::attach(bool initialize) {
+    static_assert(sizeof(Header) == 64, "Header is part of the file format");
+    auto* base = static_cast<unsigned char*>(mapped_);
+    std::size_t cells = static_cast<std::size_t>(pan_cells_) * tilt_cells_;
+    header_  = reinterpret_cast<Header*>(base);
+    cells_   = reinterpret_cast<Cell*>(base + sizeof(Header));
+    entries_ = reinterpret_cast<SpatialEntry*>(base + sizeof(Header) +
+                                               cells * sizeof(Cell));
+    if (!initialize) {
+        return;
+    }
+    // Fresh mappings are zero-filled, so every cell starts empty.
+    Header& h = *header_;
+    std::memcpy(h.magic, MAP_MAGIC, sizeof(MAP_MAGIC));
+    h.version       = MAP_VERSION;
+    h.cell_capacity = spec_.cell_capacity;
+    h.pan_cells     = pan_cells_;
+    h.tilt_cells    = tilt_cells_;
+    h.pan_min       = spec_.pan_min;
+    h.tilt_min      = spec_.tilt_min;
+    h.cell_size     = spec_.cell_size;
+    h.count         = 0;
+}
+
+int SpatialMap::cell_index(double pan, double tilt) const {
+    int ip = static_cast<int>(std::floor((pan - spec_.pan_min) / spec_.cell_size));
+    int it = static_cast<int>(std::floor((tilt - spec_.tilt_min) / spec_.cell_size));
+    ip = std::clamp(ip, 0, pan_cells_ - 1);
+    it = std::clamp(it, 0, tilt_cells_ - 1);
+    return it * pan_cells_ + ip;
+}
+
+template <typename Visit>
+void SpatialMap::for_each_cell_in(double pan, double tilt, double radius,
+                                  Visit visit) const {
+    auto lo = [&](double v, double min) {
+        return static_cast<int>(std::floor((v - radius - min) / spec_.cell_size));
+    };
+    auto hi = [&](double v, double min) {
+        return static_cast<int>(std::floor((v + radius - min) / spec_.cell_size));
+    };
+    // Clamped like insert(), so out-of-range entries stay reachable.
+    int p0 = std::clamp(lo(pan, spec_.pan_min), 0, pan_cells_ - 1);
+    int p1 = std::clamp(hi(pan, spec_.pan_min), 0, pan_cells_ - 1);
+    int t0 = std::clamp(lo(tilt, spec_.tilt_min), 0, tilt_cells_ - 1);
+    int t1 = std::clamp(hi(tilt, spec_.tilt_min), 0, tilt_cells_ - 1);
+    for (int it = t0; it <= t1; ++it) {
+        for (int ip = p0; ip <= p1; ++ip) {
+            visit(it * pan_cells_ + ip);
+        }
+    }
+}
+
+void SpatialMap::insert(double pan, double tilt, uint64_t id, double timestamp) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    int index = cell_index(pan, tilt);
+    Cell& cell = cells_[index];
+    SpatialEntry& slot = entries_[static_cast<std::size_t>(index) *
+                                  spec_.cell_capacity + cell.head];
+    slot.timestamp = timestamp;
+    slot.pan  = static_cast<float>(pan);
+    slot.tilt = static_cast<float>(tilt);
+    slot.id   = id;
+    cell.head = (cell.head + 1) % spec_.cell_capacity;
+    if (cell.count < spec_.cell_capacity) {
+        ++cell.count;
+        ++header_->count;
+    }
+}
+
+std::vector<SpatialEntry> SpatialMap::query(double pan, double tilt, double radius,
+                                            double since) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<SpatialEntry> out;
+    double r2 = radius * radius;
+    for_each_cell_in(pan, tilt, radius, [&](int index) {
+        const Cell& cell = cells_[index];
+        const SpatialEntry* ring = entries_ +
+            static_cast<std::size_t>(index) * spec_.cell_capacity;
+        for (uint32_t i = 0; i < cell.count; ++i) {
+            const SpatialEntry& e = ring[i];
+            double dp = e.pan - pan;
+            double dt = e.tilt - tilt;
+            if (e.timestamp >= since && dp * dp + dt * dt <= r2) {
+                out.push_back(e);
+            }
+        }
+    });
+    std::sort(out.begin(), out.end(), [](const SpatialEntry& a, const SpatialEntry& b) {
+        return a.timestamp > b.timestamp;
+    });
+    return out;
+}
+
+std::vector<SpatialEntry> SpatialMap::latest_per_cell(double pan, double tilt,
+                                                      double radius,
+                                                      double since) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<SpatialEntry> out;
+    double r2 = radius * radius;
+    uint32_t cap = spec_.cell_capacity;
+    for_each_cell_in(pan, tilt, radius, [&](int index) {
+        const Cell& cell = cells_[index];
+        const SpatialEntry* ring = entries_ + static_cast<std::size_t>(index) * cap;
+        // Newest first, from just behind the write head.
+        for (uint32_t k = 0; k < cell.count; ++k) {
+            const SpatialEntry& e = ring[(cell.head + cap - 1 - k) % cap];
+            double dp = e.pan - pan;
+            double dt = e.tilt - tilt;
+            if (e.timestamp >= since && dp * dp + dt * dt <= r2) {
+                out.push_back(e);
+                break;
+            }
+        }
+    });
+    std::sort(out.begin(), out.end(), [](const SpatialEntry& a, const SpatialEntry& b) {
+        return a.timestamp > b.timestamp;
+    });
+    return out;
+}
+
+std::size_t SpatialMap::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<std::size_t>(header_->count);
+}
+
+void SpatialMap::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::size_t cells = static_cast<std::size_t>(pan_cells_) * tilt_cells_;
+    std::memset(cells_, 0, cells * sizeof(Cell));
+    header_->count = 0;
+}
+
+void SpatialMap::sync() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (file_backed_) {
+        ::msync(mapped_, mapped_bytes_, MS_SYNC);
+    }
+}
+
+} // namespace bcc950
@@ -0,0 +1,309 @@
+#include "bcc950/target_selector.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace bcc950 {
+
+namespace {
+
+// Velocity smoothing weight for each new observation.
+constexpr double VELOCITY_ALPHA = 0.5;
+// Ignore velocity from frames closer together than this (seconds).
+constexpr double MIN_VELOCITY_DT = 1e-3;
+
+/// Axis-aligned box in world movement-seconds.
+struct WorldBox {
+    double pan_lo, pan_hi, tilt_lo, tilt_hi;
+
+    double pan() const { return (pan_lo + pan_hi) / 2.0; }
+    double tilt() const { return (tilt_lo + tilt_hi) / 2.0; }
+};
+
+WorldBox project(const Detection& d, const PoseSample& pose, const ZoomModel& optics) {
+    auto pan_at = [&](double x) {
+        return pose.pan + optics.bearing_offset(Axis::Pan, x - 0.5, pose.zoom);
+    };
+    // Image y grows downward; tilt grows upward.
+    auto tilt_at = [&](double y) {
+        return pose.tilt - optics.bearing_offset(Axis::Tilt, y - 0.5, pose.zoom);
+    };
+    return WorldBox{pan_at(d.x1), pan_at(d.x2), tilt_at(d.y2), tilt_at(d.y1)};
+}
+
+WorldBox world_box(const Track& track, double t) {
+    Bearing c = track.predict(t);
+    return WorldBox{c.pan - track.width / 2.0, c.pan + track.width / 2.0,
+                    c.tilt - track.height / 2.0, c.tilt + track.height / 2.0};
+}
+
+double iou(const WorldBox& a, const WorldBox& b) {
+    double w = std::min(a.pan_hi, b.pan_hi) - std::max(a.pan_lo, b.pan_lo);
+    double h = std::min(a.tilt_hi, b.tilt_hi) - std::max(a.tilt_lo, b.tilt_lo);
+    if (w <= 0.0 || h <= 0.0) {
+        return 0.0;
+    }
+    double inter = w * h;
+    double area_a = (a.pan_hi - a.pan_lo) * (a.tilt_hi - a.tilt_lo);
+    double area_b = (b.pan_hi - b.pan_lo) * (b.tilt_hi - b.tilt_lo);
+    return inter / (area_a + area_b - inter);
+}
+
+/// Minimum-cost assignment (Hungarian algorithm with potentials) for a
+/// row-major rows x cols matrix. Returns the column matched to each row,
+/// or -1 where rows outnumber columns.
+std::vector<int> assign(const std::vector<double>& cost, int rows, int cols) {
+    if (rows > cols) {
+        std::vector<double> transposed(cost.size());
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                transposed[c * rows + r] = cost[r * cols + c];
+            }
+        }
+        std::vector<int> by_col = assign(transposed, cols, rows);
+        std::vector<int> by_row(rows, -1);
+        for (int c = 0; c < cols; ++c) {
+            by_row[by_col[c]] = c;
+        }
+        return by_row;
+    }
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    // 1-based potentials; p[j] is the row matched to column j.
+    std::vector<double> u(rows + 1, 0.0), v(cols + 1, 0.0);
+    std::vector<int> p(cols + 1, 0), way(cols + 1, 0);
+    for (int i = 1; i <= rows; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        std::vector<double> minv(cols + 1, inf);
+        std::vector<bool> used(cols + 1, false);
+        do {
+            used[j0] = true;
+            int i0 = p[j0];
+            int j1 = 0;
+            double delta = inf;
+            for (int j = 1; j <= cols; ++j) {
+                if (used[j]) {
+                    continue;
+                }
+                double cur = cost[(i0 - 1) * cols + (j - 1)] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= cols; ++j) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    std::vector<int> result(rows, -1);
+    for (int j = 1; j <= cols; ++j) {
+        if (p[j] != 0) {
+            result[p[j] - 1] = j - 1;
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// --- Track ---
+
+Bearing Track::predict(double t) const {
+    double dt = t - last_seen;
+    return Bearing{bearing.pan + pan_velocity * dt,
+                   bearing.tilt + tilt_velocity * dt};
+}
+
+// --- TargetSelector ---
+
+TargetSelector::TargetSelector(const PoseHistory& history,
+                               const TargetSelectorConfig& config)
+    : history_(history), config_(config) {}
+
+bool TargetSelector::update(const std::vector<Detection>& detections,
+                            double timestamp) {
+    std::optional<PoseSample> pose = history_.pose_at(timestamp);
+    if (!pose) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<WorldBox> boxes;
+    boxes.reserve(detections.size());
+    for (const Detection& d : detections) {
+        boxes.push_back(project(d, *pose, config_.optics));
+    }
+
+    const int rows = static_cast<int>(tracks_.size());
+    const int cols = static_cast<int>(detections.size());
+    std::vector<int> match(rows, -1);
+    if (rows > 0 && cols > 0) {
+        std::vector<double> overlap(static_cast<std::size_t>(rows) * cols, 0.0);
+        std::vector<double> cost(overlap.size(), 1.0);
+        for (int r = 0; r < rows; ++r) {
+            WorldBox predicted = world_box(tracks_[r], timestamp);
+            for (int c = 0; c < cols; ++c) {
+                if (tracks_[r].class_id != detections[c].class_id) {
+                    continue;
+                }
+                overlap[r * cols + c] = iou(predicted, boxes[c]);
+                cost[r * cols + c] = 1.0 - overlap[r * cols + c];
+            }
+        }
+        match = assign(cost, rows, cols);
+        for (int r = 0; r < rows; ++r) {
+            if (match[r] >= 0 && overlap[r * cols + match[r]] < config_.min_iou) {
+                match[r] = -1;
+            }
+        }
+    }
+
+    std::vector<bool> claimed(cols, false);
+    for (int r = 0; r < rows; ++r) {
+        if (match[r] < 0) {
+            continue;
+        }
+        const int c = match[r];
+        claimed[c] = true;
+        Track& track = tracks_[r];
+        const WorldBox& box = boxes[c];
+
+        double dt = timestamp - track.last_seen;
+        if (dt > MIN_VELOCITY_DT) {
+            double vp = (box.pan() - track.bearing.pan) / dt;
+            double vt = (box.tilt() - track.bearing.tilt) / dt;
+            double alpha = track.hits == 1 ? 1.0 : VELOCITY_ALPHA;
+            track.pan_velocity += alpha * (vp - track.pan_velocity);
+            track.tilt_velocity += alpha * (vt - track.tilt_velocity);
+        }
+        track.box = detections[c];
+        track.confidence = detections[c].confidence;
+        track.bearing = Bearing{box.pan(), box.tilt()};
+        track.width = box.pan_hi - box.pan_lo;
+        track.height = box.tilt_hi - box.tilt_lo;
+        track.last_seen = std::max(track.last_seen, timestamp);
+        ++track.hits;
+    }
+
+    for (int c = 0; c < cols; ++c) {
+        if (claimed[c]) {
+            continue;
+        }
+        Track track;
+        track.id = next_id_++;
+        track.class_id = detections[c].class_id;
+        track.confidence = detections[c].confidence;
+        track.box = detections[c];
+        track.bearing = Bearing{boxes[c].pan(), boxes[c].tilt()};
+        track.width = boxes[c].pan_hi - boxes[c].pan_lo;
+        track.height = boxes[c].tilt_hi - boxes[c].tilt_lo;
+        track.first_seen = timestamp;
+        track.last_seen = timestamp;
+        track.hits = 1;
+        tracks_.push_back(track);
+    }
+
+    const double max_age = config_.max_age;
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [&](const Track& t) {
+                                     return timestamp - t.last_seen > max_age;
+                                 }),
+                  tracks_.end());
+
+    select_target_locked(timestamp);
+    return true;
+}
+
+std::vector<Track> TargetSelector::tracks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tracks_;
+}
+
+std::optional<Track> TargetSelector::target() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const Track* t = find_locked(target_id_)) {
+        return *t;
+    }
+    return std::nullopt;
+}
+
+std::optional<Bearing> TargetSelector::target_bearing(double t) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Track* track = find_locked(target_id_);
+    if (!track) {
+        return std::nullopt;
+    }
+    double ahead = std::clamp(t - track->last_seen, 0.0, config_.max_age);
+    return track->predict(track->last_seen + ahead);
+}
+
+void TargetSelector::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tracks_.clear();
+    target_id_ = 0;
+}
+
+void TargetSelector::set_config(const TargetSelectorConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+TargetSelectorConfig TargetSelector::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+const Track* TargetSelector::find_locked(uint64_t id) const {
+    if (id == 0) {
+        return nullptr;
+    }
+    for (const Track& t : tracks_) {
+        if (t.id == id) {
+            return &t;
+        }
+    }
+    return nullptr;
+}
+
+void TargetSelector::select_target_locked(double timestamp) {
+    // Stay on the current target for as long as its track lives.
+    if (find_locked(target_id_)) {
+        return;
+    }
+    target_id_ = 0;
+
+    // Otherwise the largest (closest) confirmed track seen in this frame.
+    float best_area = -1.0f;
+    for (const Track& t : tracks_) {
+        if (t.class_id != config_.target_class || t.hits < config_.min_hits ||
+            t.last_seen < timestamp) {
+            continue;
+        }
+        if (t.box.area() > best_area) {
+            best_area = t.box.area();
+            target_id_ = t.id;
+        }
+    }
+}
+
+} // namespace bcc950
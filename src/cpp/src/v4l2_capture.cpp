@@ -0,0 +1,224 @@
+#include "bcc950/v4l2_capture.hpp"
+#include "bcc950/pose_history.hpp"
+#include "bcc950/v4l2_device.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+
+namespace bcc950 {
+
+namespace {
+
+int xioctl(int fd, unsigned long request, void* arg) {
+    int r;
+    do {
+        r = ::ioctl(fd, request, arg);
+    } while (r < 0 && errno == EINTR);
+    return r;
+}
+
+[[noreturn]] void fail(const std::string& what) {
+    throw V4L2Error(what + " failed: " + std::strerror(errno));
+}
+
+/// Buffer timestamp on the PoseHistory::now() clock. UVC stamps frames
+/// with CLOCK_MONOTONIC (steady_clock on Linux); anything else is
+/// replaced with the dequeue time.
+double frame_time(const struct v4l2_buffer& buf) {
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) ==
+            V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC &&
+        (buf.timestamp.tv_sec != 0 || buf.timestamp.tv_usec != 0)) {
+        return static_cast<double>(buf.timestamp.tv_sec) +
+               static_cast<double>(buf.timestamp.tv_usec) * 1e-6;
+    }
+    return PoseHistory::now();
+}
+
+} // namespace
+
+V4L2Capture::V4L2Capture(const std::string& device, const CaptureFormat& format) {
+    open(device, format);
+}
+
+V4L2Capture::~V4L2Capture() {
+    close();
+}
+
+bool V4L2Capture::is_open() const {
+    return fd_ >= 0;
+}
+
+void V4L2Capture::open(const std::string& device, const CaptureFormat& format) {
+    close();
+
+    fd_ = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if (fd_ < 0) {
+        throw V4L2Error("Failed to open device " + device + ": " +
+                         std::strerror(errno));
+    }
+
+    try {
+        struct v4l2_format fmt{};
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width = static_cast<uint32_t>(format.width);
+        fmt.fmt.pix.height = static_cast<uint32_t>(format.height);
+        fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;
+        fmt.fmt.pix.field = V4L2_FIELD_NONE;
+        if (xioctl(fd_, VIDIOC_S_FMT, &fmt) < 0) {
+            fail("VIDIOC_S_FMT");
+        }
+        if (fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_MJPEG) {
+            throw V4L2Error(device + " does not support MJPEG capture");
+        }
+        width_ = static_cast<int>(fmt.fmt.pix.width);
+        height_ = static_cast<int>(fmt.fmt.pix.height);
+
+        // Frame rate is advisory; not every driver supports S_PARM.
+        if (format.fps > 0) {
+            struct v4l2_streamparm parm{};
+            parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            parm.parm.capture.timeperframe.numerator = 1;
+            parm.parm.capture.timeperframe.denominator =
+                static_cast<uint32_t>(format.fps);
+            xioctl(fd_, VIDIOC_S_PARM, &parm);
+        }
+
+        struct v4l2_requestbuffers req{};
+        req.count = static_cast<uint32_t>(std::max(2, format.buffers));
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd_, VIDIOC_REQBUFS, &req) < 0) {
+            fail("VIDIOC_REQBUFS");
+        }
+        if (req.count < 2) {
+            throw V4L2Error("Insufficient capture buffers on " + device);
+        }
+
+        for (uint32_t i = 0; i < req.count; ++i) {
+            struct v4l2_buffer buf{};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (xioctl(fd_, VIDIOC_QUERYBUF, &buf) < 0) {
+                fail("VIDIOC_QUERYBUF");
+            }
+            void* start = ::mmap(nullptr, buf.length, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED, fd_, buf.m.offset);
+            if (start == MAP_FAILED) {
+                fail("mmap");
+            }
+            buffers_.push_back(Buffer{start, buf.length});
+            if (xioctl(fd_, VIDIOC_QBUF, &buf) < 0) {
+                fail("VIDIOC_QBUF");
+            }
+        }
+
+        enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(fd_, VIDIOC_STREAMON, &type) < 0) {
+            fail("VIDIOC_STREAMON");
+        }
+        streaming_ = true;
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+void V4L2Capture::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    if (streaming_) {
+        enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(fd_, VIDIOC_STREAMOFF, &type);
+        streaming_ = false;
+    }
+    for (const Buffer& b : buffers_) {
+        ::munmap(b.start, b.length);
+    }
+    buffers_.clear();
+
+    // Release the driver's buffer allocation before closing.
+    struct v4l2_requestbuffers req{};
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    xioctl(fd_, VIDIOC_REQBUFS, &req);
+
+    ::close(fd_);
+    fd_ = -1;
+    width_ = 0;
+    height_ = 0;
+}
+
+void V4L2Capture::set_motion_log(const PoseHistory* history,
+                                 const MotionTiming& timing) {
+    motion_log_ = history;
+    motion_timing_ = timing;
+}
+
+FramePtr V4L2Capture::read(double timeout) {
+    if (!streaming_) {
+        throw V4L2Error("Capture not streaming");
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() +
+        std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(std::max(0.0, timeout)));
+
+    for (;;) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - clock::now()).count();
+        struct pollfd pfd{fd_, POLLIN, 0};
+        int r = ::poll(&pfd, 1, static_cast<int>(std::max<long long>(0, remaining)));
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail("poll");
+        }
+        if (r == 0) {
+            return nullptr;
+        }
+
+        struct v4l2_buffer buf{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd_, VIDIOC_DQBUF, &buf) < 0) {
+            if (errno == EAGAIN) {
+                continue;
+            }
+            fail("VIDIOC_DQBUF");
+        }
+
+        FramePtr frame;
+        if (!(buf.flags & V4L2_BUF_FLAG_ERROR) && buf.bytesused > 0 &&
+            buf.index < buffers_.size()) {
+            const auto* bytes = static_cast<const uint8_t*>(buffers_[buf.index].start);
+            double t = frame_time(buf);
+            MotionState motion = motion_log_
+                ? motion_state(*motion_log_, t, motion_timing_)
+                : MotionState::Stationary;
+            frame = std::make_shared<const Frame>(
+                std::vector<uint8_t>(bytes, bytes + buf.bytesused),
+                width_, height_, buf.sequence, t, motion);
+        }
+
+        if (xioctl(fd_, VIDIOC_QBUF, &buf) < 0) {
+            fail("VIDIOC_QBUF");
+        }
+        if (frame) {
+            return frame;
+        }
+    }
+}
+
+} // namespace bcc950
@@ -1,7 +1,10 @@
 #include "bcc950/v4l2_device.hpp"
+#include "bcc950/watchdog.hpp"
 
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <iterator>
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
@@ -9,29 +12,45 @@
 
 namespace bcc950 {
 
+namespace {
+
+// A control id as V4L2 headers spell it, e.g. "0x009a0904".
+std::string control_name(uint32_t id) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "0x%08x", id);
+    return buf;
+}
+
+} // namespace
+
 V4L2Device::V4L2Device(const std::string& device) {
     open(device);
 }
 
 V4L2Device::~V4L2Device() {
     if (fd_ >= 0) {
+        unregister_emergency_stop_fd(fd_);
         ::close(fd_);
         fd_ = -1;
     }
 }
 
 V4L2Device::V4L2Device(V4L2Device&& other) noexcept
-    : fd_(other.fd_), device_path_(std::move(other.device_path_)) {
+    : fd_(other.fd_), device_path_(std::move(other.device_path_)),
+      ext_controls_(other.ext_controls_.load(std::memory_order_relaxed)) {
     other.fd_ = -1;
 }
 
 V4L2Device& V4L2Device::operator=(V4L2Device&& other) noexcept {
     if (this != &other) {
         if (fd_ >= 0) {
+            unregister_emergency_stop_fd(fd_);
             ::close(fd_);
         }
         fd_ = other.fd_;
         device_path_ = std::move(other.device_path_);
+        ext_controls_.store(other.ext_controls_.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
         other.fd_ = -1;
     }
     return *this;
@@ -48,10 +67,12 @@ void V4L2Device::open(const std::string& device) {
                          std::strerror(errno));
     }
     device_path_ = device;
+    register_emergency_stop_fd(fd_);
 }
 
 void V4L2Device::close() {
     if (fd_ >= 0) {
+        unregister_emergency_stop_fd(fd_);
         ::close(fd_);
         fd_ = -1;
         device_path_.clear();
@@ -72,8 +93,44 @@ void V4L2Device::set_control(uint32_t id, int32_t value) {
     ctrl.value = value;
 
     if (::ioctl(fd_, VIDIOC_S_CTRL, &ctrl) < 0) {
-        throw V4L2Error("VIDIOC_S_CTRL failed for control 0x" +
-                         std::to_string(id) + ": " + std::strerror(errno));
+        throw V4L2Error("VIDIOC_S_CTRL failed for control " +
+                         control_name(id) + ": " + std::strerror(errno));
+    }
+}
+
+void V4L2Device::set_controls(const ControlValue* values, std::size_t count) {
+    if (fd_ < 0) {
+        throw V4L2Error("Device not open");
+    }
+    if (count == 1) {
+        set_control(values[0].id, values[0].value);
+        return;
+    }
+
+    struct v4l2_ext_control ctrls[8]{};
+    if (count == 0 || count > std::size(ctrls) ||
+        !ext_controls_.load(std::memory_order_relaxed)) {
+        IV4L2Device::set_controls(values, count);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        ctrls[i].id = values[i].id;
+        ctrls[i].value = values[i].value;
+    }
+    struct v4l2_ext_controls ext{};
+    ext.ctrl_class = V4L2_CTRL_ID2CLASS(values[0].id);
+    ext.count = static_cast<uint32_t>(count);
+    ext.controls = ctrls;
+
+    if (::ioctl(fd_, VIDIOC_S_EXT_CTRLS, &ext) < 0) {
+        if (errno == ENOTTY) {
+            ext_controls_.store(false, std::memory_order_relaxed);
+            IV4L2Device::set_controls(values, count);
+            return;
+        }
+        uint32_t failed = ext.error_idx < count ? values[ext.error_idx].id : values[0].id;
+        throw V4L2Error("VIDIOC_S_EXT_CTRLS failed for control " +
+                         control_name(failed) + ": " + std::strerror(errno));
     }
 }
 
@@ -86,8 +143,8 @@ int32_t V4L2Device::get_control(uint32_t id) {
     ctrl.id = id;
 
     if (::ioctl(fd_, VIDIOC_G_CTRL, &ctrl) < 0) {
-        throw V4L2Error("VIDIOC_G_CTRL failed for control 0x" +
-                         std::to_string(id) + ": " + std::strerror(errno));
+        throw V4L2Error("VIDIOC_G_CTRL failed for control " +
+                         control_name(id) + ": " + std::strerror(errno));
     }
 
     return ctrl.value;
@@ -102,8 +159,8 @@ struct v4l2_queryctrl V4L2Device::query_control(uint32_t id) {
     qctrl.id = id;
 
     if (::ioctl(fd_, VIDIOC_QUERYCTRL, &qctrl) < 0) {
-        throw V4L2Error("VIDIOC_QUERYCTRL failed for control 0x" +
-                         std::to_string(id) + ": " + std::strerror(errno));
+        throw V4L2Error("VIDIOC_QUERYCTRL failed for control " +
+                         control_name(id) + ": " + std::strerror(errno));
     }
 
     return qctrl;
@@ -0,0 +1,198 @@
+#include "bcc950/watchdog.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <utility>
+#include <sys/ioctl.h>
+#include <linux/videodev2.h>
+
+namespace bcc950 {
+
+// --- Watchdog ---
+
+Watchdog::Watchdog(std::function<void()> on_expire, double grace)
+    : on_expire_(std::move(on_expire))
+    , grace_(std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>(grace))) {
+}
+
+Watchdog::~Watchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exit_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Watchdog::ensure_started_locked() {
+    if (!thread_.joinable()) {
+        thread_ = std::thread(&Watchdog::run, this);
+    }
+}
+
+uint64_t Watchdog::arm(double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensure_started_locked();
+    uint64_t id = next_id_++;
+    deadlines_[id] = clock::now() + grace_ +
+        std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(seconds));
+    ++changes_;
+    cv_.notify_one();
+    return id;
+}
+
+void Watchdog::disarm(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deadlines_.erase(id)) {
+        ++changes_;
+        cv_.notify_one();
+    }
+}
+
+void Watchdog::heartbeat() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_heartbeat_ = clock::now();
+    ++changes_;
+    cv_.notify_one();
+}
+
+void Watchdog::set_heartbeat_timeout(double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    heartbeat_timeout_ = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+    last_heartbeat_ = clock::now();
+    ++changes_;
+    cv_.notify_one();
+}
+
+uint64_t Watchdog::expirations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return expirations_;
+}
+
+void Watchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!exit_) {
+        if (deadlines_.empty()) {
+            uint64_t seen = changes_;
+            cv_.wait(lock, [&] { return exit_ || changes_ != seen; });
+            continue;
+        }
+
+        auto earliest = std::min_element(
+            deadlines_.begin(), deadlines_.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; }
+        )->second;
+        if (heartbeat_timeout_.count() > 0) {
+            earliest = std::min(earliest, last_heartbeat_ + heartbeat_timeout_);
+        }
+
+        uint64_t seen = changes_;
+        if (cv_.wait_until(lock, earliest,
+                           [&] { return exit_ || changes_ != seen; })) {
+            continue;  // state changed; recompute the earliest deadline
+        }
+
+        // A mover overstayed its deadline or the heartbeat lapsed.
+        deadlines_.clear();
+        ++expirations_;
+        lock.unlock();
+        on_expire_();
+        lock.lock();
+    }
+}
+
+// --- Process-wide emergency stop ---
+
+namespace {
+
+constexpr std::size_t MAX_EMERGENCY_FDS = 16;
+
+// Slots hold fd + 1 so that zero means empty. Lock-free so the signal
+// handler can walk them.
+std::atomic<int> g_emergency_fds[MAX_EMERGENCY_FDS];
+
+struct sigaction g_prev_sigint;
+struct sigaction g_prev_sigterm;
+std::atomic<bool> g_handlers_installed{false};
+
+void write_zero(int fd, uint32_t id) {
+    struct v4l2_control ctrl{};
+    ctrl.id = id;
+    ctrl.value = 0;
+    ::ioctl(fd, VIDIOC_S_CTRL, &ctrl);
+}
+
+void safety_signal_handler(int sig, siginfo_t* info, void* context) {
+    emergency_stop_all();
+
+    const struct sigaction& prev = (sig == SIGINT) ? g_prev_sigint : g_prev_sigterm;
+    if (prev.sa_flags & SA_SIGINFO) {
+        // Chained handlers see the signal exactly as the kernel delivered it.
+        prev.sa_sigaction(sig, info, context);
+        return;
+    }
+    if (prev.sa_handler == SIG_IGN) {
+        return;
+    }
+    if (prev.sa_handler == SIG_DFL) {
+        ::signal(sig, SIG_DFL);
+        ::raise(sig);
+        return;
+    }
+    prev.sa_handler(sig);
+}
+
+} // anonymous namespace
+
+bool register_emergency_stop_fd(int fd) {
+    for (auto& slot : g_emergency_fds) {
+        int expected = 0;
+        if (slot.compare_exchange_strong(expected, fd + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void unregister_emergency_stop_fd(int fd) {
+    for (auto& slot : g_emergency_fds) {
+        int expected = fd + 1;
+        if (slot.compare_exchange_strong(expected, 0)) {
+            return;
+        }
+    }
+}
+
+void emergency_stop_all() {
+    for (auto& slot : g_emergency_fds) {
+        int v = slot.load();
+        if (v > 0) {
+            write_zero(v - 1, CTRL_PAN_SPEED);
+            write_zero(v - 1, CTRL_TILT_SPEED);
+        }
+    }
+}
+
+void install_safety_handlers() {
+    if (g_handlers_installed.exchange(true)) {
+        return;
+    }
+
+    struct sigaction sa{};
+    sa.sa_sigaction = safety_signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_SIGINFO;
+    ::sigaction(SIGINT, &sa, &g_prev_sigint);
+    ::sigaction(SIGTERM, &sa, &g_prev_sigterm);
+
+    std::atexit([] { emergency_stop_all(); });
+}
+
+} // namespace bcc950
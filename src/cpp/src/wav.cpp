@@ -0,0 +1,157 @@
+#include "bcc950/wav.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace bcc950 {
+
+namespace {
+
+constexpr uint16_t FORMAT_PCM        = 0x0001;
+constexpr uint16_t FORMAT_FLOAT      = 0x0003;
+constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void put16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, static_cast<uint16_t>(v));
+    put16(out, static_cast<uint16_t>(v >> 16));
+}
+
+void put_tag(std::vector<uint8_t>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+} // anonymous namespace
+
+WavAudio read_wav(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open WAV file: " + path);
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+        std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("Not a RIFF/WAVE file: " + path);
+    }
+
+    uint16_t format = 0;
+    uint16_t bits = 0;
+    WavAudio audio;
+    const uint8_t* data = nullptr;
+    std::size_t data_size = 0;
+
+    // Walk the chunks; sizes are padded to even lengths.
+    std::size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + pos;
+        std::size_t size = get32(chunk + 4);
+        std::size_t avail = std::min(size, bytes.size() - pos - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && avail >= 16) {
+            format = get16(chunk + 8);
+            audio.channels = get16(chunk + 10);
+            audio.sample_rate = static_cast<int>(get32(chunk + 12));
+            bits = get16(chunk + 22);
+            if (format == FORMAT_EXTENSIBLE && avail >= 26) {
+                format = get16(chunk + 32);  // first two bytes of the subformat GUID
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            data_size = avail;  // tolerate truncated recordings
+        }
+        pos += 8 + size + (size & 1);
+    }
+
+    if (audio.channels <= 0 || audio.sample_rate <= 0 || !data) {
+        throw std::runtime_error("Missing fmt or data chunk: " + path);
+    }
+    const bool pcm = format == FORMAT_PCM &&
+                     (bits == 8 || bits == 16 || bits == 24 || bits == 32);
+    const bool flt = format == FORMAT_FLOAT && bits == 32;
+    if (!pcm && !flt) {
+        throw std::runtime_error("Unsupported WAV encoding (format " +
+                                 std::to_string(format) + ", " +
+                                 std::to_string(bits) + " bits): " + path);
+    }
+
+    const std::size_t width = bits / 8;
+    const std::size_t frame = width * static_cast<std::size_t>(audio.channels);
+    const std::size_t count = data_size / frame * static_cast<std::size_t>(audio.channels);
+    audio.samples.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint8_t* p = data + i * width;
+        float v = 0.0f;
+        if (flt) {
+            uint32_t u = get32(p);
+            std::memcpy(&v, &u, sizeof(v));
+        } else if (bits == 8) {
+            v = (static_cast<int>(p[0]) - 128) / 128.0f;  // unsigned
+        } else if (bits == 16) {
+            v = static_cast<int16_t>(get16(p)) / 32768.0f;
+        } else if (bits == 24) {
+            uint32_t u = (static_cast<uint32_t>(p[0]) << 8) |
+                         (static_cast<uint32_t>(p[1]) << 16) |
+                         (static_cast<uint32_t>(p[2]) << 24);
+            v = static_cast<float>(static_cast<int32_t>(u) / 2147483648.0);
+        } else {
+            v = static_cast<float>(static_cast<int32_t>(get32(p)) / 2147483648.0);
+        }
+        audio.samples[i] = v;
+    }
+    return audio;
+}
+
+void write_wav(const std::string& path, const WavAudio& audio) {
+    if (audio.channels <= 0 || audio.sample_rate <= 0) {
+        throw std::runtime_error("Invalid WAV format for " + path);
+    }
+    const auto channels = static_cast<uint16_t>(audio.channels);
+    const auto rate = static_cast<uint32_t>(audio.sample_rate);
+    const auto data_size = static_cast<uint32_t>(audio.samples.size() * 2);
+
+    std::vector<uint8_t> out;
+    out.reserve(44 + data_size);
+    put_tag(out, "RIFF");
+    put32(out, 36 + data_size);
+    put_tag(out, "WAVE");
+    put_tag(out, "fmt ");
+    put32(out, 16);
+    put16(out, FORMAT_PCM);
+    put16(out, channels);
+    put32(out, rate);
+    put32(out, rate * channels * 2);
+    put16(out, static_cast<uint16_t>(channels * 2));
+    put16(out, 16);
+    put_tag(out, "data");
+    put32(out, data_size);
+    for (float x : audio.samples) {
+        float c = std::clamp(x, -1.0f, 1.0f);
+        put16(out, static_cast<uint16_t>(static_cast<int16_t>(std::lround(c * 32767.0f))));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(out.data()),
+                    static_cast<std::streamsize>(out.size()))) {
+        throw std::runtime_error("Cannot write WAV file: " + path);
+    }
+}
+
+} // namespace bcc950
@@ -0,0 +1,56 @@
+#include "bcc950/zoom_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bcc950 {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+double to_radians(double deg) { return deg * PI / 180.0; }
+double to_degrees(double rad) { return rad * 180.0 / PI; }
+
+} // anonymous namespace
+
+double ZoomModel::slew_time(double from, double to) const {
+    if (from == to) {
+        return 0.0;
+    }
+    return slew_latency + std::abs(to - from) / slew_rate;
+}
+
+double ZoomModel::zoom_at(double from, double to, double elapsed) const {
+    double moving = std::max(elapsed - slew_latency, 0.0);
+    double travel = std::min(std::abs(to - from), moving * slew_rate);
+    return to >= from ? from + travel : from - travel;
+}
+
+double ZoomModel::magnification(double zoom) const {
+    return std::max(zoom, static_cast<double>(ZOOM_MIN)) / ZOOM_MIN;
+}
+
+double ZoomModel::fov(Axis axis, double zoom) const {
+    // Zooming divides the tangent of the half-angle, not the angle.
+    double wide = axis == Axis::Pan ? hfov_wide : vfov_wide;
+    double half = std::atan(std::tan(to_radians(wide) / 2.0) / magnification(zoom));
+    return to_degrees(2.0 * half);
+}
+
+double ZoomModel::fov_rate(Axis axis, double zoom) const {
+    double rate = axis == Axis::Pan ? pan_rate : tilt_rate;
+    return rate / fov(axis, zoom);
+}
+
+double ZoomModel::movement_seconds(Axis axis, double fovs, double zoom) const {
+    return fovs / fov_rate(axis, zoom);
+}
+
+double ZoomModel::bearing_offset(Axis axis, double offset, double zoom) const {
+    double half = std::tan(to_radians(fov(axis, zoom)) / 2.0);
+    double rate = axis == Axis::Pan ? pan_rate : tilt_rate;
+    return to_degrees(std::atan(2.0 * offset * half)) / rate;
+}
+
+} // namespace bcc950
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "bcc950/frame_source.hpp"
+#include "bcc950/v4l2_device.hpp"
+
+namespace bcc950 {
+namespace testing {
+
+/// Scripted FrameSource for unit testing.
+///
+/// read() hands out pushed frames in order, blocking up to its timeout
+/// while the queue is empty. fail_next() makes the next read throw.
+class FakeFrameSource : public FrameSource {
+public:
+    FramePtr read(double timeout) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++reads_;
+        cv_.wait_for(lock, std::chrono::duration<double>(timeout),
+                     [this] { return !frames_.empty() || failures_ > 0; });
+        if (failures_ > 0) {
+            --failures_;
+            throw V4L2Error("fake capture failure");
+        }
+        if (frames_.empty()) {
+            return nullptr;
+        }
+        FramePtr frame = std::move(frames_.front());
+        frames_.pop_front();
+        return frame;
+    }
+
+    void push(FramePtr frame) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frames_.push_back(std::move(frame));
+        }
+        cv_.notify_all();
+    }
+
+    /// Push a frame with `bytes` as its payload.
+    void push(std::vector<uint8_t> bytes, uint64_t sequence, double timestamp,
+              int width = 640, int height = 480) {
+        push(std::make_shared<const Frame>(std::move(bytes), width, height,
+                                           sequence, timestamp));
+    }
+
+    void fail_next(int count = 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failures_ += count;
+        }
+        cv_.notify_all();
+    }
+
+    uint64_t reads() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reads_;
+    }
+
+private:
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    std::deque<FramePtr>    frames_;
+    int                     failures_ = 0;
+    uint64_t                reads_ = 0;
+};
+
+} // namespace testing
+} // namespace bcc950
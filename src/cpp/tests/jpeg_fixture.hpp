@@ -0,0 +1,50 @@
+#pragma once
+
+#ifdef BCC950_HAVE_JPEG
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+
+#include <jpeglib.h>
+
+namespace bcc950 {
+namespace testing {
+
+/// Encode packed 8-bit pixels (1 = gray, 3 = RGB components) as a
+/// baseline JPEG with libjpeg, for decoder and cache fixtures.
+inline std::vector<uint8_t> encode_jpeg(const std::vector<uint8_t>& pixels,
+                                        int width, int height, int components,
+                                        int quality = 95) {
+    jpeg_compress_struct cinfo{};
+    jpeg_error_mgr jerr{};
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    unsigned char* out = nullptr;
+    unsigned long out_size = 0;
+    jpeg_mem_dest(&cinfo, &out, &out_size);
+    cinfo.image_width = static_cast<JDIMENSION>(width);
+    cinfo.image_height = static_cast<JDIMENSION>(height);
+    cinfo.input_components = components;
+    cinfo.in_color_space = components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    const std::size_t stride = static_cast<std::size_t>(width) * components;
+    while (cinfo.next_scanline < cinfo.image_height) {
+        auto* row = const_cast<JSAMPLE*>(&pixels[cinfo.next_scanline * stride]);
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    std::vector<uint8_t> jpeg(out, out + out_size);
+    std::free(out);
+    return jpeg;
+}
+
+} // namespace testing
+} // namespace bcc950
+
+#endif
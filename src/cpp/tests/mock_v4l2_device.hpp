@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -15,6 +20,7 @@ namespace testing {
 ///
 /// Records every set_control call as a (id, value) pair and stores
 /// control values in a map so that get_control can return them.
+/// Internally locked so worker threads (scheduler, engines) can drive it.
 class MockV4L2Device : public IV4L2Device {
 public:
     using Call = std::pair<uint32_t, int32_t>;
@@ -25,16 +31,40 @@ public:
     // ---- IV4L2Device interface ----
 
     void set_control(uint32_t id, int32_t value) override {
+        if (double latency = write_latency_.load()) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(latency));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failing_.count(id)) {
+            throw V4L2Error("mock failure for control " + std::to_string(id));
+        }
         calls_.emplace_back(id, value);
         values_[id] = value;
     }
 
+    void set_controls(const ControlValue* values, std::size_t count) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.emplace_back(values, values + count);
+        }
+        IV4L2Device::set_controls(values, count);
+    }
+
     int32_t get_control(uint32_t id) override {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = values_.find(id);
         return (it != values_.end()) ? it->second : 0;
     }
 
     struct v4l2_queryctrl query_control(uint32_t id) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ranges_.find(id);
+        if (it != ranges_.end()) {
+            return it->second;
+        }
+        if (absent_.count(id)) {
+            throw V4L2Error("mock has no control " + std::to_string(id));
+        }
         struct v4l2_queryctrl qctrl{};
         qctrl.id = id;
         // Provide sensible defaults for testing
@@ -60,30 +90,84 @@ public:
 
     // ---- Test helpers ----
 
-    /// Return all recorded set_control calls.
-    const std::vector<Call>& get_calls() const { return calls_; }
+    /// Return a copy of all recorded set_control calls.
+    std::vector<Call> get_calls() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+
+    /// Clear the recorded call and batch logs.
+    void clear_calls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.clear();
+        batches_.clear();
+    }
 
-    /// Clear the recorded call log.
-    void clear_calls() { calls_.clear(); }
+    /// Return each set_controls() request (its writes also appear in
+    /// get_calls()).
+    std::vector<std::vector<ControlValue>> get_batches() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
 
     /// Return the stored value for a control id (0 if never set).
     int32_t get_stored_value(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = values_.find(id);
         return (it != values_.end()) ? it->second : 0;
     }
 
     /// Pre-seed a control value (e.g. to simulate initial zoom).
     void set_stored_value(uint32_t id, int32_t value) {
+        std::lock_guard<std::mutex> lock(mutex_);
         values_[id] = value;
     }
 
+    /// Make every subsequent set_control for `id` throw V4L2Error.
+    void fail_control(uint32_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failing_.insert(id);
+    }
+
+    /// Make every subsequent set_control take this long, like a slow
+    /// USB control transfer.
+    void set_write_latency(double seconds) {
+        write_latency_ = seconds;
+    }
+
+    /// Add a control to the catalog with the given range (the
+    /// positional pan/tilt controls are absent, as on the BCC950, until
+    /// added).
+    void add_control(uint32_t id, int32_t minimum, int32_t maximum, int32_t step = 1,
+                     uint32_t flags = 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        struct v4l2_queryctrl qctrl{};
+        qctrl.id = id;
+        qctrl.type = V4L2_CTRL_TYPE_INTEGER;
+        qctrl.minimum = minimum;
+        qctrl.maximum = maximum;
+        qctrl.step = step;
+        qctrl.flags = flags;
+        ranges_[id] = qctrl;
+    }
+
     /// Return total number of set_control calls recorded.
-    std::size_t call_count() const { return calls_.size(); }
+    std::size_t call_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
 
 private:
+    mutable std::mutex mutex_;
     bool open_ = true;
+    std::atomic<double> write_latency_{0.0};
     std::vector<Call> calls_;
+    std::vector<std::vector<ControlValue>> batches_;
     std::unordered_map<uint32_t, int32_t> values_;
+    std::unordered_set<uint32_t> failing_;
+    std::unordered_map<uint32_t, struct v4l2_queryctrl> ranges_;
+    std::unordered_set<uint32_t> absent_{V4L2_CID_PAN_ABSOLUTE, V4L2_CID_TILT_ABSOLUTE,
+                                         V4L2_CID_PAN_RELATIVE, V4L2_CID_TILT_RELATIVE};
 };
 
 } // namespace testing
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "bcc950/audio_doa.hpp"
+#include "bcc950/wav.hpp"
+
+namespace bcc950 {
+namespace {
+
+constexpr int RATE = AUDIO_SAMPLE_RATE;
+
+/// Per-process path, so concurrent runs of the binary do not collide.
+std::string temp_path(const std::string& name) {
+    return ::testing::TempDir() + "bcc950_" + std::to_string(::getpid()) + "_" + name;
+}
+
+// Stereo recording of a noise source whose sound reaches the left mic
+// `lag` samples after the right one (negative: left first), with an
+// echo and uncorrelated mic noise on each channel.
+WavAudio recording(int lag, double seconds = 0.5, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> voice(0.0f, 0.1f);
+    std::normal_distribution<float> hiss(0.0f, 0.01f);
+    const auto frames = static_cast<std::size_t>(seconds * RATE);
+    const std::size_t pad = 64;
+    std::vector<float> source(frames + 2 * pad);
+    for (float& x : source) {
+        x = voice(rng);
+    }
+    WavAudio audio;
+    audio.sample_rate = RATE;
+    audio.channels = 2;
+    audio.samples.resize(frames * 2);
+    for (std::size_t t = 0; t < frames; ++t) {
+        std::size_t r = t + pad;
+        std::size_t l = t + pad - static_cast<std::size_t>(lag);
+        audio.samples[2 * t]     = source[l] + 0.3f * source[l - 40] + hiss(rng);
+        audio.samples[2 * t + 1] = source[r] + 0.3f * source[r - 40] + hiss(rng);
+    }
+    return audio;
+}
+
+TEST(WavTest, RoundTripsSixteenBitPcm) {
+    WavAudio audio;
+    audio.sample_rate = 16000;
+    audio.channels = 2;
+    audio.samples = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 0.25f, 2.0f, -3.0f};
+    std::string path = temp_path("roundtrip.wav");
+    write_wav(path, audio);
+
+    WavAudio back = read_wav(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(back.sample_rate, 16000);
+    EXPECT_EQ(back.channels, 2);
+    ASSERT_EQ(back.frames(), 4u);
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(back.samples[i], audio.samples[i], 1.0 / 32767);
+    }
+    EXPECT_NEAR(back.samples[6], 1.0f, 1.0 / 32767);   // clipped
+    EXPECT_NEAR(back.samples[7], -1.0f, 1.0 / 32767);
+}
+
+TEST(WavTest, ReadsExtensibleFloat) {
+    // WAVE_FORMAT_EXTENSIBLE, one channel of 32-bit float, two samples.
+    const float samples[2] = {0.25f, -0.75f};
+    std::vector<uint8_t> b;
+    auto tag = [&](const char* s) { b.insert(b.end(), s, s + 4); };
+    auto u16 = [&](uint16_t v) { b.push_back(v & 0xFF); b.push_back(v >> 8); };
+    auto u32 = [&](uint32_t v) { u16(v & 0xFFFF); u16(v >> 16); };
+    tag("RIFF"); u32(4 + 8 + 40 + 8 + 8); tag("WAVE");
+    tag("fmt "); u32(40);
+    u16(0xFFFE); u16(1); u32(48000); u32(48000 * 4); u16(4); u16(32);
+    u16(22); u16(32); u32(0x4);
+    u16(3); u16(0); u32(0x00100000); u32(0xAA000080); u32(0x719B3800);
+    tag("data"); u32(8);
+    const auto* p = reinterpret_cast<const uint8_t*>(samples);
+    b.insert(b.end(), p, p + 8);
+
+    std::string path = temp_path("float.wav");
+    std::ofstream(path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(b.data()), static_cast<std::streamsize>(b.size()));
+    WavAudio audio = read_wav(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(audio.sample_rate, 48000);
+    ASSERT_EQ(audio.frames(), 2u);
+    EXPECT_FLOAT_EQ(audio.samples[0], 0.25f);
+    EXPECT_FLOAT_EQ(audio.samples[1], -0.75f);
+}
+
+TEST(WavTest, RejectsOtherFiles) {
+    std::string path = temp_path("bogus.wav");
+    std::ofstream(path) << "not a wave file";
+    EXPECT_THROW(read_wav(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(read_wav(path), std::runtime_error);
+}
+
+TEST(AudioDoaTest, RecoversDelaysFromRecordings) {
+    DoaEstimator doa(RATE);
+    // 0.06 m at 343 m/s allows about 7.7 samples at 44.1 kHz.
+    EXPECT_NEAR(doa.max_delay() * RATE, 7.71, 0.01);
+
+    for (int lag : {-6, -3, 0, 2, 5}) {
+        std::string path = temp_path("doa.wav");
+        write_wav(path, recording(lag));
+        WavAudio audio = read_wav(path);
+        std::remove(path.c_str());
+
+        auto e = doa.estimate(audio.samples.data(), audio.frames(), audio.channels, 10.0);
+        ASSERT_TRUE(e) << lag;
+        EXPECT_NEAR(e->delay * RATE, lag, 0.25) << lag;
+        double expected = std::asin(lag / (doa.max_delay() * RATE)) * 180.0 / M_PI;
+        EXPECT_NEAR(e->azimuth, expected, 3.0) << lag;
+        EXPECT_GT(e->strength, 0.3) << lag;
+        EXPECT_NEAR(e->timestamp, 10.0 + 0.5 * doa.window() / RATE, 1e-9);
+    }
+}
+
+TEST(AudioDoaTest, SwappedChannelsMirrorTheAzimuth) {
+    DoaConfig config;
+    config.left_channel = 1;
+    config.right_channel = 0;
+    DoaEstimator doa(RATE, config);
+    WavAudio audio = recording(4);
+    auto e = doa.estimate(audio.samples.data(), audio.frames(), 2, 0.0);
+    ASSERT_TRUE(e);
+    EXPECT_NEAR(e->delay * RATE, -4.0, 0.25);
+    EXPECT_LT(e->azimuth, 0.0);
+}
+
+TEST(AudioDoaTest, RejectsSilenceAndDiffuseNoise) {
+    DoaEstimator doa(RATE);
+    std::vector<float> silence(doa.window() * 2, 0.0f);
+    EXPECT_FALSE(doa.estimate(silence.data(), doa.window(), 2, 0.0));
+
+    // Independent noise on each mic has no consistent delay.
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    std::vector<float> diffuse(doa.window() * 2);
+    for (float& x : diffuse) {
+        x = noise(rng);
+    }
+    EXPECT_FALSE(doa.estimate(diffuse.data(), doa.window(), 2, 0.0));
+
+    // Too short, or mono.
+    WavAudio audio = recording(2);
+    EXPECT_FALSE(doa.estimate(audio.samples.data(), doa.window() - 1, 2, 0.0));
+    EXPECT_FALSE(doa.estimate(audio.samples.data(), doa.window(), 1, 0.0));
+}
+
+TEST(AudioDoaTest, EstimatesFromTheRingAndSteersPan) {
+    WavAudio audio = recording(-5, 0.3);
+    AudioRing ring(RATE, 2, 1.0);
+    DoaEstimator doa(RATE);
+    EXPECT_FALSE(doa.estimate(ring));
+    ring.write(audio.samples.data(), audio.frames(), 50.0);
+
+    auto e = doa.estimate(ring);
+    ASSERT_TRUE(e);
+    EXPECT_NEAR(e->delay * RATE, -5.0, 0.25);
+    EXPECT_NEAR(e->timestamp, 50.3 - 0.5 * doa.window() / RATE, 1e-6);
+
+    PoseHistory history;
+    PoseSample pose;
+    pose.timestamp = 49.0;
+    pose.pan = 1.5;
+    pose.tilt = 0.4;
+    history.record(pose);
+
+    DoaConfig config;
+    config.pan_offset = 0.25;
+    auto b = speaker_bearing(history, *e, config);
+    ASSERT_TRUE(b);
+    // The mics are in the fixed base: the head's pan does not matter.
+    EXPECT_NEAR(b->pan, 0.25 + e->azimuth / PAN_DEG_PER_SEC, 1e-9);
+    EXPECT_LT(b->pan, 0.25);
+    EXPECT_DOUBLE_EQ(b->tilt, 0.4);
+
+    EXPECT_FALSE(speaker_bearing(PoseHistory{}, *e));
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "bcc950/audio_capture.hpp"
+#include "bcc950/audio_vad.hpp"
+
+namespace bcc950 {
+namespace {
+
+constexpr int RATE = 16000;
+
+// Silence, then a tone burst, then silence.
+std::vector<float> burst(double lead, double tone, double tail, float amplitude = 0.2f) {
+    std::vector<float> out;
+    auto n = [](double s) { return static_cast<std::size_t>(std::lround(s * RATE)); };
+    out.resize(n(lead), 0.0f);
+    for (std::size_t i = 0; i < n(tone); ++i) {
+        out.push_back(amplitude * static_cast<float>(std::sin(2.0 * M_PI * 440.0 * i / RATE)));
+    }
+    out.resize(out.size() + n(tail), 0.0f);
+    return out;
+}
+
+// Feed in uneven chunks, as a capture loop would.
+std::vector<SpeechSegment> run(VoiceActivityDetector& vad, const std::vector<float>& audio,
+                               double t0) {
+    std::vector<SpeechSegment> out;
+    std::size_t i = 0;
+    std::size_t chunk = 317;
+    while (i < audio.size()) {
+        std::size_t n = std::min(chunk, audio.size() - i);
+        auto done = vad.process(audio.data() + i, n, t0 + static_cast<double>(i) / RATE);
+        out.insert(out.end(), done.begin(), done.end());
+        i += n;
+        chunk = chunk == 317 ? 211 : 317;
+    }
+    return out;
+}
+
+TEST(AudioVadTest, BlockStatsMatchesScalar) {
+    std::vector<float> x;
+    for (int i = 0; i < 37; ++i) {
+        x.push_back(std::sin(0.37f * i) * (i % 5 == 0 ? -0.9f : 0.3f));
+    }
+    for (std::size_t n : {0u, 1u, 3u, 4u, 7u, 16u, 37u}) {
+        float peak = 0.0f;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            peak = std::max(peak, std::abs(x[i]));
+            sum += static_cast<double>(x[i]) * x[i];
+        }
+        BlockStats s = block_stats(x.data(), n);
+        EXPECT_FLOAT_EQ(s.peak, peak) << n;
+        EXPECT_NEAR(s.rms, n ? std::sqrt(sum / n) : 0.0, 1e-6) << n;
+    }
+}
+
+TEST(AudioVadTest, EmitsOneSegmentForABurst) {
+    VoiceActivityDetector vad(RATE);
+    auto segments = run(vad, burst(1.0, 1.0, 1.5), 100.0);
+
+    ASSERT_EQ(segments.size(), 1u);
+    const SpeechSegment& s = segments[0];
+    EXPECT_EQ(s.sample_rate, RATE);
+    // Starts a pre-roll before the tone, ends within a pre-roll after it.
+    EXPECT_NEAR(s.start, 101.0 - VAD_PRE_ROLL_SECONDS, VAD_BLOCK_SECONDS);
+    EXPECT_GE(s.end, 102.0);
+    EXPECT_LE(s.end, 102.0 + VAD_PRE_ROLL_SECONDS + VAD_BLOCK_SECONDS);
+    EXPECT_NEAR(static_cast<double>(s.samples.size()) / RATE, s.duration(), 1e-6);
+    EXPECT_FALSE(vad.in_speech());
+}
+
+TEST(AudioVadTest, SilenceAndBlipsProduceNothing) {
+    VoiceActivityDetector vad(RATE);
+    EXPECT_TRUE(run(vad, burst(2.0, 0.0, 0.0), 0.0).empty());
+    // Shorter than the onset.
+    EXPECT_TRUE(run(vad, burst(0.5, 0.03, 1.0), 2.0).empty());
+    // Below the thresholds.
+    EXPECT_TRUE(run(vad, burst(0.5, 1.0, 1.0, 0.002f), 4.0).empty());
+}
+
+TEST(AudioVadTest, ShortSegmentsAreDropped) {
+    VadConfig config;
+    config.pre_roll_seconds = 0.0;
+    config.hangover_seconds = 0.1;
+    config.min_segment_seconds = 0.5;
+    VoiceActivityDetector vad(RATE, config);
+    EXPECT_TRUE(run(vad, burst(0.5, 0.2, 1.0), 0.0).empty());
+    EXPECT_EQ(run(vad, burst(0.5, 0.8, 1.0), 2.0).size(), 1u);
+}
+
+TEST(AudioVadTest, LongSpeechIsSplit) {
+    VadConfig config;
+    config.max_segment_seconds = 1.0;
+    VoiceActivityDetector vad(RATE, config);
+    auto segments = run(vad, burst(0.5, 2.5, 1.5), 0.0);
+
+    ASSERT_GE(segments.size(), 3u);
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+        EXPECT_LE(segments[i].duration(), 1.0 + VAD_BLOCK_SECONDS);
+        EXPECT_NEAR(segments[i].end, segments[i + 1].start, 1e-9);
+    }
+}
+
+TEST(AudioVadTest, FlushClosesAnOpenSegment) {
+    VoiceActivityDetector vad(RATE);
+    EXPECT_TRUE(run(vad, burst(0.5, 1.0, 0.0), 0.0).empty());
+    EXPECT_TRUE(vad.in_speech());
+
+    auto segments = vad.flush();
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_NEAR(segments[0].end, 1.5, 1e-6);
+    EXPECT_FALSE(vad.in_speech());
+    EXPECT_TRUE(vad.flush().empty());
+}
+
+TEST(AudioRingTest, KeepsTheNewestFramesWithTimes) {
+    AudioRing ring(100, 2, 0.1);  // 10 frames
+    ASSERT_EQ(ring.capacity(), 10u);
+    std::vector<float> out;
+    EXPECT_FALSE(ring.latest(1, out));
+
+    std::vector<float> chunk;
+    for (int i = 0; i < 7; ++i) {
+        chunk.push_back(static_cast<float>(i));
+        chunk.push_back(static_cast<float>(-i));
+    }
+    ring.write(chunk.data(), 7, 5.0);
+    ring.write(chunk.data(), 7, 5.07);  // wraps
+    EXPECT_EQ(ring.frames_written(), 14u);
+
+    auto t = ring.latest(10, out);
+    ASSERT_TRUE(t);
+    EXPECT_NEAR(*t, 5.04, 1e-9);
+    ASSERT_EQ(out.size(), 20u);
+    EXPECT_EQ(out[0], 4.0f);   // frame 4 of the first write
+    EXPECT_EQ(out[1], -4.0f);
+    EXPECT_EQ(out[6], 0.0f);   // frame 0 of the second write
+    EXPECT_EQ(out[19], -6.0f);
+    EXPECT_FALSE(ring.latest(11, out));
+
+    // Oversized writes keep only the tail.
+    std::vector<float> big(30 * 2, 1.0f);
+    big[58] = 9.0f;
+    ring.write(big.data(), 30, 6.0);
+    t = ring.latest(1, out);
+    ASSERT_TRUE(t);
+    EXPECT_NEAR(*t, 6.29, 1e-9);
+    EXPECT_EQ(out[0], 9.0f);
+}
+
+TEST(AudioCaptureTest, FeedQueuesSpeechSegments) {
+    AudioFormat format;
+    format.sample_rate = RATE;
+    format.channels = 2;
+    AudioCapture capture(format);
+
+    auto mono = burst(0.5, 1.0, 1.0);
+    std::vector<float> stereo;
+    for (float x : mono) {
+        stereo.push_back(x);
+        stereo.push_back(x);
+    }
+    EXPECT_FALSE(capture.next_segment(0.0));
+    capture.feed(stereo.data(), mono.size(), 10.0);
+
+    auto s = capture.next_segment(1.0);
+    ASSERT_TRUE(s);
+    EXPECT_NEAR(s->start, 10.5 - VAD_PRE_ROLL_SECONDS, VAD_BLOCK_SECONDS);
+    EXPECT_EQ(capture.ring().frames_written(), mono.size());
+    EXPECT_FALSE(capture.next_segment(0.0));
+    EXPECT_EQ(capture.dropped_segments(), 0u);
+}
+
+TEST(AudioCaptureTest, StartWithoutAlsaThrows) {
+    AudioCapture capture;
+    if (AudioCapture::supported()) {
+        GTEST_SKIP() << "built with ALSA";
+    }
+    EXPECT_THROW(capture.start(), std::runtime_error);
+    EXPECT_FALSE(capture.running());
+    capture.stop();
+}
+
+} // namespace
+} // namespace bcc950
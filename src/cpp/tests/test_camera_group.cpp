@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bcc950/camera_group.hpp"
+#include "bcc950/constants.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+struct Rig {
+    explicit Rig(int n) {
+        for (int i = 0; i < n; ++i) {
+            auto device = std::make_unique<testing::MockV4L2Device>();
+            mocks.push_back(device.get());
+            cameras.push_back(std::make_unique<Controller>(std::move(device), "", "/dev/null",
+                                                           "/dev/null"));
+        }
+    }
+
+    std::vector<GroupMove> moves(int pan_dir, int tilt_dir) {
+        std::vector<GroupMove> out;
+        for (auto& c : cameras) {
+            out.push_back(GroupMove{c.get(), pan_dir, tilt_dir});
+        }
+        return out;
+    }
+
+    std::vector<testing::MockV4L2Device*> mocks;
+    std::vector<std::unique_ptr<Controller>> cameras;
+};
+
+TEST(CameraGroupTest, StartsAndStopsTogether) {
+    Rig rig(3);
+    auto moves = rig.moves(1, 0);
+    moves[2].pan_dir = -1;
+    moves[2].tilt_dir = 1;
+    GroupMoveReport report = synchronized_move(moves, 0.05);
+
+    ASSERT_EQ(report.cameras.size(), 3u);
+    EXPECT_TRUE(report.completed());
+    for (const auto& c : report.cameras) {
+        EXPECT_GE(c.start_late, 0.0);
+        EXPECT_LT(c.start_late, 0.02);
+        EXPECT_LT(c.stop_late, 0.02);
+    }
+    EXPECT_LT(report.start_skew, 0.02);
+    EXPECT_LT(report.stop_skew, 0.02);
+
+    // One start and one stop batch per camera.
+    for (auto* mock : rig.mocks) {
+        auto batches = mock->get_batches();
+        ASSERT_EQ(batches.size(), 2u);
+        EXPECT_EQ(batches[1].size(), batches[0].size());
+    }
+    // Travel runs from each camera's actual start (between the deadline
+    // and the start write returning) to the shared stop.
+    for (int i : {0, 2}) {
+        double pan = std::abs(rig.cameras[i]->position().pan);
+        EXPECT_LE(pan, 0.05 + 1e-9);
+        EXPECT_GE(pan, 0.05 - report.cameras[i].start_late - 1e-3);
+    }
+    EXPECT_DOUBLE_EQ(rig.cameras[2]->position().tilt, -rig.cameras[2]->position().pan);
+}
+
+TEST(CameraGroupTest, BusyCameraStartsLateButStopsOnTime) {
+    Rig rig(2);
+    std::thread busy([&] { rig.cameras[1]->move(-1, 0, 0.12); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    GroupMoveReport report = synchronized_move(rig.moves(1, 0), 0.2, 0.02);
+    busy.join();
+
+    ASSERT_TRUE(report.completed());
+    const auto& late = report.cameras[1];
+    EXPECT_GT(late.start_late, 0.05);
+    EXPECT_LT(late.stop_late, 0.02);
+    EXPECT_GT(report.start_skew, 0.05);
+    EXPECT_LT(report.stop_skew, 0.02);
+    // Only the time actually moving is credited.
+    EXPECT_NEAR(rig.cameras[1]->position().pan, -0.12 + 0.2 - late.start_late, 0.005);
+}
+
+TEST(CameraGroupTest, CameraBusyPastTheStopNeverStarts) {
+    Rig rig(2);
+    std::thread busy([&] { rig.cameras[1]->move(-1, 0, 0.15); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    rig.mocks[1]->clear_calls();
+
+    GroupMoveReport report = synchronized_move(rig.moves(1, 0), 0.05, 0.02);
+    busy.join();
+
+    EXPECT_TRUE(report.cameras[0].completed);
+    EXPECT_FALSE(report.cameras[1].completed);
+    // Only the busy move's own stop went out; no start-stop twitch.
+    auto calls = rig.mocks[1]->get_calls();
+    for (const auto& call : calls) {
+        EXPECT_EQ(call.second, 0);
+    }
+    EXPECT_NEAR(rig.cameras[1]->position().pan, -0.15, 1e-9);
+}
+
+TEST(CameraGroupTest, CancelledCameraNeverStarts) {
+    Rig rig(2);
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        rig.cameras[0]->stop();
+    });
+    GroupMoveReport report = synchronized_move(rig.moves(1, 1), 0.05, 0.1);
+    canceller.join();
+
+    EXPECT_FALSE(report.completed());
+    EXPECT_FALSE(report.cameras[0].completed);
+    EXPECT_TRUE(report.cameras[1].completed);
+    EXPECT_DOUBLE_EQ(report.start_skew, 0.0);
+    EXPECT_EQ(rig.mocks[0]->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_DOUBLE_EQ(rig.cameras[0]->position().pan, 0.0);
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/control_pacer.hpp"
+#include "bcc950/controller.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since(clock_type::time_point t) {
+    return std::chrono::duration<double>(clock_type::now() - t).count();
+}
+
+PacerConfig fixed_rate(double rate, double burst) {
+    PacerConfig config;
+    config.initial_rate = rate;
+    config.min_rate = 1.0;
+    config.burst = burst;
+    config.increase = 0.0;
+    return config;
+}
+
+class ControlPacerTest : public ::testing::Test {
+protected:
+    void make(const PacerConfig& config) {
+        auto device = std::make_unique<testing::MockV4L2Device>();
+        mock_ = device.get();
+        pacer_ = std::make_unique<ControlPacer>(std::move(device), config);
+    }
+
+    testing::MockV4L2Device* mock_ = nullptr;
+    std::unique_ptr<ControlPacer> pacer_;
+};
+
+TEST_F(ControlPacerTest, SpendsTheBurstThenPaces) {
+    make(fixed_rate(20.0, 2.0));
+    auto start = clock_type::now();
+    for (int i = 0; i < 6; ++i) {
+        pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 100 + i);
+    }
+    EXPECT_GE(seconds_since(start), 0.18);  // four writes at 20/s
+    EXPECT_EQ(mock_->call_count(), 6u);
+
+    PacerStats s = pacer_->stats();
+    EXPECT_EQ(s.writes, 6u);
+    EXPECT_EQ(s.delayed, 4u);
+    EXPECT_EQ(s.merged, 0u);
+    EXPECT_GT(pacer_->backlog(), 0.0);
+}
+
+TEST_F(ControlPacerTest, NewerValueReplacesAWaitingWrite) {
+    make(fixed_rate(10.0, 1.0));
+    pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 100);  // spends the token
+
+    std::thread older([&] { pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 150); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 200);
+    older.join();
+
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[1], (testing::MockV4L2Device::Call{CTRL_ZOOM_ABSOLUTE, 200}));
+    EXPECT_EQ(pacer_->stats().merged, 1u);
+}
+
+TEST_F(ControlPacerTest, StopsNeverWaitAndCancelAWaitingStart) {
+    make(fixed_rate(2.0, 1.0));
+    pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 100);
+
+    std::thread start_write([&] { pacer_->set_control(CTRL_PAN_SPEED, 1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto start = clock_type::now();
+    ControlValue stop[] = {{CTRL_PAN_SPEED, 0}, {CTRL_TILT_SPEED, 0}};
+    pacer_->set_controls(stop, 2);
+    EXPECT_LT(seconds_since(start), 0.05);
+    start_write.join();
+    EXPECT_LT(seconds_since(start), 0.1);  // the stale start left at once
+
+    // The start never followed the stop.
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 3u);
+    EXPECT_EQ(calls[1], (testing::MockV4L2Device::Call{CTRL_PAN_SPEED, 0}));
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(pacer_->stats().merged, 1u);
+    EXPECT_GT(pacer_->backlog(), 1.0);  // the stop overdrew the bucket
+}
+
+TEST_F(ControlPacerTest, StopCancelsAWaitingBatchedStart) {
+    make(fixed_rate(2.0, 2.0));
+    pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 100);
+
+    std::thread start_write([&] {
+        ControlValue start[] = {{CTRL_PAN_SPEED, 1}, {CTRL_TILT_SPEED, 1}};
+        pacer_->set_controls(start, 2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto start = clock_type::now();
+    ControlValue stop[] = {{CTRL_PAN_SPEED, 0}, {CTRL_TILT_SPEED, 0}};
+    pacer_->set_controls(stop, 2);
+    start_write.join();
+    EXPECT_LT(seconds_since(start), 0.1);  // the stale start left at once
+
+    // Only the zoom and the stop went out; the motors stay stopped.
+    auto batches = mock_->get_batches();
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0][0].value, 0);
+    EXPECT_EQ(batches[0][1].value, 0);
+    EXPECT_EQ(mock_->call_count(), 3u);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_TILT_SPEED), 0);
+    EXPECT_EQ(pacer_->stats().merged, 1u);
+}
+
+TEST_F(ControlPacerTest, LearnsTheRateFromTransfers) {
+    PacerConfig config;
+    config.initial_rate = 50.0;
+    config.increase = 1.0;
+    make(config);
+    for (int i = 0; i < 4; ++i) {
+        pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 100 + i);
+    }
+    PacerStats s = pacer_->stats();
+    EXPECT_DOUBLE_EQ(s.rate, 54.0);
+    EXPECT_GT(s.latency, 0.0);
+
+    mock_->set_write_latency(0.03);  // the firmware bogs down
+    pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 120);
+    s = pacer_->stats();
+    EXPECT_EQ(s.stalls, 1u);
+    EXPECT_DOUBLE_EQ(s.rate, 27.0);
+    EXPECT_LT(s.latency, 0.005);  // stalls stay out of the baseline
+
+    mock_->set_write_latency(0.0);
+    mock_->fail_control(CTRL_ZOOM_ABSOLUTE);
+    EXPECT_THROW(pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 130), V4L2Error);
+    s = pacer_->stats();
+    EXPECT_EQ(s.errors, 1u);
+    EXPECT_DOUBLE_EQ(s.rate, 13.5);
+    EXPECT_GT(pacer_->backlog(), 0.0);
+
+    // Never below the floor.
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_THROW(pacer_->set_control(CTRL_ZOOM_ABSOLUTE, 130), V4L2Error);
+    }
+    EXPECT_DOUBLE_EQ(pacer_->stats().rate, PACER_MIN_RATE);
+}
+
+TEST_F(ControlPacerTest, ControllerRunsThroughThePacer) {
+    auto device = std::make_unique<testing::MockV4L2Device>();
+    testing::MockV4L2Device* mock = device.get();
+    auto pacer = std::make_unique<ControlPacer>(std::move(device));
+    ControlPacer* paced = pacer.get();
+    Controller controller(std::move(pacer), "", "/dev/null", "/dev/null");
+
+    controller.move(1, 0, 0.02);
+    EXPECT_EQ(mock->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_NEAR(controller.position().pan, 0.02, 1e-9);
+    EXPECT_EQ(paced->stats().writes, 4u);
+    ASSERT_TRUE(controller.pacer_stats());
+    EXPECT_EQ(controller.pacer_stats()->writes, 4u);
+}
+
+} // namespace
+} // namespace bcc950
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "bcc950/constants.hpp"
@@ -220,5 +224,96 @@ TEST_F(ControllerTest, ResetPositionSetsZoomToDefault) {
     EXPECT_EQ(final_zoom, ZOOM_DEFAULT) << "Zoom should reset to ZOOM_DEFAULT (ZOOM_MIN)";
 }
 
+// ----- Position snapshot tests -----
+
+TEST_F(ControllerTest, PositionSnapshotFollowsMoves) {
+    controller_->move(1, -1, 0.05);
+    controller_->zoom_to(250);
+
+    PositionTracker pos = controller_->position();
+    EXPECT_DOUBLE_EQ(pos.pan, 0.05);
+    EXPECT_DOUBLE_EQ(pos.tilt, -0.05);
+    EXPECT_EQ(pos.zoom, 250);
+}
+
+TEST_F(ControllerTest, MoveToReachesBearingAndLogsPoses) {
+    controller_->move_to(0.05, -0.03);
+
+    PositionTracker pos = controller_->position();
+    EXPECT_NEAR(pos.pan, 0.05, 1e-9);
+    EXPECT_NEAR(pos.tilt, -0.03, 1e-9);
+    auto latest = controller_->pose_history().latest();
+    ASSERT_TRUE(latest.has_value());
+    EXPECT_NEAR(latest->pan, 0.05, 1e-9);
+}
+
+TEST_F(ControllerTest, ScanZoomsFirstAndTilesWithTheCalibratedLens) {
+    ZoomModel lens;
+    lens.hfov_wide = 0.45;  // a field of view is 0.02 movement-seconds wide
+    lens.vfov_wide = 0.45;
+    controller_->set_zoom_model(lens);
+
+    ScanSpec spec;
+    spec.pan_min = 0.0;
+    spec.pan_max = 0.06;
+    spec.tilt_min = spec.tilt_max = 0.0;
+    spec.zoom = 300;
+    spec.pattern = ScanPattern::Snapshots;
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(controller_->scan(spec));
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(elapsed, lens.slew_time(ZOOM_MIN, 300));
+    EXPECT_EQ(mock_->get_stored_value(CTRL_ZOOM_ABSOLUTE), 300);
+    // spec.optics would fit the range in one view, centred at 0.03; the
+    // calibrated lens tiles it edge to edge.
+    PositionTracker pos = controller_->position();
+    EXPECT_GT(std::abs(pos.pan - 0.03), 0.02);
+}
+
+TEST_F(ControllerTest, RecallPresetOnlyRestoresZoomInVelocityMode) {
+    EXPECT_EQ(controller_->ptz_mode(), PtzMode::Velocity);
+    controller_->move_to(0.04, -0.02);
+    controller_->zoom_to(300);
+    controller_->save_preset("desk");
+    controller_->move_to(0.0, 0.0);
+    controller_->zoom_to(ZOOM_MIN);
+    mock_->clear_calls();
+
+    ASSERT_TRUE(controller_->recall_preset("desk"));
+    PositionTracker pos = controller_->position();
+    EXPECT_NEAR(pos.pan, 0.0, 1e-9);
+    EXPECT_NEAR(pos.tilt, 0.0, 1e-9);
+    EXPECT_EQ(pos.zoom, 300);
+    ASSERT_EQ(mock_->call_count(), 1u);
+    EXPECT_EQ(mock_->get_calls()[0],
+              (testing::MockV4L2Device::Call{CTRL_ZOOM_ABSOLUTE, 300}));
+    EXPECT_FALSE(controller_->recall_preset("missing"));
+}
+
+TEST_F(ControllerTest, PositionReadableWhileMoving) {
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            PositionTracker pos = controller_->position();
+            // Every move below is a pure pan: tilt must never change and
+            // pan only ever takes whole-move values.
+            if (pos.tilt != 0.0 || pos.pan < 0.0 || pos.pan > 0.1 + 1e-9) {
+                ++bad;
+            }
+        }
+    });
+    for (int i = 0; i < 10; ++i) {
+        controller_->pan_right(0.01);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(bad.load(), 0);
+    EXPECT_NEAR(controller_->position().pan, 0.1, 1e-9);
+}
+
 } // anonymous namespace
 } // namespace bcc950
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "bcc950/controls.hpp"
+#include "bcc950/motion.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+
+// Found by argument lookup from gtest.
+inline bool operator==(const ControlValue& a, const ControlValue& b) {
+    return a.id == b.id && a.value == b.value;
+}
+
+namespace {
+
+// Clamping is a constant expression.
+static_assert(PanSpeed::clamp(5) == PAN_SPEED_MAX);
+static_assert(TiltSpeed::clamp(-5) == TILT_SPEED_MIN);
+static_assert(ZoomAbsolute::clamp(0) == ZOOM_MIN);
+static_assert(ZoomAbsolute::clamp(250) == 250);
+static_assert(PanSpeed::id == V4L2_CID_PAN_SPEED);
+static_assert(PanSpeed::control_class == V4L2_CTRL_CLASS_CAMERA);
+static_assert(PanAbsolute::batchable && !PanRelative::batchable);
+static_assert(detail::distinct_ids<PanSpeed, TiltSpeed, ZoomAbsolute>());
+static_assert(!detail::distinct_ids<PanSpeed, TiltSpeed, PanSpeed>());
+static_assert(detail::index_of<ZoomAbsolute, PanSpeed, TiltSpeed, ZoomAbsolute>() == 2);
+
+TEST(ControlsTest, SetClampsToTheControlRange) {
+    testing::MockV4L2Device mock;
+    set<ZoomAbsolute>(mock, 9000);
+    set<PanSpeed>(mock, -3);
+    EXPECT_EQ(get<ZoomAbsolute>(mock), ZOOM_MAX);
+    EXPECT_EQ(mock.get_stored_value(CTRL_PAN_SPEED), -1);
+    EXPECT_TRUE(mock.get_batches().empty());
+}
+
+TEST(ControlsTest, BatchWritesPendingValuesInOneRequest) {
+    testing::MockV4L2Device mock;
+    ControlBatch<PanSpeed, TiltSpeed, ZoomAbsolute> batch;
+    EXPECT_TRUE(batch.empty());
+    batch.apply(mock);  // nothing pending: no request
+    EXPECT_TRUE(mock.get_batches().empty());
+
+    batch.set<ZoomAbsolute>(50);
+    batch.set<PanSpeed>(1);
+    batch.apply(mock);
+    auto batches = mock.get_batches();
+    ASSERT_EQ(batches.size(), 1u);
+    // Declaration order, clamped, tilt left out.
+    ASSERT_EQ(batches[0].size(), 2u);
+    EXPECT_EQ(batches[0][0], (ControlValue{CTRL_PAN_SPEED, 1}));
+    EXPECT_EQ(batches[0][1], (ControlValue{CTRL_ZOOM_ABSOLUTE, ZOOM_MIN}));
+    EXPECT_TRUE(batch.empty());
+
+    set_all<PanSpeed, TiltSpeed>(mock, 0, 0);
+    batches = mock.get_batches();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[1].size(), 2u);
+    EXPECT_EQ(mock.call_count(), 4u);
+}
+
+TEST(ControlsTest, MotionStartsAndStopsBothAxesTogether) {
+    testing::MockV4L2Device mock;
+    MotionController motion(&mock);
+    motion.combined_move(1, -1, 0.01);
+    auto batches = mock.get_batches();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[0].size(), 2u);  // start
+    EXPECT_EQ(batches[0][1], (ControlValue{CTRL_TILT_SPEED, -1}));
+    EXPECT_EQ(batches[1].size(), 2u);  // stop
+    EXPECT_EQ(batches[1][0], (ControlValue{CTRL_PAN_SPEED, 0}));
+
+    mock.clear_calls();
+    motion.stop();
+    ASSERT_EQ(mock.get_batches().size(), 1u);
+    EXPECT_EQ(mock.get_batches()[0].size(), 2u);
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bcc950/frame_buffer.hpp"
+#include "bcc950/pose_history.hpp"
+#include "bcc950/v4l2_capture.hpp"
+#include "bcc950/v4l2_device.hpp"
+#include "fake_frame_source.hpp"
+
+namespace bcc950 {
+namespace {
+
+const std::vector<uint8_t> JPEG_STUB = {0xFF, 0xD8, 0x01, 0x02, 0xFF, 0xD9};
+
+TEST(FrameTest, KeepsCompressedBytesAndMetadata) {
+    Frame frame(JPEG_STUB, 640, 480, 7, 12.5);
+    EXPECT_EQ(frame.jpeg(), JPEG_STUB);
+    EXPECT_EQ(frame.size(), JPEG_STUB.size());
+    EXPECT_EQ(frame.data()[0], 0xFF);
+    EXPECT_EQ(frame.width(), 640);
+    EXPECT_EQ(frame.height(), 480);
+    EXPECT_EQ(frame.sequence(), 7u);
+    EXPECT_DOUBLE_EQ(frame.timestamp(), 12.5);
+}
+
+TEST(FrameBufferTest, EmptyBeforeFirstFrame) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    EXPECT_EQ(buffer.latest(), nullptr);
+    EXPECT_EQ(buffer.frame_id(), 0u);
+    EXPECT_TRUE(std::isinf(buffer.frame_age()));
+}
+
+TEST(FrameBufferTest, ConsumersShareTheSameFrame) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    buffer.start();
+
+    source.push(JPEG_STUB, 1, PoseHistory::now());
+    FramePtr a = buffer.wait_next(0, 2.0);
+    ASSERT_NE(a, nullptr);
+    FramePtr b = buffer.latest();
+    EXPECT_EQ(a.get(), b.get());  // no copy, no re-encode
+    EXPECT_EQ(a->jpeg(), JPEG_STUB);
+    EXPECT_EQ(buffer.frame_id(), 1u);
+    EXPECT_LT(buffer.frame_age(), 2.0);
+}
+
+TEST(FrameBufferTest, WaitNextReturnsOnlyNewerFrames) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    buffer.start();
+
+    source.push(JPEG_STUB, 1, 1.0);
+    ASSERT_NE(buffer.wait_next(0, 2.0), nullptr);
+    uint64_t seen = buffer.frame_id();
+
+    EXPECT_EQ(buffer.wait_next(seen, 0.05), nullptr);
+
+    source.push(JPEG_STUB, 2, 2.0);
+    FramePtr next = buffer.wait_next(seen, 2.0);
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(next->sequence(), 2u);
+    EXPECT_EQ(buffer.frame_id(), seen + 1);
+}
+
+TEST(FrameBufferTest, SurvivesSourceErrors) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    source.fail_next(2);
+    buffer.start();
+
+    source.push(JPEG_STUB, 5, 1.0);
+    FramePtr frame = buffer.wait_next(0, 3.0);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->sequence(), 5u);
+    EXPECT_EQ(buffer.errors(), 2u);
+}
+
+TEST(FrameBufferTest, StopUnblocksWaitersAndIsIdempotent) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    buffer.start();
+    buffer.start();
+    buffer.stop();
+    EXPECT_EQ(buffer.wait_next(0, 1.0), nullptr);
+    buffer.stop();
+
+    // Restartable after a stop.
+    buffer.start();
+    source.push(JPEG_STUB, 1, 1.0);
+    EXPECT_NE(buffer.wait_next(0, 2.0), nullptr);
+}
+
+TEST(V4L2CaptureTest, OpenMissingDeviceThrows) {
+    V4L2Capture capture;
+    EXPECT_FALSE(capture.is_open());
+    EXPECT_THROW(capture.open("/dev/nonexistent_bcc950_video"), V4L2Error);
+    EXPECT_FALSE(capture.is_open());
+}
+
+TEST(V4L2CaptureTest, ReadWithoutStreamThrows) {
+    V4L2Capture capture;
+    EXPECT_THROW(capture.read(0.0), V4L2Error);
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "bcc950/frame_buffer.hpp"
+#include "bcc950/frame_motion.hpp"
+#include "bcc950/motion.hpp"
+#include "bcc950/pose_history.hpp"
+#include "fake_frame_source.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+PoseSample sample(double t, int pan_speed, double zoom = ZOOM_MIN,
+                  double zoom_rate = 0.0, int zoom_target = ZOOM_MIN) {
+    PoseSample s;
+    s.timestamp = t;
+    s.pan_speed = static_cast<int8_t>(pan_speed);
+    s.zoom = zoom;
+    s.zoom_rate = zoom_rate;
+    s.zoom_target = zoom_target;
+    return s;
+}
+
+TEST(FrameMotionTest, EmptyHistoryIsStationary) {
+    PoseHistory history;
+    EXPECT_EQ(motion_state(history, 5.0), MotionState::Stationary);
+}
+
+TEST(FrameMotionTest, ClassifiesAPanFromTheLog) {
+    PoseHistory history;
+    history.record(sample(0.0, 0));
+    history.record(sample(1.0, 1));   // start
+    history.record(sample(2.0, 0));   // stop
+
+    EXPECT_EQ(motion_state(history, 0.5), MotionState::Stationary);
+    EXPECT_EQ(motion_state(history, 1.05), MotionState::Accelerating);
+    EXPECT_EQ(motion_state(history, 1.5), MotionState::Moving);
+    EXPECT_EQ(motion_state(history, 2.02), MotionState::Moving);  // exposure spans the stop
+    EXPECT_EQ(motion_state(history, 2.1), MotionState::Settling);
+    EXPECT_EQ(motion_state(history, 2.5), MotionState::Stationary);
+}
+
+TEST(FrameMotionTest, ExposureBeforeAStartIsStationary) {
+    PoseHistory history;
+    history.record(sample(0.0, 0));
+    history.record(sample(1.0, -1));
+    EXPECT_EQ(motion_state(history, 0.99), MotionState::Stationary);
+}
+
+TEST(FrameMotionTest, TimingIsConfigurable) {
+    PoseHistory history;
+    history.record(sample(0.0, 0));
+    history.record(sample(1.0, 1));
+    history.record(sample(2.0, 0));
+
+    MotionTiming slow;
+    slow.accel_time = 0.6;
+    slow.settle_time = 1.0;
+    EXPECT_EQ(motion_state(history, 1.5, slow), MotionState::Accelerating);
+    EXPECT_EQ(motion_state(history, 2.9, slow), MotionState::Settling);
+}
+
+TEST(FrameMotionTest, ZoomSlewEndsWhenTheLensArrives) {
+    PoseHistory history;
+    // 100 -> 500 at 800 units/s: the lens arrives at t = 0.5.
+    history.record(sample(0.0, 0, ZOOM_MIN, 800.0, ZOOM_MAX));
+
+    EXPECT_EQ(motion_state(history, 0.3), MotionState::Moving);
+    EXPECT_EQ(motion_state(history, 0.6), MotionState::Settling);
+    EXPECT_EQ(motion_state(history, 0.9), MotionState::Stationary);
+}
+
+TEST(FrameMotionTest, MotionControllerLogsClassify) {
+    testing::MockV4L2Device device;
+    MotionController motion(&device);
+    double before = PoseHistory::now();
+    motion.pan(1, 0.15);
+    double after = PoseHistory::now();
+
+    const PoseHistory& history = motion.pose_history();
+    double start = after;
+    for (const PoseSample& s : history.samples()) {
+        if (s.pan_speed != 0) {
+            start = std::min(start, s.timestamp);
+        }
+    }
+    ASSERT_LT(start, after);
+    EXPECT_EQ(motion_state(history, before), MotionState::Stationary);
+    EXPECT_EQ(motion_state(history, start + 0.12), MotionState::Moving);
+    EXPECT_EQ(motion_state(history, after + 0.05), MotionState::Settling);
+    EXPECT_EQ(motion_state(history, after + 1.0), MotionState::Stationary);
+}
+
+TEST(FrameMotionTest, WaitSettledSkipsBlurredFrames) {
+    testing::FakeFrameSource source;
+    FrameBuffer buffer(source);
+    buffer.start();
+
+    source.push(std::make_shared<const Frame>(std::vector<uint8_t>{0xFF, 0xD8}, 640, 480,
+                                              1, 1.0, MotionState::Moving));
+    FramePtr blurred = buffer.wait_next(0, 2.0);
+    ASSERT_NE(blurred, nullptr);
+    EXPECT_FALSE(blurred->settled());
+    EXPECT_EQ(buffer.wait_settled(0, 0.1), nullptr);
+
+    source.push(std::make_shared<const Frame>(std::vector<uint8_t>{0xFF, 0xD8}, 640, 480,
+                                              2, 2.0, MotionState::Settling));
+    source.push(std::make_shared<const Frame>(std::vector<uint8_t>{0xFF, 0xD8}, 640, 480,
+                                              3, 3.0, MotionState::Stationary));
+    FramePtr settled = buffer.wait_settled(0, 2.0);
+    ASSERT_NE(settled, nullptr);
+    EXPECT_EQ(settled->sequence(), 3u);
+    EXPECT_TRUE(settled->settled());
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/homing.hpp"
+#include "bcc950/motion.hpp"
+#include "bcc950/position.hpp"
+#include "bcc950/scheduler.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// Fixture providing a MotionController with a short-travel homing
+/// profile so a full home takes a fraction of a second.
+class HomingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_ = std::make_unique<testing::MockV4L2Device>();
+        position_ = PositionTracker{};
+        motion_ = std::make_unique<MotionController>(mock_.get(), &position_);
+
+        profile_.pan_travel  = 0.04;
+        profile_.tilt_travel = 0.02;
+        profile_.overdrive   = 0.01;
+        motion_->set_homing_profile(profile_);
+    }
+
+    std::unique_ptr<testing::MockV4L2Device> mock_;
+    PositionTracker position_;
+    std::unique_ptr<MotionController> motion_;
+    HomingProfile profile_;
+};
+
+TEST_F(HomingTest, SeeksStopsThenParksAtCenter) {
+    position_.pan  = 1.5;   // a drifted estimate
+    position_.tilt = -0.7;
+
+    EXPECT_TRUE(motion_->home());
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 8u);
+    // Seek: both axes toward their stops at once.
+    EXPECT_EQ(calls[0], std::make_pair(CTRL_PAN_SPEED, int32_t{-1}));
+    EXPECT_EQ(calls[1], std::make_pair(CTRL_TILT_SPEED, int32_t{-1}));
+    // Center: back out by half the travel on each axis.
+    EXPECT_EQ(calls[4], std::make_pair(CTRL_PAN_SPEED, int32_t{1}));
+    EXPECT_EQ(calls[5], std::make_pair(CTRL_TILT_SPEED, int32_t{1}));
+
+    EXPECT_DOUBLE_EQ(position_.pan, 0.0);
+    EXPECT_DOUBLE_EQ(position_.tilt, 0.0);
+}
+
+TEST_F(HomingTest, SeekIgnoresSoftLimits) {
+    // The estimate claims we are already at the stop; homing must not
+    // trust it.
+    position_.pan  = EST_PAN_MIN;
+    position_.tilt = EST_TILT_MIN;
+
+    EXPECT_TRUE(motion_->home());
+
+    const auto calls = mock_->get_calls();
+    ASSERT_GE(calls.size(), 2u);
+    EXPECT_EQ(calls[0], std::make_pair(CTRL_PAN_SPEED, int32_t{-1}));
+    EXPECT_EQ(calls[1], std::make_pair(CTRL_TILT_SPEED, int32_t{-1}));
+}
+
+TEST_F(HomingTest, CustomCenterAndStopDirection) {
+    profile_.pan_stop_dir = 1;
+    profile_.center_pan   = 0.01;
+    profile_.center_tilt  = -0.005;
+    motion_->set_homing_profile(profile_);
+
+    EXPECT_TRUE(motion_->home());
+
+    const auto calls = mock_->get_calls();
+    ASSERT_GE(calls.size(), 5u);
+    EXPECT_EQ(calls[0], std::make_pair(CTRL_PAN_SPEED, int32_t{1}));
+    EXPECT_EQ(calls[4], std::make_pair(CTRL_PAN_SPEED, int32_t{-1}));
+    EXPECT_DOUBLE_EQ(position_.pan, 0.01);
+    EXPECT_DOUBLE_EQ(position_.tilt, -0.005);
+}
+
+TEST_F(HomingTest, StallDetectorEndsSeekEarly) {
+    profile_.pan_travel    = 5.0;
+    profile_.tilt_travel   = 5.0;
+    profile_.center_pan    = profile_.pan_stop();   // no centering leg
+    profile_.center_tilt   = profile_.tilt_stop();
+    profile_.poll_interval = 0.005;
+    std::atomic<int> polls{0};
+    profile_.stall_detector = [&](Axis) { return ++polls >= 2; };
+    motion_->set_homing_profile(profile_);
+
+    auto start = clock_type::now();
+    EXPECT_TRUE(motion_->home());
+    double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    EXPECT_LT(elapsed, 1.0);
+    EXPECT_GE(polls.load(), 2);
+    EXPECT_DOUBLE_EQ(position_.pan, -2.5);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_TILT_SPEED), 0);
+}
+
+TEST_F(HomingTest, CancelAbortsHoming) {
+    profile_.pan_travel  = 3.0;
+    profile_.tilt_travel = 3.0;
+    motion_->set_homing_profile(profile_);
+
+    bool result = true;
+    std::thread mover([&] { result = motion_->home(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    motion_->cancel();
+    mover.join();
+
+    EXPECT_FALSE(result);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_TILT_SPEED), 0);
+}
+
+TEST_F(HomingTest, SchedulableAsCommand) {
+    position_.pan = 1.0;
+    CommandScheduler scheduler(*motion_);
+    ASSERT_TRUE(scheduler.submit(CommandSource::Idle, MotionCommand::home()));
+    scheduler.wait_idle();
+
+    EXPECT_EQ(scheduler.stats(CommandSource::Idle).executed, 1u);
+    EXPECT_DOUBLE_EQ(position_.pan, 0.0);
+}
+
+} // anonymous namespace
+} // namespace bcc950
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bcc950/frame.hpp"
+#include "bcc950/jpeg_decoder.hpp"
+
+#include "jpeg_fixture.hpp"
+
+namespace bcc950 {
+namespace {
+
+#ifdef BCC950_HAVE_JPEG
+
+/// Encode a width x height RGB image: left half red, right half blue.
+std::vector<uint8_t> encode_test_jpeg(int width, int height) {
+    std::vector<uint8_t> rgb(static_cast<std::size_t>(width) * height * 3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t* p = &rgb[(static_cast<std::size_t>(y) * width + x) * 3];
+            bool left = x < width / 2;
+            p[0] = left ? 230 : 20;
+            p[1] = 20;
+            p[2] = left ? 20 : 230;
+        }
+    }
+
+    return testing::encode_jpeg(rgb, width, height, 3);
+}
+
+/// Remove DHT segments, as UVC cameras do in MJPEG streams.
+std::vector<uint8_t> strip_huffman_tables(const std::vector<uint8_t>& jpeg) {
+    std::vector<uint8_t> out(jpeg.begin(), jpeg.begin() + 2);  // SOI
+    std::size_t i = 2;
+    while (i + 4 <= jpeg.size()) {
+        uint8_t marker = jpeg[i + 1];
+        std::size_t length = (jpeg[i + 2] << 8) | jpeg[i + 3];
+        if (marker == 0xDA) {  // SOS: copy the rest verbatim
+            out.insert(out.end(), jpeg.begin() + i, jpeg.end());
+            return out;
+        }
+        if (marker != 0xC4) {
+            out.insert(out.end(), jpeg.begin() + i, jpeg.begin() + i + 2 + length);
+        }
+        i += 2 + length;
+    }
+    return out;
+}
+
+#endif
+
+TEST(JpegDecoderTest, ScaleForPicksCheapestCoveringDecode) {
+    EXPECT_EQ(jpeg_scale_for(640, 480, 640, 480), 1);
+    EXPECT_EQ(jpeg_scale_for(1280, 720, 640, 360), 2);
+    EXPECT_EQ(jpeg_scale_for(1280, 720, 320, 180), 4);
+    EXPECT_EQ(jpeg_scale_for(1280, 720, 100, 50), 8);
+    EXPECT_EQ(jpeg_scale_for(1280, 720, 10, 10), 8);    // no scale past 1/8
+    EXPECT_EQ(jpeg_scale_for(640, 480, 1920, 1080), 1); // never upscale
+    EXPECT_EQ(jpeg_scale_for(1280, 720, 321, 100), 2);  // width decides
+}
+
+TEST(JpegDecoderTest, RejectsInvalidScale) {
+    const uint8_t byte = 0;
+    EXPECT_THROW(decode_jpeg(&byte, 1, 3), JpegError);
+    EXPECT_THROW(decode_jpeg(&byte, 1, 16), JpegError);
+}
+
+#ifdef BCC950_HAVE_JPEG
+
+TEST(JpegDecoderTest, ScaledIdctShrinksOutput) {
+    ASSERT_TRUE(jpeg_decode_supported());
+    auto jpeg = encode_test_jpeg(64, 48);
+    for (int scale : {1, 2, 4, 8}) {
+        ImagePtr image = decode_jpeg(jpeg.data(), jpeg.size(), scale, PixelFormat::RGB);
+        EXPECT_EQ(image->width, 64 / scale);
+        EXPECT_EQ(image->height, 48 / scale);
+        EXPECT_EQ(image->channels, 3);
+        EXPECT_EQ(image->pixels.size(),
+                  static_cast<std::size_t>(image->width) * image->height * 3);
+    }
+}
+
+TEST(JpegDecoderTest, ColorOrder) {
+    auto jpeg = encode_test_jpeg(64, 48);
+    ImagePtr rgb = decode_jpeg(jpeg.data(), jpeg.size(), 2, PixelFormat::RGB);
+    ImagePtr bgr = decode_jpeg(jpeg.data(), jpeg.size(), 2, PixelFormat::BGR);
+
+    // Pixel (4, 4) is in the red half.
+    const uint8_t* r = &rgb->pixels[(4 * rgb->width + 4) * 3];
+    const uint8_t* b = &bgr->pixels[(4 * bgr->width + 4) * 3];
+    EXPECT_GT(r[0], 180);
+    EXPECT_LT(r[2], 70);
+    EXPECT_GT(b[2], 180);
+    EXPECT_LT(b[0], 70);
+    EXPECT_EQ(bgr->format, PixelFormat::BGR);
+}
+
+TEST(JpegDecoderTest, GrayIsLumaOnly) {
+    auto jpeg = encode_test_jpeg(64, 48);
+    ImagePtr gray = decode_jpeg(jpeg.data(), jpeg.size(), 4, PixelFormat::Gray);
+    EXPECT_EQ(gray->channels, 1);
+    EXPECT_EQ(gray->pixels.size(), 16u * 12u);
+    // Luma of the red half (~0.30 R) is brighter than the blue (~0.11 B).
+    EXPECT_GT(gray->pixels[2 * 16 + 2], gray->pixels[2 * 16 + 13]);
+}
+
+TEST(JpegDecoderTest, DecodesMjpegWithoutHuffmanTables) {
+    auto jpeg = strip_huffman_tables(encode_test_jpeg(64, 48));
+    ImagePtr image = decode_jpeg(jpeg.data(), jpeg.size(), 1, PixelFormat::RGB);
+    EXPECT_EQ(image->width, 64);
+    EXPECT_GT(image->pixels[0], 180);
+}
+
+TEST(JpegDecoderTest, CorruptInputThrows) {
+    std::vector<uint8_t> junk(256, 0x55);
+    EXPECT_THROW(decode_jpeg(junk.data(), junk.size()), JpegError);
+    EXPECT_THROW(decode_jpeg(nullptr, 0), JpegError);
+}
+
+TEST(FrameDecodeTest, CachesOncePerResolution) {
+    Frame frame(encode_test_jpeg(64, 48), 64, 48, 1, 0.0);
+    ImagePtr a = frame.decode(2);
+    ImagePtr b = frame.decode(2);
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(frame.decode(4).get(), a.get());
+    EXPECT_NE(frame.decode(2, PixelFormat::RGB).get(), a.get());
+}
+
+TEST(FrameDecodeTest, DecodeAtLeastUsesCheapestScale) {
+    Frame frame(encode_test_jpeg(64, 48), 64, 48, 1, 0.0);
+    ImagePtr image = frame.decode_at_least(16, 12);
+    EXPECT_EQ(image->width, 16);
+    EXPECT_EQ(image.get(), frame.decode(4).get());
+}
+
+TEST(FrameDecodeTest, ConcurrentConsumersShareOneDecode) {
+    auto frame = std::make_shared<const Frame>(encode_test_jpeg(64, 48), 64, 48, 1, 0.0);
+    std::vector<ImagePtr> results(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] { results[i] = frame->decode(2, PixelFormat::BGR); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (const auto& r : results) {
+        EXPECT_EQ(r.get(), results[0].get());
+    }
+}
+
+#else
+
+TEST(JpegDecoderTest, UnsupportedBuildThrows) {
+    EXPECT_FALSE(jpeg_decode_supported());
+    const uint8_t byte = 0;
+    EXPECT_THROW(decode_jpeg(&byte, 1), JpegError);
+}
+
+#endif
+
+} // namespace
+} // namespace bcc950
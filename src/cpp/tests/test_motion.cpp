@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include "bcc950/constants.hpp"
 #include "bcc950/motion.hpp"
@@ -128,6 +130,22 @@ TEST_F(MotionTest, CombinedMoveUpdatesBothPositionAxes) {
     EXPECT_DOUBLE_EQ(position_.tilt, 0.2);
 }
 
+TEST_F(MotionTest, MoveToDrivesEachAxisForItsOwnDistance) {
+    position_.pan = 0.0;
+    position_.tilt = 0.0;
+    motion_->move_to(0.05, -0.02);
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 4u);
+    EXPECT_EQ(calls[0], std::make_pair(CTRL_PAN_SPEED, int32_t{1}));
+    EXPECT_EQ(calls[1], std::make_pair(CTRL_TILT_SPEED, int32_t{-1}));
+    // Tilt has less to travel, so it stops first.
+    EXPECT_EQ(calls[2], std::make_pair(CTRL_TILT_SPEED, int32_t{0}));
+    EXPECT_EQ(calls[3], std::make_pair(CTRL_PAN_SPEED, int32_t{0}));
+    EXPECT_DOUBLE_EQ(position_.pan, 0.05);
+    EXPECT_DOUBLE_EQ(position_.tilt, -0.02);
+}
+
 // ---- Zoom absolute tests ----
 
 TEST_F(MotionTest, ZoomAbsoluteSetsValue) {
@@ -185,6 +203,92 @@ TEST_F(MotionTest, ZoomRelativeClampsBelowMin) {
     EXPECT_EQ(position_.zoom, ZOOM_MIN);
 }
 
+// ---- Zoom slew tests ----
+
+TEST_F(MotionTest, ZoomAbsoluteStartsSlew) {
+    ZoomModel model;
+    model.slew_rate    = 2000.0;  // 100 -> 500 in 0.2 s
+    model.slew_latency = 0.0;
+    motion_->set_zoom_model(model);
+
+    motion_->zoom_absolute(500);
+    EXPECT_EQ(position_.zoom, 500);  // commanded value, at once
+    EXPECT_LT(motion_->lens_zoom(), 500.0);
+    EXPECT_GT(motion_->zoom_settle_time(), 0.0);
+
+    EXPECT_TRUE(motion_->wait_zoom_settled());
+    EXPECT_DOUBLE_EQ(motion_->lens_zoom(), 500.0);
+    EXPECT_DOUBLE_EQ(motion_->zoom_settle_time(), 0.0);
+}
+
+TEST_F(MotionTest, WaitZoomSettledReturnsAtOnceWhenIdle) {
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(motion_->wait_zoom_settled());
+    EXPECT_LT(std::chrono::duration<double>(
+                  std::chrono::steady_clock::now() - start).count(), 0.01);
+}
+
+TEST_F(MotionTest, FovVelocityIsZoomNormalized) {
+    ZoomModel model;
+    model.slew_latency = 0.0;
+    model.slew_rate    = 1e9;  // effectively instant
+    motion_->set_zoom_model(model);
+
+    motion_->move_fov_velocity(0.05, 0.0, 0.2);
+    double wide = position_.pan;
+
+    motion_->zoom_absolute(300);
+    ASSERT_TRUE(motion_->wait_zoom_settled());
+    motion_->move_fov_velocity(0.05, 0.0, 0.2);
+    double tele = position_.pan - wide;
+
+    // Same image shift, so travel scales with the field of view.
+    EXPECT_NEAR(wide, model.movement_seconds(Axis::Pan, 0.01, ZOOM_MIN), 1e-9);
+    EXPECT_NEAR(tele / wide,
+                model.fov(Axis::Pan, 300) / model.fov(Axis::Pan, ZOOM_MIN), 1e-9);
+}
+
+TEST_F(MotionTest, FovVelocitySaturatesAtFullSpeed) {
+    motion_->move_fov_velocity(-100.0, 0.0, 0.05);
+    EXPECT_DOUBLE_EQ(position_.pan, -0.05);
+}
+
+// ---- Pose history tests ----
+
+TEST_F(MotionTest, TimedMoveRecordsStartAndStop) {
+    double before = PoseHistory::now();
+    motion_->combined_move(1, -1, 0.05);
+    double after = PoseHistory::now();
+
+    auto samples = motion_->pose_history().samples();
+    ASSERT_GE(samples.size(), 3u);  // construction, start, stop
+    const PoseSample& start = samples[samples.size() - 2];
+    const PoseSample& stop  = samples.back();
+    EXPECT_EQ(start.pan_speed, 1);
+    EXPECT_EQ(start.tilt_speed, -1);
+    EXPECT_FALSE(stop.moving());
+    EXPECT_DOUBLE_EQ(stop.pan, 0.05);
+    EXPECT_DOUBLE_EQ(stop.tilt, -0.05);
+
+    // Halfway through the move the camera was halfway there.
+    double mid = (start.timestamp + stop.timestamp) / 2.0;
+    EXPECT_NEAR(motion_->pose_at(mid)->pan, 0.025, 1e-9);
+    EXPECT_DOUBLE_EQ(motion_->pose_at(after + 1.0)->pan, 0.05);
+    EXPECT_LE(before, start.timestamp);
+}
+
+TEST_F(MotionTest, StaggeredStopRecordsIntermediatePose) {
+    position_.pan = EST_PAN_MAX - 0.02;  // pan reaches its limit first
+    motion_->combined_move(1, 1, 0.05);
+
+    auto samples = motion_->pose_history().samples();
+    ASSERT_GE(samples.size(), 4u);
+    const PoseSample& staggered = samples[samples.size() - 2];
+    EXPECT_EQ(staggered.pan_speed, 0);
+    EXPECT_EQ(staggered.tilt_speed, 1);
+    EXPECT_DOUBLE_EQ(staggered.pan, EST_PAN_MAX);
+}
+
 // ---- Stop test ----
 
 TEST_F(MotionTest, StopSetsBothSpeedsToZero) {
@@ -198,5 +302,198 @@ TEST_F(MotionTest, StopSetsBothSpeedsToZero) {
     EXPECT_EQ(calls[1].second, 0);
 }
 
+// ---- Cancellation tests ----
+
+TEST_F(MotionTest, CancelCutsShortTimedMove) {
+    std::thread mover([&] { motion_->pan(1, 5.0); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto start = std::chrono::steady_clock::now();
+    motion_->cancel();
+    mover.join();
+    double waited = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(waited, 1.0);
+    EXPECT_GT(position_.pan, 0.0);
+    EXPECT_LT(position_.pan, 1.0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+}
+
+TEST_F(MotionTest, StaleTokenAbandonsMoveBeforeStart) {
+    uint64_t token = motion_->cancel_token();
+    motion_->cancel();
+    motion_->combined_move(1, 1, 0.5, token);
+
+    EXPECT_EQ(mock_->call_count(), 0u);
+    EXPECT_DOUBLE_EQ(position_.pan, 0.0);
+}
+
+// ---- Velocity mode tests ----
+
+/// Spin until `pred` holds or a second passes.
+template <typename Pred>
+bool eventually(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return pred();
+}
+
+TEST_F(MotionTest, VelocityWritesOnlyOnChange) {
+    for (int i = 0; i < 30; ++i) {
+        motion_->set_velocity(1, 0);
+    }
+    ASSERT_TRUE(eventually([&] { return mock_->call_count() >= 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].first, CTRL_PAN_SPEED);
+    EXPECT_EQ(calls[0].second, 1);
+    EXPECT_EQ(motion_->velocity_stats().updates, 30u);
+    EXPECT_EQ(motion_->velocity_stats().writes, 1u);
+}
+
+TEST_F(MotionTest, VelocityTimeoutStopsMotors) {
+    motion_->set_velocity_timeout(0.05);
+    motion_->set_velocity(-1, 1);
+    ASSERT_TRUE(eventually([&] { return motion_->velocity_stats().timeouts == 1; }));
+    ASSERT_TRUE(eventually([&] {
+        return mock_->get_stored_value(CTRL_PAN_SPEED) == 0 &&
+               mock_->get_stored_value(CTRL_TILT_SPEED) == 0;
+    }));
+    EXPECT_LT(position_.pan, 0.0);
+    EXPECT_GT(position_.tilt, 0.0);
+}
+
+TEST_F(MotionTest, StopEndsVelocityMode) {
+    motion_->set_velocity(1, 0);
+    ASSERT_TRUE(eventually([&] {
+        return mock_->get_stored_value(CTRL_PAN_SPEED) == 1;
+    }));
+    motion_->stop();
+
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_GT(position_.pan, 0.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+}
+
+TEST_F(MotionTest, DestructorStopsRunningVelocity) {
+    motion_->set_velocity(0, -1);
+    ASSERT_TRUE(eventually([&] {
+        return mock_->get_stored_value(CTRL_TILT_SPEED) == -1;
+    }));
+    motion_.reset();
+
+    EXPECT_EQ(mock_->get_stored_value(CTRL_TILT_SPEED), 0);
+}
+
+// ---- Soft limit tests ----
+
+TEST_F(MotionTest, MoveTruncatedAtSoftLimit) {
+    position_.pan = EST_PAN_MAX - 0.05;
+    auto start = std::chrono::steady_clock::now();
+    motion_->pan(1, 1.0);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(elapsed, 0.5);
+    EXPECT_DOUBLE_EQ(position_.pan, EST_PAN_MAX);
+}
+
+TEST_F(MotionTest, MoveAtSoftLimitWritesNothing) {
+    position_.tilt = EST_TILT_MIN;
+    motion_->tilt(-1, 0.5);
+
+    EXPECT_EQ(mock_->call_count(), 0u);
+    EXPECT_DOUBLE_EQ(position_.tilt, EST_TILT_MIN);
+}
+
+TEST_F(MotionTest, StagedMoveReportsSoftLimitClamping) {
+    position_.pan = EST_PAN_MAX;
+    position_.tilt = EST_TILT_MIN;
+    MoveTiming timing;
+    auto start = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    EXPECT_TRUE(motion_->combined_move_at(1, -1, 0.05, start, &timing));
+    EXPECT_TRUE(timing.clamped);
+    EXPECT_EQ(timing.started, std::chrono::steady_clock::time_point{});
+    EXPECT_EQ(mock_->call_count(), 0u);
+
+    position_.tilt = EST_TILT_MIN + 0.02;
+    start = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    EXPECT_TRUE(motion_->combined_move_at(-1, -1, 0.05, start, &timing));
+    EXPECT_TRUE(timing.clamped);
+    EXPECT_NE(timing.started, std::chrono::steady_clock::time_point{});
+    // The estimate is credited with the time actually run, so a late start
+    // under load can leave it short of the limit.
+    EXPECT_GE(position_.tilt, EST_TILT_MIN);
+    EXPECT_LT(position_.tilt, EST_TILT_MIN + 0.02);
+
+    start = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    EXPECT_TRUE(motion_->combined_move_at(-1, 1, 0.05, start, &timing));
+    EXPECT_FALSE(timing.clamped);
+}
+
+TEST_F(MotionTest, CombinedMoveStopsEachAxisAtItsOwnLimit) {
+    position_.tilt = EST_TILT_MAX - 0.02;
+    motion_->combined_move(1, 1, 0.1);
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 4u);
+    // Tilt reaches its limit first and is stopped before pan.
+    EXPECT_EQ(calls[2].first, CTRL_TILT_SPEED);
+    EXPECT_EQ(calls[2].second, 0);
+    EXPECT_EQ(calls[3].first, CTRL_PAN_SPEED);
+    EXPECT_EQ(calls[3].second, 0);
+    EXPECT_DOUBLE_EQ(position_.pan, 0.1);
+    EXPECT_DOUBLE_EQ(position_.tilt, EST_TILT_MAX);
+}
+
+TEST_F(MotionTest, VelocityStopsAtPredictedLimit) {
+    position_.pan = EST_PAN_MAX - 0.05;
+    motion_->set_velocity_timeout(5.0);
+    motion_->set_velocity(1, 0);
+    ASSERT_TRUE(eventually([&] { return motion_->velocity_stats().limit_stops == 1; }));
+
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_DOUBLE_EQ(position_.pan, EST_PAN_MAX);
+    EXPECT_EQ(motion_->velocity_stats().timeouts, 0u);
+}
+
+// ---- Safety watchdog tests ----
+
+TEST_F(MotionTest, FailedStartWriteStillStopsOtherAxis) {
+    mock_->fail_control(CTRL_TILT_SPEED);
+    EXPECT_THROW(motion_->combined_move(1, 1, 0.5), V4L2Error);
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[0].second, 1);
+    EXPECT_EQ(calls[1].first, CTRL_PAN_SPEED);
+    EXPECT_EQ(calls[1].second, 0);
+}
+
+TEST_F(MotionTest, MissedHeartbeatForcesStop) {
+    motion_->set_heartbeat_timeout(0.02);
+    auto start = std::chrono::steady_clock::now();
+    motion_->pan(1, 2.0);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(elapsed, 1.0);
+    EXPECT_EQ(motion_->watchdog_expirations(), 1u);
+    EXPECT_LT(position_.pan, 1.0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+}
+
+TEST_F(MotionTest, CompletedMoveDoesNotTripWatchdog) {
+    motion_->pan(1, 0.01);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(motion_->watchdog_expirations(), 0u);
+}
+
 } // anonymous namespace
 } // namespace bcc950
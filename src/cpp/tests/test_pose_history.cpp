@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bcc950/pose_history.hpp"
+#include "bcc950/seqlock.hpp"
+
+namespace bcc950 {
+namespace {
+
+PoseSample make_sample(double t, double pan, double tilt,
+                       int pan_speed = 0, int tilt_speed = 0) {
+    PoseSample s;
+    s.timestamp  = t;
+    s.pan        = pan;
+    s.tilt       = tilt;
+    s.pan_speed  = static_cast<int8_t>(pan_speed);
+    s.tilt_speed = static_cast<int8_t>(tilt_speed);
+    return s;
+}
+
+// ---- SeqLock tests ----
+
+TEST(SeqLockTest, LoadsLastStore) {
+    SeqLock<PoseSample> lock;
+    EXPECT_EQ(lock.version(), 1u);
+    lock.store(make_sample(1.0, 2.0, 3.0));
+    PoseSample s = lock.load();
+    EXPECT_DOUBLE_EQ(s.pan, 2.0);
+    EXPECT_DOUBLE_EQ(s.tilt, 3.0);
+    EXPECT_EQ(lock.version(), 2u);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues) {
+    SeqLock<PoseSample> lock;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            PoseSample s = lock.load();
+            if (s.pan != s.tilt || s.pan != s.timestamp) {
+                ++torn;
+            }
+        }
+    });
+    for (int i = 0; i < 20000; ++i) {
+        lock.store(make_sample(i, i, i));
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(torn.load(), 0);
+}
+
+// ---- PoseHistory tests ----
+
+TEST(PoseHistoryTest, EmptyHistoryHasNoPose) {
+    PoseHistory history(8);
+    EXPECT_FALSE(history.latest().has_value());
+    EXPECT_FALSE(history.pose_at(1.0).has_value());
+}
+
+TEST(PoseHistoryTest, CapacityRoundsUpToPowerOfTwo) {
+    PoseHistory history(5);
+    EXPECT_EQ(history.capacity(), 8u);
+}
+
+TEST(PoseHistoryTest, InterpolatesBetweenSamples) {
+    PoseHistory history(8);
+    history.record(make_sample(10.0, 0.0, 1.0, 1, -1));
+    history.record(make_sample(12.0, 2.0, -1.0));
+
+    auto mid = history.pose_at(11.0);
+    ASSERT_TRUE(mid.has_value());
+    EXPECT_DOUBLE_EQ(mid->timestamp, 11.0);
+    EXPECT_DOUBLE_EQ(mid->pan, 1.0);
+    EXPECT_DOUBLE_EQ(mid->tilt, 0.0);
+    EXPECT_TRUE(mid->moving());
+
+    auto after = history.pose_at(13.0);
+    ASSERT_TRUE(after.has_value());
+    EXPECT_DOUBLE_EQ(after->pan, 2.0);
+    EXPECT_FALSE(after->moving());
+
+    EXPECT_FALSE(history.pose_at(9.0).has_value());
+}
+
+TEST(PoseHistoryTest, ExtrapolatesFromNewestMovingSample) {
+    PoseHistory history(8);
+    history.record(make_sample(5.0, 1.0, 0.0, -1, 0));
+    auto pose = history.pose_at(5.5);
+    ASSERT_TRUE(pose.has_value());
+    EXPECT_DOUBLE_EQ(pose->pan, 0.5);
+    EXPECT_DOUBLE_EQ(pose->tilt, 0.0);
+}
+
+TEST(PoseHistoryTest, ZoomFollowsRecordedSlew) {
+    PoseHistory history(8);
+    PoseSample s = make_sample(0.0, 0.0, 0.0);
+    s.zoom        = 100.0;
+    s.zoom_target = 300;
+    s.zoom_rate   = 400.0;
+    history.record(s);
+
+    EXPECT_DOUBLE_EQ(history.pose_at(0.25)->zoom, 200.0);
+    auto settled = history.pose_at(1.0);
+    EXPECT_DOUBLE_EQ(settled->zoom, 300.0);
+    EXPECT_DOUBLE_EQ(settled->zoom_rate, 0.0);
+}
+
+TEST(PoseHistoryTest, OverwritesOldestWhenFull) {
+    PoseHistory history(4);
+    for (int i = 0; i < 10; ++i) {
+        history.record(make_sample(i, i, 0.0));
+    }
+    auto samples = history.samples();
+    ASSERT_EQ(samples.size(), 4u);
+    EXPECT_DOUBLE_EQ(samples.front().timestamp, 6.0);
+    EXPECT_DOUBLE_EQ(history.latest()->timestamp, 9.0);
+    EXPECT_FALSE(history.pose_at(3.0).has_value());
+    EXPECT_DOUBLE_EQ(history.pose_at(7.5)->pan, 7.5);
+}
+
+TEST(PoseHistoryTest, ConcurrentWritersAndReaders) {
+    PoseHistory history(64);
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < 5000; ++i) {
+                double v = w * 10000 + i;
+                history.record(make_sample(v, v, v));
+            }
+        });
+    }
+    std::thread reader([&] {
+        while (!done.load()) {
+            if (auto s = history.latest()) {
+                if (s->pan != s->tilt || s->pan != s->timestamp) {
+                    ++inconsistent;
+                }
+            }
+        }
+    });
+    for (auto& t : writers) {
+        t.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_EQ(history.samples().size(), 64u);
+}
+
+} // anonymous namespace
+} // namespace bcc950
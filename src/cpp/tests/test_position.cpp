@@ -173,5 +173,24 @@ TEST_F(PositionTest, ResetFromArbitraryState) {
     EXPECT_EQ(pos.zoom, ZOOM_DEFAULT);
 }
 
+// ---- Time to soft limit ----
+
+TEST_F(PositionTest, TimeToPanLimitInEachDirection) {
+    pos.pan = 3.0;
+    EXPECT_DOUBLE_EQ(pos.time_to_pan_limit(1), EST_PAN_MAX - 3.0);
+    EXPECT_DOUBLE_EQ(pos.time_to_pan_limit(-1), 3.0 - EST_PAN_MIN);
+}
+
+TEST_F(PositionTest, TimeToLimitIsZeroAtLimit) {
+    pos.tilt = EST_TILT_MAX;
+    EXPECT_DOUBLE_EQ(pos.time_to_tilt_limit(1), 0.0);
+    EXPECT_DOUBLE_EQ(pos.time_to_tilt_limit(-1), EST_TILT_MAX - EST_TILT_MIN);
+}
+
+TEST_F(PositionTest, TimeToLimitIsInfiniteWhenStationary) {
+    EXPECT_TRUE(std::isinf(pos.time_to_pan_limit(0)));
+    EXPECT_TRUE(std::isinf(pos.time_to_tilt_limit(0)));
+}
+
 } // anonymous namespace
 } // namespace bcc950
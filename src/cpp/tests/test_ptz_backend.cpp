@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/controller.hpp"
+#include "bcc950/motion.hpp"
+#include "bcc950/ptz_backend.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+// Arc-seconds per movement-second at the default rates.
+constexpr double PAN_UNITS  = PAN_DEG_PER_SEC * PTZ_UNITS_PER_DEGREE;
+constexpr double TILT_UNITS = TILT_DEG_PER_SEC * PTZ_UNITS_PER_DEGREE;
+
+void add_absolute(testing::MockV4L2Device& mock) {
+    mock.add_control(CTRL_PAN_ABSOLUTE, -180 * 3600, 180 * 3600, 3600 / 100);
+    mock.add_control(CTRL_TILT_ABSOLUTE, -90 * 3600, 90 * 3600, 3600 / 100);
+}
+
+// Offsets reaching across the full travel in arc-seconds.
+void add_relative(testing::MockV4L2Device& mock) {
+    mock.add_control(CTRL_PAN_RELATIVE, -180 * 3600, 180 * 3600);
+    mock.add_control(CTRL_TILT_RELATIVE, -54 * 3600, 54 * 3600);
+}
+
+bool wrote(const testing::MockV4L2Device& mock, uint32_t id) {
+    for (const auto& call : mock.get_calls()) {
+        if (call.first == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(PtzBackendTest, ProbesTheControlCatalog) {
+    testing::MockV4L2Device mock;
+    EXPECT_EQ(probe_ptz(mock).mode(), PtzMode::Velocity);
+
+    add_relative(mock);
+    EXPECT_EQ(probe_ptz(mock).mode(), PtzMode::Relative);
+
+    mock.add_control(CTRL_PAN_ABSOLUTE, -1000, 1000);
+    EXPECT_EQ(probe_ptz(mock).mode(), PtzMode::Relative);  // one axis only
+
+    mock.add_control(CTRL_TILT_ABSOLUTE, -1000, 1000, 10);
+    PtzCapabilities caps = probe_ptz(mock);
+    EXPECT_EQ(caps.mode(), PtzMode::Absolute);
+    EXPECT_EQ(caps.mode(PtzMode::Relative), PtzMode::Relative);
+    EXPECT_EQ(caps.mode(PtzMode::Velocity), PtzMode::Velocity);
+    EXPECT_EQ(caps.tilt_absolute.step, 10);
+
+    mock.add_control(CTRL_TILT_ABSOLUTE, -1000, 1000, 1, V4L2_CTRL_FLAG_DISABLED);
+    EXPECT_EQ(probe_ptz(mock).mode(), PtzMode::Relative);
+    mock.add_control(CTRL_TILT_ABSOLUTE, 0, 0);  // empty range
+    EXPECT_FALSE(probe_ptz(mock).tilt_absolute.supported);
+}
+
+TEST(PtzBackendTest, RelativeUnitsComeFromTheRange) {
+    testing::MockV4L2Device mock;
+    add_absolute(mock);
+    add_relative(mock);
+    PtzCapabilities caps = probe_ptz(mock);
+    EXPECT_DOUBLE_EQ(caps.pan_absolute.units_per_degree, PTZ_UNITS_PER_DEGREE);
+    EXPECT_DOUBLE_EQ(caps.pan_relative.units_per_degree, 3600.0);
+    EXPECT_DOUBLE_EQ(caps.tilt_relative.units_per_degree, 3600.0);
+
+    // Coarse relative units: the largest offset still spans the travel.
+    mock.add_control(CTRL_PAN_RELATIVE, -90, 90);
+    caps = probe_ptz(mock);
+    EXPECT_DOUBLE_EQ(caps.pan_relative.units_per_degree, 90.0 / PTZ_PAN_TRAVEL_DEG);
+
+    set_relative_scale(caps, 0.0);  // keeps the derived units
+    EXPECT_DOUBLE_EQ(caps.pan_relative.units_per_degree, 90.0 / PTZ_PAN_TRAVEL_DEG);
+    set_relative_scale(caps, 100.0);
+    EXPECT_DOUBLE_EQ(caps.pan_relative.units_per_degree, 100.0);
+    EXPECT_DOUBLE_EQ(caps.tilt_relative.units_per_degree, 100.0);
+    EXPECT_DOUBLE_EQ(caps.pan_absolute.units_per_degree, PTZ_UNITS_PER_DEGREE);
+}
+
+TEST(PtzBackendTest, ClampsToRangeAndStep) {
+    PtzControl c;
+    c.supported = true;
+    c.minimum = -100;
+    c.maximum = 100;
+    c.step = 10;
+    EXPECT_EQ(c.clamp(0.0), 0);
+    EXPECT_EQ(c.clamp(14.9), 10);
+    EXPECT_EQ(c.clamp(15.1), 20);
+    EXPECT_EQ(c.clamp(-46.0), -50);
+    EXPECT_EQ(c.clamp(1e9), 100);
+    EXPECT_EQ(c.clamp(-1e9), -100);
+}
+
+TEST(PtzBackendTest, ParsesConfigModes) {
+    EXPECT_EQ(parse_ptz_mode("velocity"), PtzMode::Velocity);
+    EXPECT_EQ(parse_ptz_mode("relative"), PtzMode::Relative);
+    EXPECT_EQ(parse_ptz_mode("absolute"), PtzMode::Absolute);
+    EXPECT_EQ(parse_ptz_mode("auto"), PtzMode::Absolute);
+    EXPECT_STREQ(ptz_mode_name(PtzMode::Relative), "relative");
+}
+
+class PositionalMotionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_ = std::make_unique<testing::MockV4L2Device>();
+        motion_ = std::make_unique<MotionController>(mock_.get(), &position_);
+    }
+
+    std::unique_ptr<testing::MockV4L2Device> mock_;
+    PositionTracker position_;
+    std::unique_ptr<MotionController> motion_;
+};
+
+TEST_F(PositionalMotionTest, AbsoluteMoveIsOneWritePerAxis) {
+    add_absolute(*mock_);
+    mock_->set_stored_value(CTRL_PAN_ABSOLUTE, static_cast<int32_t>(-0.02 * PAN_UNITS));
+    EXPECT_EQ(motion_->set_ptz_capabilities(probe_ptz(*mock_)), PtzMode::Absolute);
+    EXPECT_NEAR(motion_->snapshot().pan, -0.02, 1e-9);  // read back at once
+
+    motion_->move_to(0.05, -0.03);
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[0], (testing::MockV4L2Device::Call{CTRL_PAN_ABSOLUTE, 3240}));
+    EXPECT_EQ(calls[1], (testing::MockV4L2Device::Call{CTRL_TILT_ABSOLUTE, -972}));
+    EXPECT_FALSE(wrote(*mock_, CTRL_PAN_SPEED));
+
+    PositionTracker pos = motion_->snapshot();
+    EXPECT_NEAR(pos.pan, 0.05, 1e-9);
+    EXPECT_NEAR(pos.tilt, -0.03, 1e-9);
+    auto latest = motion_->pose_history().latest();
+    ASSERT_TRUE(latest);
+    EXPECT_NEAR(latest->pan, 0.05, 1e-9);
+    EXPECT_EQ(latest->pan_speed, 0);
+}
+
+TEST_F(PositionalMotionTest, AbsoluteEstimateFollowsTheHardware) {
+    add_absolute(*mock_);
+    motion_->set_ptz_capabilities(probe_ptz(*mock_));
+    // Something else moved the head.
+    mock_->set_stored_value(CTRL_PAN_ABSOLUTE, static_cast<int32_t>(0.1 * PAN_UNITS));
+    mock_->set_stored_value(CTRL_TILT_ABSOLUTE, static_cast<int32_t>(-0.2 * TILT_UNITS));
+    EXPECT_TRUE(motion_->sync_position());
+    EXPECT_NEAR(motion_->snapshot().pan, 0.1, 1e-9);
+    EXPECT_NEAR(motion_->snapshot().tilt, -0.2, 1e-9);
+
+    // Targets past the soft limits are clamped to them.
+    position_.pan_max = 0.15;
+    motion_->move_to(100.0, 0.0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_ABSOLUTE), 9720);
+    EXPECT_NEAR(motion_->snapshot().pan, 0.15, 1e-9);
+}
+
+TEST_F(PositionalMotionTest, RelativeMoveWritesOffsets) {
+    add_relative(*mock_);
+    EXPECT_EQ(motion_->set_ptz_capabilities(probe_ptz(*mock_)), PtzMode::Relative);
+    EXPECT_FALSE(motion_->sync_position());
+
+    motion_->move_to(0.05, 0.0);
+    motion_->move_to(0.02, 0.01);
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 3u);
+    EXPECT_EQ(calls[0], (testing::MockV4L2Device::Call{CTRL_PAN_RELATIVE, 3240}));
+    EXPECT_EQ(calls[1], (testing::MockV4L2Device::Call{CTRL_PAN_RELATIVE, -1944}));
+    EXPECT_EQ(calls[2], (testing::MockV4L2Device::Call{CTRL_TILT_RELATIVE, 324}));
+    EXPECT_NEAR(motion_->snapshot().pan, 0.02, 1e-9);
+    EXPECT_NEAR(motion_->snapshot().tilt, 0.01, 1e-9);
+}
+
+TEST_F(PositionalMotionTest, RelativeMoveUsesTheControlsUnits) {
+    mock_->add_control(CTRL_PAN_RELATIVE, -1000, 1000);
+    mock_->add_control(CTRL_TILT_RELATIVE, -1000, 1000);
+    PtzCapabilities caps = probe_ptz(*mock_);
+    set_relative_scale(caps, 10.0);  // calibrated: ten units per degree
+    EXPECT_EQ(motion_->set_ptz_capabilities(caps), PtzMode::Relative);
+
+    motion_->move_to(0.05, 0.0);
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0], (testing::MockV4L2Device::Call{CTRL_PAN_RELATIVE, 9}));
+    // Credited with the travel the rounded offset produces.
+    EXPECT_NEAR(motion_->snapshot().pan, 9.0 / (PAN_DEG_PER_SEC * 10.0), 1e-9);
+}
+
+TEST_F(PositionalMotionTest, StopRetargetsAMoveInFlight) {
+    add_absolute(*mock_);
+    motion_->set_ptz_capabilities(probe_ptz(*mock_));
+    std::thread mover([&] { motion_->move_to(2.0, 0.0); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto start = std::chrono::steady_clock::now();
+    motion_->cancel();
+    mover.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_EQ(calls[0].second, static_cast<int32_t>(2.0 * PAN_UNITS));
+    EXPECT_EQ(calls[1].first, CTRL_PAN_ABSOLUTE);
+    EXPECT_GT(calls[1].second, 0);
+    EXPECT_LT(calls[1].second, static_cast<int32_t>(0.5 * PAN_UNITS));
+    EXPECT_NEAR(motion_->snapshot().pan, calls[1].second / PAN_UNITS, 1e-9);
+}
+
+TEST(PtzControllerTest, RecallsPresetsWithOnePositionalWrite) {
+    auto device = std::make_unique<testing::MockV4L2Device>();
+    testing::MockV4L2Device* mock = device.get();
+    add_absolute(*mock);
+    Controller controller(std::move(device), "", "/dev/null", "/dev/null");
+    EXPECT_EQ(controller.ptz_mode(), PtzMode::Absolute);
+
+    controller.move_to(0.05, 0.02);
+    controller.zoom_to(200);
+    controller.save_preset("door");
+    controller.move_to(0.0, 0.0);
+    mock->clear_calls();
+
+    ASSERT_TRUE(controller.recall_preset("door"));
+    EXPECT_EQ(mock->get_stored_value(CTRL_PAN_ABSOLUTE), 3240);
+    EXPECT_EQ(mock->get_stored_value(CTRL_TILT_ABSOLUTE), 648);
+    EXPECT_EQ(mock->get_stored_value(CTRL_ZOOM_ABSOLUTE), 200);
+    EXPECT_FALSE(wrote(*mock, CTRL_PAN_SPEED));
+    EXPECT_NEAR(controller.position().pan, 0.05, 1e-9);
+}
+
+TEST(PtzControllerTest, ConfigCanForceVelocityMode) {
+    std::string path = ::testing::TempDir() + "bcc950_ptz_config";
+    std::ofstream(path) << "PTZ_MODE=velocity\n";
+    auto device = std::make_unique<testing::MockV4L2Device>();
+    testing::MockV4L2Device* mock = device.get();
+    add_absolute(*mock);
+    Controller controller(std::move(device), "", path, "/dev/null");
+    std::remove(path.c_str());
+    EXPECT_EQ(controller.ptz_mode(), PtzMode::Velocity);
+
+    controller.move_to(0.02, 0.0);
+    EXPECT_TRUE(wrote(*mock, CTRL_PAN_SPEED));
+    EXPECT_FALSE(wrote(*mock, CTRL_PAN_ABSOLUTE));
+}
+
+TEST(PtzControllerTest, ConfigCalibratesRelativeUnits) {
+    std::string path = ::testing::TempDir() + "bcc950_ptz_scale_config";
+    std::ofstream(path) << "PTZ_RELATIVE_SCALE=10\n";
+    auto device = std::make_unique<testing::MockV4L2Device>();
+    testing::MockV4L2Device* mock = device.get();
+    add_relative(*mock);
+    Controller controller(std::move(device), "", path, "/dev/null");
+    std::remove(path.c_str());
+    ASSERT_EQ(controller.ptz_mode(), PtzMode::Relative);
+
+    controller.move_to(0.05, 0.0);
+    EXPECT_EQ(mock->get_stored_value(CTRL_PAN_RELATIVE), 9);
+}
+
+} // namespace
+} // namespace bcc950
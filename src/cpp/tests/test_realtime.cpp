@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "bcc950/motion.hpp"
+#include "bcc950/realtime.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+double seconds_since(clock::time_point t) {
+    return std::chrono::duration<double>(clock::now() - t).count();
+}
+
+TEST(JitterHistogramTest, BucketsArePowersOfTwoMicroseconds) {
+    JitterHistogram h;
+    h.record(-1e-3);   // early counts as on time
+    h.record(0.5e-6);
+    h.record(1.5e-6);
+    h.record(3e-6);
+    h.record(100e-6);  // [64, 128) µs
+    h.record(1e3);
+
+    JitterStats s = h.stats();
+    ASSERT_EQ(s.buckets.size(), JitterHistogram::BUCKETS);
+    EXPECT_EQ(s.count, 6u);
+    EXPECT_EQ(s.buckets[0], 2u);
+    EXPECT_EQ(s.buckets[1], 1u);
+    EXPECT_EQ(s.buckets[2], 1u);
+    EXPECT_EQ(s.buckets[7], 1u);
+    EXPECT_EQ(s.buckets.back(), 1u);
+    EXPECT_DOUBLE_EQ(s.max, 1e3);
+
+    EXPECT_DOUBLE_EQ(s.quantile(0.5), 2e-6);
+    EXPECT_DOUBLE_EQ(s.quantile(0.8), 128e-6);
+    EXPECT_TRUE(std::isinf(s.quantile(1.0)));
+    EXPECT_DOUBLE_EQ(JitterStats::bucket_limit(0), 1e-6);
+
+    h.reset();
+    s = h.stats();
+    EXPECT_EQ(s.count, 0u);
+    EXPECT_DOUBLE_EQ(s.quantile(0.5), 0.0);
+}
+
+TEST(PreciseWaitTest, WakesAtTheDeadline) {
+    std::mutex m;
+    std::condition_variable cv;
+    std::unique_lock<std::mutex> lock(m);
+    for (double spin : {0.0, 2e-3}) {
+        auto deadline = clock::now() + std::chrono::milliseconds(20);
+        EXPECT_FALSE(wait_until_precise(lock, cv, deadline, spin, [] { return false; }));
+        auto late = std::chrono::duration<double>(clock::now() - deadline).count();
+        EXPECT_GE(late, 0.0);
+        EXPECT_LT(late, 0.02);
+    }
+}
+
+TEST(PreciseWaitTest, NoticesThePredicateWhileSpinning) {
+    std::mutex m;
+    std::condition_variable cv;
+    bool done = false;
+    std::thread setter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> lock(m);
+        done = true;  // no notify: only the spin loop can see this
+    });
+    auto start = clock::now();
+    std::unique_lock<std::mutex> lock(m);
+    EXPECT_TRUE(wait_until_precise(lock, cv, start + std::chrono::seconds(1), 0.99,
+                                   [&] { return done; }));
+    EXPECT_LT(seconds_since(start), 0.5);
+    lock.unlock();
+    setter.join();
+}
+
+TEST(ScopedRealtimeTest, RestoresTheThreadOnExit) {
+    int policy_before;
+    sched_param param_before;
+    ASSERT_EQ(pthread_getschedparam(pthread_self(), &policy_before, &param_before), 0);
+    cpu_set_t cpus_before;
+    ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpus_before), &cpus_before), 0);
+    int first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &cpus_before)) {
+        ++first_cpu;
+    }
+
+    {
+        ScopedRealtime off{RealtimeConfig{}};
+        EXPECT_FALSE(off.active());
+        EXPECT_TRUE(off.error().empty());
+    }
+
+    RealtimeConfig config;
+    config.enabled = true;
+    config.priority = 10;
+    config.cpu = first_cpu;
+    {
+        // Without CAP_SYS_NICE the scheduling is refused; either way the
+        // outcome is reported and undone.
+        ScopedRealtime rt(config);
+        int policy;
+        sched_param param;
+        ASSERT_EQ(pthread_getschedparam(pthread_self(), &policy, &param), 0);
+        if (rt.active()) {
+            EXPECT_EQ(policy, SCHED_FIFO);
+            EXPECT_EQ(param.sched_priority, 10);
+        } else {
+            EXPECT_EQ(policy, policy_before);
+            EXPECT_FALSE(rt.error().empty());
+        }
+    }
+    int policy_after;
+    sched_param param_after;
+    ASSERT_EQ(pthread_getschedparam(pthread_self(), &policy_after, &param_after), 0);
+    EXPECT_EQ(policy_after, policy_before);
+    EXPECT_EQ(param_after.sched_priority, param_before.sched_priority);
+    cpu_set_t cpus_after;
+    ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpus_after), &cpus_after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&cpus_after, &cpus_before));
+}
+
+class RealtimeMotionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_ = std::make_unique<testing::MockV4L2Device>();
+        motion_ = std::make_unique<MotionController>(mock_.get(), &position_);
+    }
+
+    std::unique_ptr<testing::MockV4L2Device> mock_;
+    PositionTracker position_;
+    std::unique_ptr<MotionController> motion_;
+};
+
+TEST_F(RealtimeMotionTest, RecordsOneWakePerStop) {
+    motion_->combined_move(1, 1, 0.03);
+    EXPECT_EQ(motion_->wake_jitter().count, 1u);  // both axes stop together
+
+    RealtimeConfig config;
+    config.enabled = true;
+    config.lock_memory = false;
+    config.spin = 2e-3;
+    bool ok = motion_->set_realtime(config);
+    EXPECT_EQ(ok, motion_->realtime_error().empty());
+    EXPECT_TRUE(motion_->realtime().enabled);
+
+    motion_->reset_wake_jitter();
+    motion_->pan(1, 0.03);
+    motion_->tilt(1, 0.02);
+    JitterStats s = motion_->wake_jitter();
+    EXPECT_EQ(s.count, 2u);
+    EXPECT_LT(s.max, 0.02);
+    EXPECT_NEAR(motion_->snapshot().pan, 0.06, 1e-9);
+}
+
+TEST_F(RealtimeMotionTest, CancelStillPreemptsARealtimeMove) {
+    RealtimeConfig config;
+    config.enabled = true;
+    config.lock_memory = false;
+    motion_->set_realtime(config);
+
+    std::thread mover([&] { motion_->pan(1, 0.4); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto start = clock::now();
+    motion_->cancel();
+    mover.join();
+    EXPECT_LT(seconds_since(start), 0.1);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(motion_->wake_jitter().count, 0u);  // cut short, not a wake
+    EXPECT_GT(motion_->snapshot().pan, 0.05);
+    EXPECT_LT(motion_->snapshot().pan, 0.3);
+}
+
+} // namespace
+} // namespace bcc950
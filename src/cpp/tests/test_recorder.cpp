@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bcc950/recorder.hpp"
+
+namespace bcc950 {
+namespace {
+
+struct RecordedSegment {
+    RecordIndexHeader header{};
+    std::vector<RecordIndexEntry> entries;
+    std::vector<uint8_t> data;
+};
+
+RecordedSegment load(const std::string& base) {
+    RecordedSegment seg;
+    std::ifstream idx(base + ".idx", std::ios::binary);
+    idx.read(reinterpret_cast<char*>(&seg.header), sizeof(seg.header));
+    RecordIndexEntry e;
+    while (idx.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+        seg.entries.push_back(e);
+    }
+    std::ifstream mjpg(base + ".mjpg", std::ios::binary);
+    seg.data.assign(std::istreambuf_iterator<char>(mjpg), std::istreambuf_iterator<char>());
+    return seg;
+}
+
+FramePtr frame(uint64_t seq, double ts, std::size_t size) {
+    std::vector<uint8_t> jpeg(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        jpeg[i] = static_cast<uint8_t>(seq * 31 + i * 7);
+    }
+    return std::make_shared<const Frame>(std::move(jpeg), 640, 480, seq, ts,
+                                         MotionState::Moving);
+}
+
+class RecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string tmpl = ::testing::TempDir() + "bcc950_rec_XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl.data()), nullptr);
+        dir_ = tmpl;
+        config_.directory = dir_;
+        config_.chunk_bytes = 8192;  // frames straddle chunks
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::string dir_;
+    RecorderConfig config_;
+};
+
+TEST_F(RecorderTest, WritesFramesWithPoses) {
+    PoseHistory history;
+    PoseSample pose;
+    pose.timestamp = 9.0;
+    pose.pan = 1.25;
+    pose.tilt = -0.5;
+    pose.zoom = 300.0;
+    history.record(pose);
+
+    Recorder recorder(config_, &history);
+    EXPECT_FALSE(recorder.write(frame(0, 10.0, 100)));  // not started
+    recorder.start();
+    EXPECT_TRUE(recorder.running());
+
+    std::vector<FramePtr> frames;
+    for (uint64_t i = 0; i < 20; ++i) {
+        frames.push_back(frame(i, 10.0 + i / 30.0, 3000 + i * 997));
+        while (!recorder.write(frames.back())) {
+            std::this_thread::yield();
+        }
+    }
+    recorder.stop();
+    EXPECT_FALSE(recorder.running());
+
+    RecorderStats stats = recorder.stats();
+    EXPECT_EQ(stats.frames, 20u);
+    EXPECT_EQ(stats.segments, 1u);
+    EXPECT_EQ(stats.errors, 0u);
+    ASSERT_EQ(recorder.segments().size(), 1u);
+
+    RecordedSegment seg = load(recorder.segments()[0]);
+    EXPECT_EQ(std::memcmp(seg.header.magic, RECORD_INDEX_MAGIC, 8), 0);
+    EXPECT_EQ(seg.header.version, RECORD_INDEX_VERSION);
+    EXPECT_EQ(seg.header.entry_size, sizeof(RecordIndexEntry));
+    ASSERT_EQ(seg.entries.size(), 20u);
+    EXPECT_EQ(seg.data.size(), stats.bytes);
+
+    uint64_t offset = 0;
+    for (std::size_t i = 0; i < 20; ++i) {
+        const RecordIndexEntry& e = seg.entries[i];
+        EXPECT_EQ(e.sequence, i);
+        EXPECT_DOUBLE_EQ(e.timestamp, frames[i]->timestamp());
+        EXPECT_EQ(e.offset, offset);
+        ASSERT_EQ(e.size, frames[i]->size());
+        EXPECT_EQ(std::memcmp(seg.data.data() + e.offset, frames[i]->data(), e.size), 0);
+        EXPECT_EQ(e.width, 640);
+        EXPECT_EQ(e.height, 480);
+        EXPECT_EQ(e.motion, static_cast<uint8_t>(MotionState::Moving));
+        EXPECT_EQ(e.flags & RECORD_FLAG_POSE_VALID, RECORD_FLAG_POSE_VALID);
+        EXPECT_DOUBLE_EQ(e.pan, 1.25);
+        EXPECT_DOUBLE_EQ(e.tilt, -0.5);
+        EXPECT_DOUBLE_EQ(e.zoom, 300.0);
+        EXPECT_EQ(e.pan_speed, 0);
+        offset += e.size;
+    }
+}
+
+TEST_F(RecorderTest, RotatesBySize) {
+    config_.max_segment_bytes = 100000;
+    Recorder recorder(config_);
+    recorder.start();
+    for (uint64_t i = 0; i < 10; ++i) {
+        while (!recorder.write(frame(i, i * 0.1, 30000))) {
+            std::this_thread::yield();
+        }
+    }
+    recorder.stop();
+
+    std::vector<std::string> segments = recorder.segments();
+    ASSERT_EQ(segments.size(), 4u);  // 3 + 3 + 3 + 1 frames
+    uint64_t next = 0;
+    for (const std::string& base : segments) {
+        RecordedSegment seg = load(base);
+        EXPECT_LE(seg.data.size(), config_.max_segment_bytes);
+        for (const RecordIndexEntry& e : seg.entries) {
+            EXPECT_EQ(e.sequence, next++);
+            EXPECT_EQ(e.flags & RECORD_FLAG_POSE_VALID, 0);
+        }
+    }
+    EXPECT_EQ(next, 10u);
+}
+
+TEST_F(RecorderTest, RotatesByTime) {
+    config_.max_segment_seconds = 1.0;
+    Recorder recorder(config_);
+    recorder.start();
+    for (uint64_t i = 0; i < 9; ++i) {
+        while (!recorder.write(frame(i, 100.0 + i * 0.25, 500))) {
+            std::this_thread::yield();
+        }
+    }
+    recorder.stop();
+
+    std::vector<std::string> segments = recorder.segments();
+    ASSERT_EQ(segments.size(), 3u);
+    EXPECT_EQ(load(segments[0]).entries.size(), 4u);
+    EXPECT_EQ(load(segments[1]).entries.size(), 4u);
+    EXPECT_EQ(load(segments[2]).entries.size(), 1u);
+}
+
+TEST_F(RecorderTest, RotatesOnRequest) {
+    Recorder recorder(config_);
+    recorder.start();
+    recorder.write(frame(0, 1.0, 500));
+    while (recorder.stats().segments < 1) {
+        std::this_thread::yield();
+    }
+    recorder.rotate();
+    recorder.write(frame(1, 1.1, 500));
+    recorder.stop();
+
+    std::vector<std::string> segments = recorder.segments();
+    ASSERT_EQ(segments.size(), 2u);
+    EXPECT_EQ(load(segments[0]).entries.size(), 1u);
+    EXPECT_EQ(load(segments[1]).entries.size(), 1u);
+}
+
+TEST_F(RecorderTest, SkipsExistingSegments) {
+    std::ofstream(dir_ + "/bcc950_000000.idx") << "taken";
+    Recorder recorder(config_);
+    recorder.start();
+    recorder.write(frame(0, 1.0, 100));
+    recorder.stop();
+
+    ASSERT_EQ(recorder.segments().size(), 1u);
+    EXPECT_EQ(recorder.segments()[0], dir_ + "/bcc950_000001");
+    EXPECT_EQ(load(recorder.segments()[0]).entries.size(), 1u);
+}
+
+TEST_F(RecorderTest, CountsFailuresWithoutStopping) {
+    config_.directory = dir_ + "/missing";
+    Recorder recorder(config_);
+    recorder.start();
+    recorder.write(frame(0, 1.0, 100));
+    recorder.write(frame(1, 1.1, 100));
+    recorder.stop();
+
+    RecorderStats stats = recorder.stats();
+    EXPECT_EQ(stats.frames, 0u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.errors, 1u);  // the second frame falls in the backoff
+    EXPECT_NE(recorder.last_error().find("Cannot create"), std::string::npos);
+}
+
+TEST_F(RecorderTest, BacksOffWithoutLeavingFiles) {
+    // The data file cannot be created, so every attempt fails after the
+    // index file is made.
+    std::filesystem::create_directory(dir_ + "/bcc950_000000.mjpg");
+    Recorder recorder(config_);
+    recorder.start();
+    for (uint64_t i = 0; i < 20; ++i) {
+        while (!recorder.write(frame(i, i / 30.0, 100))) {
+            std::this_thread::yield();
+        }
+    }
+    recorder.stop();
+
+    RecorderStats stats = recorder.stats();
+    EXPECT_EQ(stats.frames, 0u);
+    EXPECT_EQ(stats.dropped, 20u);
+    EXPECT_EQ(stats.errors, 1u);
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        (void)entry;
+        ++files;
+    }
+    EXPECT_EQ(files, 1u);  // just the blocking directory
+}
+
+} // namespace
+} // namespace bcc950
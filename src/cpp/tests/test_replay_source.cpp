@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bcc950/frame_buffer.hpp"
+#include "bcc950/recorder.hpp"
+#include "bcc950/replay_source.hpp"
+
+namespace bcc950 {
+namespace {
+
+FramePtr frame(uint64_t seq, double ts, std::size_t size) {
+    std::vector<uint8_t> jpeg(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        jpeg[i] = static_cast<uint8_t>(seq + i);
+    }
+    return std::make_shared<const Frame>(std::move(jpeg), 320, 240, seq, ts,
+                                         seq % 2 ? MotionState::Moving : MotionState::Stationary);
+}
+
+class ReplaySourceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string tmpl = ::testing::TempDir() + "bcc950_replay_XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl.data()), nullptr);
+        dir_ = tmpl;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    // Record `count` frames `interval` apart from t = 1000, panning
+    // right at one movement-second per second.
+    std::vector<std::string> record(int count, double interval,
+                                    uint64_t max_segment_bytes = RECORD_SEGMENT_BYTES) {
+        PoseHistory history;
+        PoseSample start;
+        start.timestamp = 999.0;
+        start.pan = 0.5;
+        start.pan_speed = 1;
+        history.record(start);
+
+        RecorderConfig config;
+        config.directory = dir_;
+        config.max_segment_bytes = max_segment_bytes;
+        Recorder recorder(config, &history);
+        recorder.start();
+        for (int i = 0; i < count; ++i) {
+            FramePtr f = frame(static_cast<uint64_t>(i), 1000.0 + i * interval,
+                               1000 + static_cast<std::size_t>(i) * 100);
+            frames_.push_back(f);
+            while (!recorder.write(f)) {
+                std::this_thread::yield();
+            }
+        }
+        recorder.stop();
+        return recorder.segments();
+    }
+
+    std::string dir_;
+    std::vector<FramePtr> frames_;
+};
+
+TEST_F(ReplaySourceTest, ReplaysFramesAndPosesAtFullSpeed) {
+    auto segments = record(30, 1.0 / 30, 12000);
+    ASSERT_GT(segments.size(), 1u);
+    EXPECT_EQ(ReplaySource::find_segments(dir_), segments);
+
+    ReplayConfig config;
+    config.speed = 0.0;
+    ReplaySource replay(segments, config);
+    ASSERT_EQ(replay.frame_count(), 30u);
+    EXPECT_DOUBLE_EQ(replay.start_time(), 1000.0);
+    EXPECT_DOUBLE_EQ(replay.end_time(), 1000.0 + 29.0 / 30);
+
+    double first = 0.0;
+    for (std::size_t i = 0; i < 30; ++i) {
+        FramePtr f = replay.read(0.0);
+        ASSERT_NE(f, nullptr) << i;
+        const FramePtr& original = frames_[i];
+        EXPECT_EQ(f->sequence(), original->sequence());
+        ASSERT_EQ(f->size(), original->size());
+        EXPECT_TRUE(std::equal(f->data(), f->data() + f->size(), original->data()));
+        EXPECT_EQ(f->width(), 320);
+        EXPECT_EQ(f->motion(), original->motion());
+        if (i == 0) {
+            first = f->timestamp();
+        }
+        // Recorded spacing on the rebased clock.
+        EXPECT_NEAR(f->timestamp() - first, i / 30.0, 1e-9);
+
+        auto pose = replay.pose_history().pose_at(f->timestamp());
+        ASSERT_TRUE(pose);
+        EXPECT_NEAR(pose->pan, 0.5 + 1.0 + i / 30.0, 1e-6);
+    }
+    EXPECT_TRUE(replay.finished());
+    EXPECT_EQ(replay.read(0.01), nullptr);
+}
+
+TEST_F(ReplaySourceTest, SeeksByTimestamp) {
+    auto segments = record(10, 0.5);
+    ReplaySource replay(segments, ReplayConfig{0.0, false});
+
+    EXPECT_TRUE(replay.seek(1002.2));  // frames at 1002.0, 1002.5, ...
+    EXPECT_EQ(replay.position(), 5u);
+    FramePtr a = replay.read(0.0);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->sequence(), 5u);
+
+    // Seeking back keeps the rebased clock moving forward.
+    EXPECT_TRUE(replay.seek(0.0));
+    FramePtr b = replay.read(0.0);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->sequence(), 0u);
+    EXPECT_GT(b->timestamp(), a->timestamp());
+
+    EXPECT_FALSE(replay.seek(2000.0));
+    EXPECT_TRUE(replay.finished());
+    EXPECT_TRUE(replay.seek_frame(9));
+    ASSERT_NE(replay.read(0.0), nullptr);
+    EXPECT_EQ(replay.read(0.0), nullptr);
+}
+
+TEST_F(ReplaySourceTest, PacesInRealTime) {
+    auto segments = record(5, 0.05);
+    ReplaySource replay(segments);  // speed 1
+
+    double start = PoseHistory::now();
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(replay.read(1.0), nullptr);
+    }
+    double elapsed = PoseHistory::now() - start;
+    EXPECT_GE(elapsed, 0.19);
+    EXPECT_LT(elapsed, 0.5);
+
+    // Twice as fast.
+    replay.seek_frame(0);
+    replay.set_speed(2.0);
+    start = PoseHistory::now();
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(replay.read(1.0), nullptr);
+    }
+    elapsed = PoseHistory::now() - start;
+    EXPECT_GE(elapsed, 0.09);
+    EXPECT_LT(elapsed, 0.18);
+}
+
+TEST_F(ReplaySourceTest, TimesOutBeforeADueFrame) {
+    auto segments = record(2, 0.5);
+    ReplaySource replay(segments);
+    ASSERT_NE(replay.read(0.1), nullptr);
+    EXPECT_EQ(replay.read(0.05), nullptr);  // due in 0.5 s
+    EXPECT_NE(replay.read(1.0), nullptr);
+}
+
+TEST_F(ReplaySourceTest, LoopsWithMonotonicTimestamps) {
+    auto segments = record(3, 0.1);
+    ReplaySource replay(segments, ReplayConfig{0.0, true});
+    double last = 0.0;
+    for (int i = 0; i < 7; ++i) {
+        FramePtr f = replay.read(0.0);
+        ASSERT_NE(f, nullptr);
+        EXPECT_EQ(f->sequence(), static_cast<uint64_t>(i % 3));
+        EXPECT_GT(f->timestamp(), last);
+        last = f->timestamp();
+    }
+    EXPECT_FALSE(replay.finished());
+}
+
+TEST_F(ReplaySourceTest, FeedsAFrameBuffer) {
+    auto segments = record(4, 0.02);
+    ReplaySource replay(segments, ReplayConfig{0.0, false});
+    FrameBuffer buffer(replay);
+    buffer.start();
+    for (int i = 0; i < 200 && buffer.frame_id() < 4; ++i) {
+        buffer.wait_next(buffer.frame_id(), 0.05);
+    }
+    EXPECT_EQ(buffer.frame_id(), 4u);
+    EXPECT_EQ(buffer.latest()->sequence(), 3u);
+}
+
+TEST_F(ReplaySourceTest, ToleratesTruncatedSegments) {
+    auto segments = record(5, 0.1);
+    ASSERT_EQ(segments.size(), 1u);
+    // Lose the tail of the last frame, and half an index entry.
+    std::filesystem::resize_file(segments[0] + ".mjpg",
+                                 std::filesystem::file_size(segments[0] + ".mjpg") - 10);
+    std::ofstream(segments[0] + ".idx", std::ios::app) << "partial";
+
+    ReplaySource replay(segments);
+    EXPECT_EQ(replay.frame_count(), 4u);
+}
+
+TEST_F(ReplaySourceTest, RejectsOtherFiles) {
+    EXPECT_THROW(ReplaySource({dir_ + "/missing"}), std::runtime_error);
+    std::ofstream(dir_ + "/bogus.idx") << "not an index at all";
+    std::ofstream(dir_ + "/bogus.mjpg") << "";
+    EXPECT_THROW(ReplaySource({dir_ + "/bogus"}), std::runtime_error);
+    EXPECT_TRUE(ReplaySource::find_segments(dir_).empty());
+}
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/motion.hpp"
+#include "bcc950/position.hpp"
+#include "bcc950/scan_planner.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+/// A wide, short area: many pan positions, few tilt rows.
+ScanSpec wide_spec(ScanPattern pattern) {
+    ScanSpec spec;
+    spec.pan_min  = -4.0;
+    spec.pan_max  =  4.0;
+    spec.tilt_min = -2.0;
+    spec.tilt_max =  2.0;
+    spec.pattern  = pattern;
+    return spec;
+}
+
+// ---- scan_positions ----
+
+TEST(ScanPositionsTest, SpansRangeWithinStep) {
+    auto pos = scan_positions(-1.0, 1.0, 0.7);
+    ASSERT_EQ(pos.size(), 4u);
+    EXPECT_DOUBLE_EQ(pos.front(), -1.0);
+    EXPECT_DOUBLE_EQ(pos.back(), 1.0);
+    for (std::size_t i = 1; i < pos.size(); ++i) {
+        EXPECT_LE(pos[i] - pos[i - 1], 0.7 + 1e-12);
+    }
+}
+
+TEST(ScanPositionsTest, SingleViewUsesMidpoint) {
+    auto pos = scan_positions(-0.2, 0.4, 1.0);
+    ASSERT_EQ(pos.size(), 1u);
+    EXPECT_DOUBLE_EQ(pos[0], 0.1);
+}
+
+// ---- plan_scan ----
+
+TEST(ScanPlannerTest, BoustrophedonStopsOnlyAtRowEnds) {
+    ScanSpec spec = wide_spec(ScanPattern::Boustrophedon);
+    Trajectory t = plan_scan(spec, 0.0, 0.0);
+
+    // Every waypoint is at one end of the sweep axis, whichever it is.
+    ASSERT_GE(t.waypoints.size(), 2u);
+    EXPECT_EQ(t.waypoints.size() % 2, 0u);
+    bool all_pan_ends = true;
+    bool all_tilt_ends = true;
+    for (const auto& w : t.waypoints) {
+        all_pan_ends  &= w.pan == spec.pan_min || w.pan == spec.pan_max;
+        all_tilt_ends &= w.tilt == spec.tilt_min || w.tilt == spec.tilt_max;
+        EXPECT_DOUBLE_EQ(w.dwell, 0.0);
+    }
+    EXPECT_TRUE(all_pan_ends || all_tilt_ends);
+}
+
+TEST(ScanPlannerTest, StartsFromNearestCorner) {
+    ScanSpec spec = wide_spec(ScanPattern::Boustrophedon);
+    Trajectory t = plan_scan(spec, 4.0, 2.0);
+    ASSERT_FALSE(t.waypoints.empty());
+    EXPECT_DOUBLE_EQ(t.waypoints.front().pan, 4.0);
+    EXPECT_DOUBLE_EQ(t.waypoints.front().tilt, 2.0);
+}
+
+TEST(ScanPlannerTest, NoSlowerThanEitherSweepOrientation) {
+    ScanSpec spec = wide_spec(ScanPattern::Snapshots);
+    auto pans  = scan_positions(spec.pan_min, spec.pan_max,
+        spec.optics.movement_seconds(Axis::Pan, 1.0 - spec.overlap, spec.zoom));
+    auto tilts = scan_positions(spec.tilt_min, spec.tilt_max,
+        spec.optics.movement_seconds(Axis::Tilt, 1.0 - spec.overlap, spec.zoom));
+
+    // Hand-built serpentines from the same corner, rows along each axis.
+    Trajectory by_rows, by_cols;
+    for (std::size_t r = 0; r < tilts.size(); ++r) {
+        for (std::size_t c = 0; c < pans.size(); ++c) {
+            std::size_t cc = r % 2 ? pans.size() - 1 - c : c;
+            by_rows.waypoints.push_back({pans[cc], tilts[r], 0.0});
+        }
+    }
+    for (std::size_t c = 0; c < pans.size(); ++c) {
+        for (std::size_t r = 0; r < tilts.size(); ++r) {
+            std::size_t rr = c % 2 ? tilts.size() - 1 - r : r;
+            by_cols.waypoints.push_back({pans[c], tilts[rr], 0.0});
+        }
+    }
+
+    double planned = plan_scan(spec, -4.0, -2.0).duration(-4.0, -2.0);
+    EXPECT_LE(planned, by_rows.duration(-4.0, -2.0));
+    EXPECT_LE(planned, by_cols.duration(-4.0, -2.0));
+}
+
+TEST(ScanPlannerTest, SnapshotsVisitEveryGridPoseOnce) {
+    ScanSpec spec = wide_spec(ScanPattern::Snapshots);
+    spec.dwell = 0.3;
+    Trajectory t = plan_scan(spec, 0.0, 0.0);
+
+    std::set<std::pair<double, double>> poses;
+    for (const auto& w : t.waypoints) {
+        EXPECT_DOUBLE_EQ(w.dwell, 0.3);
+        poses.insert({w.pan, w.tilt});
+    }
+    EXPECT_EQ(poses.size(), t.waypoints.size());
+}
+
+TEST(ScanPlannerTest, SpiralStartsNearCurrentPose) {
+    ScanSpec spec = wide_spec(ScanPattern::Spiral);
+    Trajectory snapshots = plan_scan(wide_spec(ScanPattern::Snapshots), 0.0, 0.0);
+    Trajectory t = plan_scan(spec, 3.9, 1.9);
+
+    ASSERT_EQ(t.waypoints.size(), snapshots.waypoints.size());
+    EXPECT_DOUBLE_EQ(t.waypoints.front().pan, 4.0);
+    EXPECT_DOUBLE_EQ(t.waypoints.front().tilt, 2.0);
+    std::set<std::pair<double, double>> poses;
+    for (const auto& w : t.waypoints) {
+        poses.insert({w.pan, w.tilt});
+    }
+    EXPECT_EQ(poses.size(), t.waypoints.size());
+}
+
+TEST(ScanPlannerTest, HigherZoomNeedsMorePoses) {
+    ScanSpec wide = wide_spec(ScanPattern::Snapshots);
+    ScanSpec tele = wide;
+    tele.zoom = ZOOM_MAX;
+    EXPECT_GT(plan_scan(tele, 0.0, 0.0).waypoints.size(),
+              plan_scan(wide, 0.0, 0.0).waypoints.size());
+}
+
+TEST(ScanPlannerTest, DurationCountsParallelAxesAndDwell) {
+    Trajectory t;
+    t.waypoints.push_back({1.0, 0.5, 0.25});
+    t.waypoints.push_back({1.0, -0.5, 0.0});
+    EXPECT_DOUBLE_EQ(t.duration(0.0, 0.0), 1.0 + 0.25 + 1.0);
+}
+
+// ---- Running a trajectory ----
+
+/// Fixture providing a MotionController wired to a MockV4L2Device.
+class TrajectoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_ = std::make_unique<testing::MockV4L2Device>();
+        position_ = PositionTracker{};
+        motion_ = std::make_unique<MotionController>(mock_.get(), &position_);
+    }
+
+    std::unique_ptr<testing::MockV4L2Device> mock_;
+    PositionTracker position_;
+    std::unique_ptr<MotionController> motion_;
+};
+
+TEST_F(TrajectoryTest, VisitsEachWaypoint) {
+    Trajectory t;
+    t.waypoints.push_back({0.03, 0.0, 0.0});
+    t.waypoints.push_back({0.03, -0.02, 0.01});
+    t.waypoints.push_back({0.0, 0.0, 0.0});
+
+    EXPECT_TRUE(motion_->run_trajectory(t));
+    EXPECT_NEAR(position_.pan, 0.0, 1e-9);
+    EXPECT_NEAR(position_.tilt, 0.0, 1e-9);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_TILT_SPEED), 0);
+}
+
+TEST_F(TrajectoryTest, CancelStopsTrajectory) {
+    Trajectory t;
+    t.waypoints.push_back({0.01, 0.0, 2.0});  // long dwell
+    t.waypoints.push_back({1.0, 0.0, 0.0});
+
+    bool result = true;
+    std::thread runner([&] { result = motion_->run_trajectory(t); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    motion_->cancel();
+    runner.join();
+
+    EXPECT_FALSE(result);
+    EXPECT_NEAR(position_.pan, 0.01, 1e-9);
+}
+
+} // anonymous namespace
+} // namespace bcc950
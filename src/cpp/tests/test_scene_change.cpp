@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bcc950/scene_change.hpp"
+
+#include "jpeg_fixture.hpp"
+
+namespace bcc950 {
+namespace {
+
+Image gray(int w, int h, int (*value)(int x, int y)) {
+    Image image;
+    image.width = w;
+    image.height = h;
+    image.channels = 1;
+    image.pixels.resize(static_cast<std::size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            image.pixels[static_cast<std::size_t>(y) * w + x] = static_cast<uint8_t>(value(x, y));
+        }
+    }
+    return image;
+}
+
+int pattern(int x, int y) { return (x * 31 + y * 17 + x * y) % 251; }
+
+TEST(SceneSignatureTest, BlocksAreAreaMeans) {
+    for (auto [w, h] : {std::pair{160, 90}, std::pair{37, 29}, std::pair{3, 2}}) {
+        Image image = gray(w, h, pattern);
+        SceneSignature sig = scene_signature(image);
+        const int n = SceneSignature::GRID;
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                int x0 = std::min(c * w / n, w - 1), x1 = std::max((c + 1) * w / n, x0 + 1);
+                int y0 = std::min(r * h / n, h - 1), y1 = std::max((r + 1) * h / n, y0 + 1);
+                double sum = 0;
+                for (int y = y0; y < y1; ++y) {
+                    for (int x = x0; x < x1; ++x) {
+                        sum += pattern(x, y);
+                    }
+                }
+                double mean = sum / ((x1 - x0) * (y1 - y0));
+                EXPECT_NEAR(sig.blocks[r * n + c], mean, 0.5) << w << "x" << h << " " << r << "," << c;
+            }
+        }
+    }
+}
+
+TEST(SceneSignatureTest, DhashFollowsHorizontalGradient) {
+    auto rising = scene_signature(gray(90, 40, [](int x, int) { return x * 2; }));
+    auto falling = scene_signature(gray(90, 40, [](int x, int) { return 200 - x * 2; }));
+    auto flat = scene_signature(gray(90, 40, [](int, int) { return 128; }));
+    EXPECT_EQ(rising.dhash, 0u);
+    EXPECT_EQ(falling.dhash, ~uint64_t{0});
+    EXPECT_EQ(flat.dhash, 0u);
+    EXPECT_EQ(hash_distance(rising, falling), 64);
+    EXPECT_DOUBLE_EQ(block_distance(flat, flat), 0.0);
+}
+
+TEST(SceneSignatureTest, DhashIgnoresExposure) {
+    auto base = scene_signature(gray(160, 90, [](int x, int y) { return pattern(x / 20, y / 11); }));
+    auto brighter = scene_signature(gray(160, 90, [](int x, int y) {
+        return pattern(x / 20, y / 11) / 2 + 100;
+    }));
+    EXPECT_LE(hash_distance(base, brighter), 2);
+    EXPECT_GT(block_distance(base, brighter), 20.0);
+}
+
+TEST(SceneSignatureTest, RejectsColorAndEmptyImages) {
+    Image color = gray(8, 8, pattern);
+    color.channels = 3;
+    EXPECT_THROW(scene_signature(color), std::invalid_argument);
+    EXPECT_THROW(scene_signature(Image{}), std::invalid_argument);
+}
+
+SceneSignature flat_signature(uint8_t level, uint64_t dhash = 0) {
+    SceneSignature sig;
+    sig.blocks.fill(level);
+    sig.dhash = dhash;
+    return sig;
+}
+
+TEST(SceneChangeDetectorTest, RunsOnChangeAndTimeout) {
+    SceneChangeConfig config;
+    config.max_interval = 5.0;
+    SceneChangeDetector detector(config);
+
+    auto d = detector.update(flat_signature(100), 0.0, true);
+    EXPECT_TRUE(d.run);
+    EXPECT_EQ(d.trigger, SceneTrigger::First);
+
+    d = detector.update(flat_signature(104, 0x3), 1.0, true);  // small drift
+    EXPECT_FALSE(d.run);
+    EXPECT_EQ(d.hash_distance, 2);
+    EXPECT_DOUBLE_EQ(d.block_distance, 4.0);
+
+    // Drift is measured from the last pass, so it accumulates.
+    d = detector.update(flat_signature(110, 0x3), 2.0, true);
+    EXPECT_TRUE(d.run);
+    EXPECT_EQ(d.trigger, SceneTrigger::Changed);
+
+    d = detector.update(flat_signature(110, 0xFF), 3.0, true);  // 6 bits
+    EXPECT_FALSE(d.run);
+    d = detector.update(flat_signature(110, 0x1FF), 4.0, true);  // 7 bits
+    EXPECT_EQ(d.trigger, SceneTrigger::Changed);
+
+    EXPECT_FALSE(detector.update(flat_signature(110, 0x1FF), 8.9, true).run);
+    d = detector.update(flat_signature(110, 0x1FF), 9.0, true);
+    EXPECT_EQ(d.trigger, SceneTrigger::Timeout);
+
+    EXPECT_EQ(detector.frames(), 7u);
+    EXPECT_EQ(detector.runs(), 4u);
+}
+
+TEST(SceneChangeDetectorTest, WaitsForTheHeadToSettle) {
+    SceneChangeDetector detector;
+    detector.update(flat_signature(100), 0.0, true);
+
+    // Moving frames change completely but do not run...
+    EXPECT_FALSE(detector.update(flat_signature(200, ~uint64_t{0}), 0.5, false).run);
+    EXPECT_FALSE(detector.update(flat_signature(10, 0), 1.0, false).run);
+    // ...except on the timeout, which does not end the motion.
+    auto d = detector.update(flat_signature(10, 0), 5.0, false);
+    EXPECT_EQ(d.trigger, SceneTrigger::Timeout);
+
+    // The first settled frame runs even if it matches the reference.
+    d = detector.update(flat_signature(10, 0), 5.5, true);
+    EXPECT_EQ(d.trigger, SceneTrigger::Settled);
+    EXPECT_FALSE(detector.update(flat_signature(10, 0), 6.0, true).run);
+
+    detector.reset();
+    EXPECT_EQ(detector.update(flat_signature(10, 0), 6.5, true).trigger, SceneTrigger::First);
+}
+
+TEST(SceneChangeDetectorTest, FirstPassWhileMovingStillSettles) {
+    SceneChangeDetector detector;
+    EXPECT_EQ(detector.update(flat_signature(100), 0.0, false).trigger, SceneTrigger::First);
+    EXPECT_FALSE(detector.update(flat_signature(100), 0.5, false).run);
+    EXPECT_EQ(detector.update(flat_signature(100), 1.0, true).trigger, SceneTrigger::Settled);
+    EXPECT_FALSE(detector.update(flat_signature(100), 1.5, true).run);
+}
+
+TEST(SceneChangeDetectorTest, FailsOpenOnUndecodableFrames) {
+    SceneChangeDetector detector;
+    Frame bogus(std::vector<uint8_t>{1, 2, 3}, 8, 8, 1, 1.0);
+    auto d = detector.update(bogus);
+    EXPECT_TRUE(d.run);
+    EXPECT_EQ(d.trigger, SceneTrigger::NoSignature);
+    EXPECT_TRUE(detector.update(bogus).run);
+}
+
+#ifdef BCC950_HAVE_JPEG
+
+Frame jpeg_frame(int noise, bool square, double ts) {
+    constexpr int W = 160, H = 120;
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(W) * H);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            int v = 30 + x + ((x * 7 + y * 13) % 3) * noise;
+            if (square && x >= 60 && x < 110 && y >= 30 && y < 80) {
+                v = 250;
+            }
+            pixels[static_cast<std::size_t>(y) * W + x] = static_cast<uint8_t>(v);
+        }
+    }
+    return Frame(testing::encode_jpeg(pixels, W, H, 1), W, H, 0, ts);
+}
+
+TEST(SceneChangeDetectorTest, GatesDecodedFrames) {
+    SceneChangeDetector detector;
+    EXPECT_EQ(detector.update(jpeg_frame(0, false, 1.0)).trigger, SceneTrigger::First);
+    auto d = detector.update(jpeg_frame(2, false, 1.1));  // sensor noise
+    EXPECT_FALSE(d.run);
+    EXPECT_LE(d.hash_distance, 1);
+    d = detector.update(jpeg_frame(0, true, 1.2));  // something walked in
+    EXPECT_TRUE(d.run);
+    EXPECT_EQ(d.trigger, SceneTrigger::Changed);
+}
+
+#endif
+
+} // namespace
+} // namespace bcc950
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/motion.hpp"
+#include "bcc950/position.hpp"
+#include "bcc950/scheduler.hpp"
+#include "mock_v4l2_device.hpp"
+
+namespace bcc950 {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// Fixture providing a CommandScheduler in front of a mock-backed
+/// MotionController.
+class SchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_ = std::make_unique<testing::MockV4L2Device>();
+        position_ = PositionTracker{};
+        motion_ = std::make_unique<MotionController>(mock_.get(), &position_);
+        scheduler_ = std::make_unique<CommandScheduler>(*motion_);
+    }
+
+    void TearDown() override {
+        scheduler_.reset();
+    }
+
+    /// Spin until the worker is executing a command from `source`.
+    bool wait_running(CommandSource source) {
+        auto deadline = clock_type::now() + std::chrono::seconds(2);
+        while (clock_type::now() < deadline) {
+            if (scheduler_->running() == source) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    std::unique_ptr<testing::MockV4L2Device> mock_;
+    PositionTracker position_;
+    std::unique_ptr<MotionController> motion_;
+    std::unique_ptr<CommandScheduler> scheduler_;
+};
+
+TEST_F(SchedulerTest, ExecutesSubmittedMove) {
+    ASSERT_TRUE(scheduler_->submit(CommandSource::Operator,
+                                   MotionCommand::move(1, 0, 0.01)));
+    scheduler_->wait_idle();
+
+    const auto calls = mock_->get_calls();
+    ASSERT_EQ(calls.size(), 4u);
+    EXPECT_EQ(calls[0].first, CTRL_PAN_SPEED);
+    EXPECT_EQ(calls[0].second, 1);
+    EXPECT_EQ(scheduler_->stats(CommandSource::Operator).executed, 1u);
+}
+
+TEST_F(SchedulerTest, OperatorStopPreemptsTourLeg) {
+    scheduler_->submit(CommandSource::Tour, MotionCommand::move(1, 0, 3.0));
+    ASSERT_TRUE(wait_running(CommandSource::Tour));
+
+    auto start = clock_type::now();
+    scheduler_->submit(CommandSource::Operator, MotionCommand::stop());
+    scheduler_->wait_idle();
+    double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    EXPECT_LT(elapsed, 1.0);
+    EXPECT_EQ(scheduler_->stats(CommandSource::Tour).preempted, 1u);
+    EXPECT_LT(position_.pan, 3.0);
+    EXPECT_EQ(mock_->get_stored_value(CTRL_PAN_SPEED), 0);
+}
+
+TEST_F(SchedulerTest, LowerPriorityDoesNotPreempt) {
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(1, 0, 0.1));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::move(-1, 0, 0.01));
+    scheduler_->wait_idle();
+
+    EXPECT_EQ(scheduler_->stats(CommandSource::Operator).preempted, 0u);
+    EXPECT_DOUBLE_EQ(position_.pan, 0.1 - 0.01);
+}
+
+TEST_F(SchedulerTest, HigherPriorityQueueDispatchedFirst) {
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(0, 0, 0.1));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    scheduler_->submit(CommandSource::Idle, MotionCommand::zoom_to(200));
+    scheduler_->submit(CommandSource::Operator, MotionCommand::zoom_to(300));
+    scheduler_->wait_idle();
+
+    std::vector<int32_t> zooms;
+    for (const auto& call : mock_->get_calls()) {
+        if (call.first == CTRL_ZOOM_ABSOLUTE) {
+            zooms.push_back(call.second);
+        }
+    }
+    ASSERT_EQ(zooms.size(), 2u);
+    EXPECT_EQ(zooms[0], 300);
+    EXPECT_EQ(zooms[1], 200);
+}
+
+TEST_F(SchedulerTest, TrackerUpdatesCoalesce) {
+    // Keep the newest update inside its latency budget.
+    SourcePolicy policy = scheduler_->policy(CommandSource::Tracker);
+    policy.latency_budget = std::chrono::milliseconds(5000);
+    scheduler_->set_policy(CommandSource::Tracker, policy);
+
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(0, 0, 0.05));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    for (int i = 0; i < 5; ++i) {
+        scheduler_->submit(CommandSource::Tracker, MotionCommand::zoom_to(110 + i));
+    }
+    scheduler_->wait_idle();
+
+    auto stats = scheduler_->stats(CommandSource::Tracker);
+    EXPECT_EQ(stats.submitted, 5u);
+    EXPECT_EQ(stats.coalesced, 4u);
+    EXPECT_EQ(stats.executed, 1u);
+    EXPECT_EQ(position_.zoom, 114);
+}
+
+TEST_F(SchedulerTest, DeviceBackpressureCoalescesQueuedCommands) {
+    std::atomic<double> backlog{0.0};
+    scheduler_->set_backpressure([&] { return backlog.load(); });
+
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(0, 0, 0.05));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::zoom_to(110));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::zoom_to(111));
+    backlog = 0.2;
+    scheduler_->submit(CommandSource::Tour, MotionCommand::zoom_to(112));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::zoom_to(113));
+    scheduler_->wait_idle();
+
+    auto stats = scheduler_->stats(CommandSource::Tour);
+    EXPECT_EQ(stats.paced, 3u);
+    EXPECT_EQ(stats.coalesced, 0u);
+    EXPECT_EQ(stats.executed, 1u);
+    EXPECT_EQ(position_.zoom, 113);
+}
+
+TEST_F(SchedulerTest, StaleTrackerCommandExpires) {
+    SourcePolicy policy = scheduler_->policy(CommandSource::Tracker);
+    policy.latency_budget = std::chrono::milliseconds(1);
+    scheduler_->set_policy(CommandSource::Tracker, policy);
+
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(0, 0, 0.05));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    scheduler_->submit(CommandSource::Tracker, MotionCommand::zoom_to(400));
+    scheduler_->wait_idle();
+
+    auto stats = scheduler_->stats(CommandSource::Tracker);
+    EXPECT_EQ(stats.expired, 1u);
+    EXPECT_EQ(stats.executed, 0u);
+    EXPECT_EQ(position_.zoom, ZOOM_DEFAULT);
+}
+
+TEST_F(SchedulerTest, StopClearsLowerPriorityQueues) {
+    scheduler_->submit(CommandSource::Operator, MotionCommand::move(0, 0, 0.05));
+    ASSERT_TRUE(wait_running(CommandSource::Operator));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::move(1, 0, 0.01));
+    scheduler_->submit(CommandSource::Tour, MotionCommand::move(1, 0, 0.01));
+    scheduler_->submit(CommandSource::Tracker, MotionCommand::stop());
+    scheduler_->wait_idle();
+
+    EXPECT_EQ(scheduler_->stats(CommandSource::Tour).executed, 0u);
+    EXPECT_EQ(scheduler_->stats(CommandSource::Tour).coalesced, 2u);
+    EXPECT_DOUBLE_EQ(position_.pan, 0.0);
+}
+
+TEST_F(SchedulerTest, RunsTrajectoryCommand) {
+    Trajectory path;
+    path.waypoints.push_back({0.02, 0.01, 0.0});
+    path.waypoints.push_back({-0.01, 0.01, 0.0});
+    scheduler_->submit(CommandSource::Tour, MotionCommand::follow(std::move(path)));
+    scheduler_->wait_idle();
+
+    EXPECT_EQ(scheduler_->stats(CommandSource::Tour).executed, 1u);
+    EXPECT_NEAR(position_.pan, -0.01, 1e-9);
+    EXPECT_NEAR(position_.tilt, 0.01, 1e-9);
+}
+
+TEST_F(SchedulerTest, SubmitAfterShutdownIsRejected) {
+    scheduler_->shutdown();
+    EXPECT_FALSE(scheduler_->submit(CommandSource::Operator, MotionCommand::stop()));
+}
+
+TEST(PreemptsTest, FollowsSourceOrder) {
+    EXPECT_TRUE(preempts(CommandSource::Operator, CommandSource::Tracker));
+    EXPECT_TRUE(preempts(CommandSource::Tracker, CommandSource::Tour));
+    EXPECT_TRUE(preempts(CommandSource::Tour, CommandSource::Idle));
+    EXPECT_FALSE(preempts(CommandSource::Idle, CommandSource::Operator));
+    EXPECT_FALSE(preempts(CommandSource::Tour, CommandSource::Tour));
+}
+
+} // anonymous namespace
+} // namespace bcc950
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bcc950/snapshot_cache.hpp"
+
+#include "jpeg_fixture.hpp"
+
+namespace bcc950 {
+namespace {
+
+std::string b64(const std::string& s) {
+    return base64_encode(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+TEST(SnapshotCacheTest, Base64MatchesRfc4648) {
+    EXPECT_EQ(b64(""), "");
+    EXPECT_EQ(b64("f"), "Zg==");
+    EXPECT_EQ(b64("fo"), "Zm8=");
+    EXPECT_EQ(b64("foo"), "Zm9v");
+    EXPECT_EQ(b64("foob"), "Zm9vYg==");
+    EXPECT_EQ(b64("fooba"), "Zm9vYmE=");
+    EXPECT_EQ(b64("foobar"), "Zm9vYmFy");
+    const uint8_t high[] = {0xFB, 0xFF, 0xBF};
+    EXPECT_EQ(base64_encode(high, 3), "+/+/");
+}
+
+TEST(SnapshotCacheTest, MeanAbsDiffMatchesScalar) {
+    for (std::size_t n : {0u, 1u, 15u, 16u, 17u, 100u, 4099u}) {
+        std::vector<uint8_t> a(n), b(n);
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<uint8_t>(i * 37 + 11);
+            b[i] = static_cast<uint8_t>(i * 101 + 200);
+            sum += static_cast<uint64_t>(std::abs(int(a[i]) - int(b[i])));
+        }
+        double expected = n ? static_cast<double>(sum) / n : 0.0;
+        EXPECT_DOUBLE_EQ(mean_abs_diff(a.data(), b.data(), n), expected) << n;
+        EXPECT_DOUBLE_EQ(mean_abs_diff(a.data(), a.data(), n), 0.0);
+    }
+}
+
+#ifdef BCC950_HAVE_JPEG
+
+constexpr int W = 128;
+constexpr int H = 96;
+
+/// A gray gradient, optionally with a bright square at (x, y).
+std::vector<uint8_t> scene_jpeg(int square_x = -1, int square_y = -1, int noise = 0) {
+    std::vector<uint8_t> gray(static_cast<std::size_t>(W) * H);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            int v = 40 + x + y / 2 + ((x * 7 + y * 13) % 3) * noise;
+            if (square_x >= 0 && x >= square_x && x < square_x + 40 &&
+                y >= square_y && y < square_y + 40) {
+                v = 250;
+            }
+            gray[static_cast<std::size_t>(y) * W + x] = static_cast<uint8_t>(v);
+        }
+    }
+    return testing::encode_jpeg(gray, W, H, 1);
+}
+
+FramePtr frame(std::vector<uint8_t> jpeg, uint64_t seq, double ts,
+               MotionState motion = MotionState::Stationary) {
+    return std::make_shared<const Frame>(std::move(jpeg), W, H, seq, ts, motion);
+}
+
+class SnapshotCacheJpegTest : public ::testing::Test {
+protected:
+    void SetUp() override { pose(0.0, 0.0, 0.0); }
+
+    // Hold the head still at (pan, tilt) from time `t` on.
+    void pose(double t, double pan, double tilt) {
+        PoseSample p;
+        p.timestamp = t;
+        p.pan = pan;
+        p.tilt = tilt;
+        history_.record(p);
+    }
+
+    PoseHistory history_;
+};
+
+TEST_F(SnapshotCacheJpegTest, ReusesSnapshotWhileSceneIsUnchanged) {
+    SnapshotCache cache(&history_);
+    auto jpeg = scene_jpeg();
+    FramePtr first = frame(jpeg, 1, 1.0);
+    Snapshot a = cache.get(first);
+    EXPECT_FALSE(a.cached);
+    EXPECT_EQ(a.base64, base64_encode(jpeg.data(), jpeg.size()));
+    EXPECT_EQ(a.frame, first);
+
+    // Sensor noise only: same snapshot string, same source frame.
+    Snapshot b = cache.get(frame(scene_jpeg(-1, -1, 1), 2, 2.0));
+    EXPECT_TRUE(b.cached);
+    EXPECT_EQ(b.base64, a.base64);
+    EXPECT_EQ(b.frame, first);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(SnapshotCacheJpegTest, ReplacesSnapshotWhenSceneChanges) {
+    SnapshotCache cache(&history_);
+    Snapshot a = cache.get(frame(scene_jpeg(), 1, 1.0));
+    FramePtr changed = frame(scene_jpeg(30, 20), 2, 2.0);
+    Snapshot b = cache.get(changed);
+    EXPECT_FALSE(b.cached);
+    EXPECT_NE(b.base64, a.base64);
+
+    // The changed scene is now the cached one.
+    Snapshot c = cache.get(frame(scene_jpeg(30, 20), 3, 3.0));
+    EXPECT_TRUE(c.cached);
+    EXPECT_EQ(c.frame, changed);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(SnapshotCacheJpegTest, KeepsOneSnapshotPerPoseBucket) {
+    SnapshotCache cache(&history_);
+    auto jpeg = scene_jpeg();
+    FramePtr home = frame(jpeg, 1, 1.0);
+    cache.get(home);
+
+    pose(5.0, 1.0, 0.0);  // panned away: same pixels, other bucket
+    EXPECT_FALSE(cache.get(frame(jpeg, 2, 6.0)).cached);
+    EXPECT_EQ(cache.size(), 2u);
+
+    pose(10.0, 0.02, 0.0);  // back, within the home bucket
+    Snapshot s = cache.get(frame(jpeg, 3, 11.0));
+    EXPECT_TRUE(s.cached);
+    EXPECT_EQ(s.frame, home);
+}
+
+TEST_F(SnapshotCacheJpegTest, CachesOnlySettledFrames) {
+    SnapshotCache cache(&history_);
+    auto jpeg = scene_jpeg();
+    EXPECT_FALSE(cache.get(frame(jpeg, 1, 1.0, MotionState::Moving)).cached);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(frame(jpeg, 2, 2.0)).cached);
+    EXPECT_TRUE(cache.get(frame(jpeg, 3, 3.0, MotionState::Moving)).cached);
+}
+
+TEST_F(SnapshotCacheJpegTest, ExpiresOldSnapshots) {
+    SnapshotCacheConfig config;
+    config.max_age = 5.0;
+    SnapshotCache cache(&history_, config);
+    auto jpeg = scene_jpeg();
+    cache.get(frame(jpeg, 1, 1.0));
+    EXPECT_TRUE(cache.get(frame(jpeg, 2, 6.0)).cached);
+    FramePtr late = frame(jpeg, 3, 6.5);
+    Snapshot s = cache.get(late);
+    EXPECT_FALSE(s.cached);
+    EXPECT_EQ(s.frame, late);
+}
+
+TEST_F(SnapshotCacheJpegTest, EvictsLeastRecentlyUsedBucket) {
+    SnapshotCacheConfig config;
+    config.capacity = 2;
+    SnapshotCache cache(&history_, config);
+    auto jpeg = scene_jpeg();
+    cache.get(frame(jpeg, 1, 1.0));   // bucket 0
+    pose(2.0, 1.0, 0.0);
+    cache.get(frame(jpeg, 2, 2.5));   // bucket 10
+    pose(3.0, 0.0, 0.0);
+    EXPECT_TRUE(cache.get(frame(jpeg, 3, 3.5)).cached);  // touch bucket 0
+    pose(4.0, 2.0, 0.0);
+    cache.get(frame(jpeg, 4, 4.5));   // bucket 20 evicts bucket 10
+    EXPECT_EQ(cache.size(), 2u);
+
+    pose(5.0, 1.0, 0.0);
+    EXPECT_FALSE(cache.get(frame(jpeg, 5, 5.5)).cached);
+    pose(6.0, 0.0, 0.0);
+    EXPECT_FALSE(cache.get(frame(jpeg, 6, 6.5)).cached);  // evicted by bucket 10
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(SnapshotCacheJpegTest, WorksWithoutPoseHistory) {
+    SnapshotCache cache;
+    auto jpeg = scene_jpeg();
+    cache.get(frame(jpeg, 1, 1.0));
+    EXPECT_TRUE(cache.get(frame(jpeg, 2, 2.0)).cached);
+}
+
+#endif
+
+TEST(SnapshotCacheTest, NeverReusesUndecodableFrames) {
+    SnapshotCache cache;
+    auto bogus = [](uint64_t seq) {
+        return std::make_shared<const Frame>(std::vector<uint8_t>{1, 2, 3}, 8, 8, seq, 1.0);
+    };
+    Snapshot a = cache.get(bogus(1));
+    EXPECT_EQ(a.base64, "AQID");
+    EXPECT_FALSE(cache.get(bogus(2)).cached);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(nullptr).frame);
+}
+
+} // namespace
+} // namespace bcc950
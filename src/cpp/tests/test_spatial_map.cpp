@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+#include "bcc950/spatial_map.hpp"
+
+namespace bcc950 {
+namespace {
+
+/// Fixture providing a unique temporary path for file-backed maps.
+class SpatialMapFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "bcc950_spatial_" +
+                std::to_string(::getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::remove(path_.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+};
+
+TEST(SpatialMapTest, GridCoversCalibratedRange) {
+    SpatialGridSpec spec;
+    EXPECT_EQ(spec.pan_cells(), 20);   // 10 movement-seconds / 0.5
+    EXPECT_EQ(spec.tilt_cells(), 12);  // 6 / 0.5
+}
+
+TEST(SpatialMapTest, QueryReturnsEntriesWithinRadiusNewestFirst) {
+    SpatialMap map;
+    map.insert(0.1, 0.1, 1, 100.0);
+    map.insert(0.3, -0.2, 2, 200.0);
+    map.insert(2.0, 2.0, 3, 300.0);
+
+    auto near = map.query(0.0, 0.0, 0.5);
+    ASSERT_EQ(near.size(), 2u);
+    EXPECT_EQ(near[0].id, 2u);
+    EXPECT_EQ(near[1].id, 1u);
+    EXPECT_FLOAT_EQ(near[1].pan, 0.1f);
+
+    EXPECT_EQ(map.query(2.0, 2.0, 0.1).size(), 1u);
+    EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(SpatialMapTest, QueryFiltersByAge) {
+    SpatialMap map;
+    map.insert(0.0, 0.0, 1, 10.0);
+    map.insert(0.0, 0.0, 2, 20.0);
+
+    auto recent = map.query(0.0, 0.0, 1.0, /*since=*/15.0);
+    ASSERT_EQ(recent.size(), 1u);
+    EXPECT_EQ(recent[0].id, 2u);
+}
+
+TEST(SpatialMapTest, CellKeepsNewestEntries) {
+    SpatialGridSpec spec;
+    spec.cell_capacity = 3;
+    SpatialMap map(spec);
+    for (uint64_t i = 0; i < 5; ++i) {
+        map.insert(0.1, 0.1, i, static_cast<double>(i));
+    }
+
+    auto entries = map.query(0.1, 0.1, 0.01);
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].id, 4u);
+    EXPECT_EQ(entries[2].id, 2u);
+    EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(SpatialMapTest, LatestPerCellTakesOnePerCell) {
+    SpatialMap map;
+    map.insert(0.1, 0.1, 1, 1.0);
+    map.insert(0.2, 0.2, 2, 2.0);   // same cell, newer
+    map.insert(0.8, 0.1, 3, 3.0);   // neighbouring cell
+
+    auto latest = map.latest_per_cell(0.3, 0.3, 1.0);
+    ASSERT_EQ(latest.size(), 2u);
+    EXPECT_EQ(latest[0].id, 3u);
+    EXPECT_EQ(latest[1].id, 2u);
+}
+
+TEST(SpatialMapTest, OutOfRangePositionsClampToEdgeCells) {
+    SpatialMap map;
+    map.insert(EST_PAN_MAX + 4.0, 0.0, 7, 1.0);
+    EXPECT_EQ(map.size(), 1u);
+    // Stored at its exact position, found only by a query that reaches it.
+    EXPECT_EQ(map.query(EST_PAN_MAX + 4.0, 0.0, 0.1).size(), 1u);
+    EXPECT_TRUE(map.query(EST_PAN_MAX, 0.0, 0.1).empty());
+}
+
+TEST(SpatialMapTest, ClearEmptiesEveryCell) {
+    SpatialMap map;
+    map.insert(0.0, 0.0, 1, 1.0);
+    map.clear();
+    EXPECT_EQ(map.size(), 0u);
+    EXPECT_TRUE(map.query(0.0, 0.0, 10.0).empty());
+}
+
+TEST_F(SpatialMapFileTest, PersistsAcrossReopen) {
+    {
+        SpatialMap map(path_);
+        map.insert(1.0, -1.0, 42, 123.0);
+        map.sync();
+    }
+    SpatialMap reopened(path_);
+    ASSERT_EQ(reopened.size(), 1u);
+    auto entries = reopened.query(1.0, -1.0, 0.1);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].id, 42u);
+    EXPECT_DOUBLE_EQ(entries[0].timestamp, 123.0);
+}
+
+TEST_F(SpatialMapFileTest, RejectsDifferentGrid) {
+    { SpatialMap map(path_); }
+    SpatialGridSpec other;
+    other.cell_size = 0.25;
+    EXPECT_THROW(SpatialMap(path_, other), std::runtime_error);
+}
+
+TEST_F(SpatialMapFileTest, RejectsCorruptCellRing) {
+    { SpatialMap map(path_); }
+    // The first cell's count sits right after the 64-byte header and its head.
+    std::FILE* f = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    uint32_t count = 1u << 30;
+    std::fseek(f, 64 + sizeof(uint32_t), SEEK_SET);
+    std::fwrite(&count, sizeof(count), 1, f);
+    std::fclose(f);
+    EXPECT_THROW(SpatialMap{path_}, std::runtime_error);
+}
+
+} // anonymous namespace
+} // namespace bcc950
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "bcc950/pose_history.hpp"
+#include "bcc950/target_selector.hpp"
+
+namespace bcc950 {
+namespace {
+
+constexpr int PERSON = 0;
+constexpr int CHAIR  = 56;
+
+Detection box(float x1, float x2, float y1 = 0.4f, float y2 = 0.6f,
+              int class_id = PERSON) {
+    Detection d;
+    d.x1 = x1;
+    d.x2 = x2;
+    d.y1 = y1;
+    d.y2 = y2;
+    d.confidence = 0.9f;
+    d.class_id = class_id;
+    return d;
+}
+
+void record_pose(PoseHistory& history, double t, double pan, double tilt = 0.0) {
+    PoseSample s;
+    s.timestamp = t;
+    s.pan = pan;
+    s.tilt = tilt;
+    s.zoom = ZOOM_MIN;
+    history.record(s);
+}
+
+/// Image x of a point `pan` movement-seconds right of the optical axis.
+float image_x(const ZoomModel& optics, double pan) {
+    double half = std::tan(optics.hfov_wide * M_PI / 360.0);
+    double angle = pan * optics.pan_rate * M_PI / 180.0;
+    return static_cast<float>(0.5 + std::tan(angle) / (2.0 * half));
+}
+
+TEST(TargetSelectorTest, FailsWithoutPose) {
+    PoseHistory history;
+    TargetSelector selector(history);
+    EXPECT_FALSE(selector.update({box(0.4f, 0.6f)}, 1.0));
+    EXPECT_TRUE(selector.tracks().empty());
+}
+
+TEST(TargetSelectorTest, ProjectsBoxesThroughThePose) {
+    PoseHistory history;
+    record_pose(history, 0.0, 1.5, -0.5);
+    TargetSelector selector(history);
+    ZoomModel optics;
+
+    ASSERT_TRUE(selector.update({box(0.45f, 0.55f), box(0.70f, 0.80f, 0.1f, 0.3f)}, 1.0));
+    auto tracks = selector.tracks();
+    ASSERT_EQ(tracks.size(), 2u);
+    EXPECT_NEAR(tracks[0].bearing.pan, 1.5, 1e-6);
+    EXPECT_NEAR(tracks[0].bearing.tilt, -0.5, 1e-6);
+
+    // Right of and above center.
+    double right = optics.bearing_offset(Axis::Pan, 0.25, ZOOM_MIN);
+    EXPECT_NEAR(tracks[1].bearing.pan, 1.5 + right, 0.02);
+    EXPECT_GT(tracks[1].bearing.tilt, -0.5);
+    EXPECT_GT(tracks[1].width, 0.0);
+}
+
+TEST(TargetSelectorTest, TrackSurvivesCameraPan) {
+    PoseHistory history;
+    ZoomModel optics;
+    record_pose(history, 0.0, 0.0);
+    record_pose(history, 1.0, 1.0);  // camera panned right one movement-second
+    TargetSelector selector(history);
+
+    ASSERT_TRUE(selector.update({box(0.45f, 0.55f)}, 0.0));
+    uint64_t id = selector.tracks().at(0).id;
+
+    // The object did not move, so it now appears left of center; the
+    // image boxes do not even overlap.
+    float left = image_x(optics, -0.05 - 1.0);
+    float right = image_x(optics, 0.05 - 1.0);
+    ASSERT_LT(right, 0.45f);
+    ASSERT_TRUE(selector.update({box(left, right)}, 1.0));
+
+    auto tracks = selector.tracks();
+    ASSERT_EQ(tracks.size(), 1u);
+    EXPECT_EQ(tracks[0].id, id);
+    EXPECT_EQ(tracks[0].hits, 2u);
+    EXPECT_NEAR(tracks[0].bearing.pan, 0.0, 0.05);
+    EXPECT_NEAR(tracks[0].pan_velocity, 0.0, 0.05);
+}
+
+TEST(TargetSelectorTest, AssignmentIsGloballyOptimal) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelector selector(history);
+
+    ASSERT_TRUE(selector.update({box(0.40f, 0.50f), box(0.46f, 0.56f)}, 1.0));
+    auto first = selector.tracks();
+    ASSERT_EQ(first.size(), 2u);
+
+    // Greedy matching would give track A the detection it overlaps most
+    // ([0.42, 0.52]), stranding the other. The optimal assignment moves
+    // A left and B onto the middle box.
+    ASSERT_TRUE(selector.update({box(0.42f, 0.52f), box(0.36f, 0.46f)}, 1.1));
+    auto tracks = selector.tracks();
+    ASSERT_EQ(tracks.size(), 2u);
+    EXPECT_EQ(tracks[0].id, first[0].id);
+    EXPECT_FLOAT_EQ(tracks[0].box.x1, 0.36f);
+    EXPECT_EQ(tracks[1].id, first[1].id);
+    EXPECT_FLOAT_EQ(tracks[1].box.x1, 0.42f);
+}
+
+TEST(TargetSelectorTest, ClassesNeverAssociate) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelector selector(history);
+
+    ASSERT_TRUE(selector.update({box(0.4f, 0.6f, 0.4f, 0.6f, CHAIR)}, 1.0));
+    ASSERT_TRUE(selector.update({box(0.4f, 0.6f, 0.4f, 0.6f, PERSON)}, 1.1));
+    auto tracks = selector.tracks();
+    ASSERT_EQ(tracks.size(), 2u);
+    EXPECT_NE(tracks[0].class_id, tracks[1].class_id);
+}
+
+TEST(TargetSelectorTest, UnseenTracksExpire) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelectorConfig config;
+    config.max_age = 0.5;
+    TargetSelector selector(history, config);
+
+    ASSERT_TRUE(selector.update({box(0.4f, 0.6f)}, 1.0));
+    ASSERT_TRUE(selector.update({}, 1.4));
+    EXPECT_EQ(selector.tracks().size(), 1u);
+    EXPECT_TRUE(selector.target().has_value());
+
+    ASSERT_TRUE(selector.update({}, 1.6));
+    EXPECT_TRUE(selector.tracks().empty());
+    EXPECT_FALSE(selector.target().has_value());
+}
+
+TEST(TargetSelectorTest, TargetIsLargestPersonAndSticks) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelector selector(history);
+
+    ASSERT_TRUE(selector.update({box(0.10f, 0.20f),
+                                 box(0.60f, 0.90f, 0.2f, 0.9f),
+                                 box(0.30f, 0.50f, 0.0f, 1.0f, CHAIR)}, 1.0));
+    auto target = selector.target();
+    ASSERT_TRUE(target.has_value());
+    EXPECT_FLOAT_EQ(target->box.x1, 0.60f);
+    uint64_t id = target->id;
+
+    // The other person grows larger; the camera keeps its subject.
+    ASSERT_TRUE(selector.update({box(0.08f, 0.30f, 0.1f, 0.95f),
+                                 box(0.62f, 0.88f, 0.2f, 0.9f)}, 1.1));
+    ASSERT_TRUE(selector.target().has_value());
+    EXPECT_EQ(selector.target()->id, id);
+}
+
+TEST(TargetSelectorTest, MinHitsDelaysTarget) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelectorConfig config;
+    config.min_hits = 2;
+    TargetSelector selector(history, config);
+
+    ASSERT_TRUE(selector.update({box(0.4f, 0.6f)}, 1.0));
+    EXPECT_FALSE(selector.target().has_value());
+    ASSERT_TRUE(selector.update({box(0.41f, 0.61f)}, 1.1));
+    EXPECT_TRUE(selector.target().has_value());
+}
+
+TEST(TargetSelectorTest, TargetBearingLeadsAMovingSubject) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelector selector(history);
+    ZoomModel optics;
+
+    // Subject walks right at 0.2 movement-seconds per second.
+    for (int i = 0; i <= 4; ++i) {
+        double t = 1.0 + 0.25 * i;
+        double pan = 0.2 * (t - 1.0);
+        ASSERT_TRUE(selector.update({box(image_x(optics, pan - 0.1),
+                                         image_x(optics, pan + 0.1))}, t));
+    }
+    auto target = selector.target();
+    ASSERT_TRUE(target.has_value());
+    EXPECT_NEAR(target->pan_velocity, 0.2, 0.02);
+
+    auto now = selector.target_bearing(2.5);
+    ASSERT_TRUE(now.has_value());
+    EXPECT_NEAR(now->pan, 0.3, 0.02);
+
+    // Extrapolation is capped at max_age.
+    auto far = selector.target_bearing(100.0);
+    EXPECT_NEAR(far->pan, 0.2 + 0.2 * selector.config().max_age, 0.03);
+}
+
+TEST(TargetSelectorTest, ClearForgetsEverything) {
+    PoseHistory history;
+    record_pose(history, 0.0, 0.0);
+    TargetSelector selector(history);
+    ASSERT_TRUE(selector.update({box(0.4f, 0.6f)}, 1.0));
+    selector.clear();
+    EXPECT_TRUE(selector.tracks().empty());
+    EXPECT_FALSE(selector.target_bearing(1.0).has_value());
+}
+
+} // namespace
+} // namespace bcc950
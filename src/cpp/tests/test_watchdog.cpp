@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "bcc950/watchdog.hpp"
+
+namespace bcc950 {
+namespace {
+
+using std::chrono::milliseconds;
+
+/// Spin until `counter` reaches `target` or a second passes.
+bool wait_for_count(const std::atomic<int>& counter, int target) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (counter.load() >= target) return true;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return counter.load() >= target;
+}
+
+TEST(WatchdogTest, ExpiredDeadlineFires) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    wd.arm(0.02);
+
+    ASSERT_TRUE(wait_for_count(fired, 1));
+    EXPECT_EQ(wd.expirations(), 1u);
+}
+
+TEST(WatchdogTest, DisarmedDeadlineDoesNotFire) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    uint64_t id = wd.arm(0.05);
+    wd.disarm(id);
+
+    std::this_thread::sleep_for(milliseconds(100));
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(WatchdogTest, DisarmUnknownIdIsIgnored) {
+    Watchdog wd([] {});
+    wd.disarm(12345);
+    EXPECT_EQ(wd.expirations(), 0u);
+}
+
+TEST(WatchdogTest, EarliestOfSeveralDeadlinesFires) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    wd.arm(10.0);
+    wd.arm(0.02);
+
+    ASSERT_TRUE(wait_for_count(fired, 1));
+}
+
+TEST(WatchdogTest, MissedHeartbeatFiresWhileArmed) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    wd.set_heartbeat_timeout(0.02);
+    wd.arm(10.0);
+
+    ASSERT_TRUE(wait_for_count(fired, 1));
+}
+
+TEST(WatchdogTest, HeartbeatKeepsArmedMoveAlive) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    wd.set_heartbeat_timeout(0.05);
+    uint64_t id = wd.arm(10.0);
+    for (int i = 0; i < 10; ++i) {
+        std::this_thread::sleep_for(milliseconds(10));
+        wd.heartbeat();
+    }
+    wd.disarm(id);
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(WatchdogTest, HeartbeatIgnoredWhenNothingArmed) {
+    std::atomic<int> fired{0};
+    Watchdog wd([&] { ++fired; }, /*grace=*/0.0);
+    wd.set_heartbeat_timeout(0.01);
+
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(EmergencyStopTest, RegisteredNonV4L2DescriptorIsHarmless) {
+    int fd = ::open("/dev/null", O_RDWR);
+    ASSERT_GE(fd, 0);
+    EXPECT_TRUE(register_emergency_stop_fd(fd));
+    emergency_stop_all();  // ioctl fails with ENOTTY; must not crash
+    unregister_emergency_stop_fd(fd);
+    ::close(fd);
+}
+
+std::atomic<int> g_chained_signo{0};
+
+void record_siginfo(int, siginfo_t* info, void* context) {
+    g_chained_signo = (info != nullptr && context != nullptr) ? info->si_signo : -1;
+}
+
+TEST(EmergencyStopTest, ChainsSiginfoThroughToThePreviousHandler) {
+    struct sigaction prev{};
+    prev.sa_sigaction = record_siginfo;
+    sigemptyset(&prev.sa_mask);
+    prev.sa_flags = SA_SIGINFO;
+    struct sigaction saved{};
+    ASSERT_EQ(::sigaction(SIGTERM, &prev, &saved), 0);
+
+    install_safety_handlers();
+    ::raise(SIGTERM);
+    EXPECT_EQ(g_chained_signo.load(), SIGTERM);
+
+    ::sigaction(SIGTERM, &saved, nullptr);
+}
+
+} // anonymous namespace
+} // namespace bcc950
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "bcc950/constants.hpp"
+#include "bcc950/zoom_model.hpp"
+
+namespace bcc950 {
+namespace {
+
+TEST(ZoomModelTest, SlewTimeZeroWhenAlreadyThere) {
+    ZoomModel model;
+    EXPECT_DOUBLE_EQ(model.slew_time(300, 300), 0.0);
+}
+
+TEST(ZoomModelTest, SlewTimeIsLatencyPlusTravel) {
+    ZoomModel model;
+    model.slew_rate    = 400.0;
+    model.slew_latency = 0.05;
+    EXPECT_DOUBLE_EQ(model.slew_time(100, 500), 0.05 + 1.0);
+    EXPECT_DOUBLE_EQ(model.slew_time(500, 300), 0.05 + 0.5);
+}
+
+TEST(ZoomModelTest, ZoomAtFollowsTheSlew) {
+    ZoomModel model;
+    model.slew_rate    = 400.0;
+    model.slew_latency = 0.05;
+    EXPECT_DOUBLE_EQ(model.zoom_at(100, 500, 0.0), 100.0);
+    EXPECT_DOUBLE_EQ(model.zoom_at(100, 500, 0.55), 300.0);
+    EXPECT_DOUBLE_EQ(model.zoom_at(500, 100, 0.55), 300.0);
+    EXPECT_DOUBLE_EQ(model.zoom_at(100, 500, 5.0), 500.0);
+}
+
+TEST(ZoomModelTest, FieldOfViewNarrowsWithZoom) {
+    ZoomModel model;
+    EXPECT_NEAR(model.fov(Axis::Pan, ZOOM_MIN), model.hfov_wide, 1e-9);
+    EXPECT_NEAR(model.fov(Axis::Tilt, ZOOM_MIN), model.vfov_wide, 1e-9);
+
+    // 2x zoom halves the tangent of the half-angle.
+    double half = std::atan(std::tan(model.hfov_wide * M_PI / 360.0) / 2.0);
+    EXPECT_NEAR(model.fov(Axis::Pan, 2 * ZOOM_MIN), half * 360.0 / M_PI, 1e-9);
+}
+
+TEST(ZoomModelTest, MovementSecondsShrinkAtHigherZoom) {
+    ZoomModel model;
+    double wide = model.movement_seconds(Axis::Pan, 0.5, ZOOM_MIN);
+    double tele = model.movement_seconds(Axis::Pan, 0.5, ZOOM_MAX);
+    EXPECT_NEAR(wide, 0.5 * model.hfov_wide / model.pan_rate, 1e-9);
+    EXPECT_LT(tele, wide);
+    EXPECT_NEAR(model.movement_seconds(Axis::Tilt, 1.0, ZOOM_MIN) *
+                    model.fov_rate(Axis::Tilt, ZOOM_MIN),
+                1.0, 1e-9);
+}
+
+TEST(ZoomModelTest, BearingOffsetReachesTheFrameEdge) {
+    ZoomModel model;
+    EXPECT_DOUBLE_EQ(model.bearing_offset(Axis::Pan, 0.0, ZOOM_MIN), 0.0);
+    // The frame edge is half the field of view off axis.
+    EXPECT_NEAR(model.bearing_offset(Axis::Pan, 0.5, ZOOM_MIN),
+                model.hfov_wide / 2.0 / model.pan_rate, 1e-9);
+    EXPECT_NEAR(model.bearing_offset(Axis::Tilt, -0.5, ZOOM_MAX),
+                -model.fov(Axis::Tilt, ZOOM_MAX) / 2.0 / model.tilt_rate, 1e-9);
+    // Rectilinear: a quarter frame-width off axis is more than a quarter
+    // of the field of view.
+    EXPECT_GT(model.bearing_offset(Axis::Pan, 0.25, ZOOM_MIN),
+              model.hfov_wide / 4.0 / model.pan_rate);
+}
+
+} // anonymous namespace
+} // namespace bcc950